@@ -29,18 +29,18 @@ classdef TFModel < handle
   ## @end group
   ## @end example
   ##
-  ## The operations feeding and reading the model are found by inspecting the
-  ## Graph, following the names @code{tf.saved_model.save} gives them: the
-  ## inputs are the placeholders named @qcode{'serving_default_@var{name}'} and
-  ## the output is the operation named @qcode{'StatefulPartitionedCall'}.  Both
-  ## are reported by the @qcode{'InputNames'} and @qcode{'OutputNames'}
-  ## properties and can be given explicitly to the constructor when a model
-  ## does not follow those names.
+  ## The operations feeding and reading the model are read from one of the
+  ## signatures of the SavedModel, @qcode{'serving_default'} unless another
+  ## is chosen with the @qcode{'Signature'} option: the inputs in the order of
+  ## their keys, and likewise the outputs.  Both are reported by the
+  ## @qcode{'InputNames'} and @qcode{'OutputNames'} properties and can be given
+  ## explicitly to the constructor.  Every signature is listed, with the type
+  ## and shape of its tensors, by @code{@var{model}.Session.Signatures}.
   ##
-  ## Signature names are not read from the SavedModel itself, which would mean
-  ## decoding the MetaGraphDef, so a model exported some other way may need its
-  ## operation names supplied.  Inspect them with
-  ## @code{@var{model}.Session.Graph.operationNames ()}.
+  ## A SavedModel with no such signature is inspected instead, following the
+  ## names @code{tf.saved_model.save} gives the operations: the inputs are the
+  ## placeholders named @qcode{'serving_default_@var{name}'} and the output is
+  ## the operation named @qcode{'StatefulPartitionedCall'}.
   ##
   ## @end deftp
 
@@ -58,6 +58,13 @@ classdef TFModel < handle
     ## @end deftp
     Tags = {};
 
+    ## -*- texinfo -*-
+    ## @deftp {TFModel} {property} Signature
+    ## The name of the signature the inputs and outputs were read from, empty
+    ## when they were given or found by inspecting the Graph.
+    ## @end deftp
+    Signature = "";
+
     ## -*- texinfo -*-
     ## @deftp {TFModel} {property} InputNames
     ## The operations the inputs are fed to, as a cellstr row vector.
@@ -70,6 +77,26 @@ classdef TFModel < handle
     ## @end deftp
     OutputNames = {};
 
+    ## -*- texinfo -*-
+    ## @deftp {TFModel} {property} Layout
+    ## How inputs and outputs are laid out, either @qcode{'rowmajor'} or
+    ## @qcode{'native'}.  See @code{TF_Tensor}.
+    ## @end deftp
+    Layout = "rowmajor";
+
+    ## -*- texinfo -*-
+    ## @deftp {TFModel} {property} MaxBatchSize
+    ## The most rows a batch of requests gathers.  See @code{submit}.
+    ## @end deftp
+    MaxBatchSize = 32;
+
+    ## -*- texinfo -*-
+    ## @deftp {TFModel} {property} MaxBatchWait
+    ## The longest time, in seconds, a request waits for others to join its
+    ## batch.  See @code{submit}.
+    ## @end deftp
+    MaxBatchWait = 0.005;
+
     ## -*- texinfo -*-
     ## @deftp {TFModel} {property} Session
     ## The @code{TF_Session} the model runs in.
@@ -78,6 +105,18 @@ classdef TFModel < handle
 
   endproperties
 
+  properties (Access = private)
+
+    ## The TF_Runner every prediction goes through, prepared with the
+    ## InputNames and OutputNames when the model is loaded
+    Runner = [];
+
+    ## The uint64 pointer to the queue submitted requests are batched in, 0
+    ## until the first request
+    Batcher = uint64 (0);
+
+  endproperties
+
   methods (Access = public)
 
     ## -*- texinfo -*-
@@ -95,13 +134,38 @@ classdef TFModel < handle
     ## load, a character vector or a cellstr vector.  The default is
     ## @qcode{@{'serve'@}}.
     ##
+    ## @item @qcode{'Signature'} @tab @tab The name of the signature of the
+    ## SavedModel the inputs and outputs are read from.  The default is
+    ## @qcode{'serving_default'}, or the only signature of a SavedModel with a
+    ## single one.
+    ##
     ## @item @qcode{'InputNames'} @tab @tab The operations to feed, a character
-    ## vector or a cellstr vector.  The default is every placeholder named
+    ## vector or a cellstr vector.  The default is every input of the
+    ## signature, sorted by key, or failing a signature every placeholder named
     ## @qcode{'serving_default_@var{name}'}, sorted by name.
     ##
     ## @item @qcode{'OutputNames'} @tab @tab The operations to read, a character
-    ## vector or a cellstr vector.  The default is every output of the operation
-    ## named @qcode{'StatefulPartitionedCall'}.
+    ## vector or a cellstr vector.  The default is every output of the
+    ## signature, sorted by key, or failing a signature every output of the
+    ## operation named @qcode{'StatefulPartitionedCall'}.
+    ##
+    ## @item @qcode{'Layout'} @tab @tab Either @qcode{'rowmajor'}, the default,
+    ## which gives inputs and outputs the shape of the Octave arrays, or
+    ## @qcode{'native'}, which reverses their dimensions and copies the data
+    ## with no repositioning, for a model exported to take the transposed
+    ## input.
+    ##
+    ## @item @qcode{'Config'} @tab @tab The @code{ConfigProto} the Session is
+    ## created with, as a struct named after its fields, such as
+    ## @qcode{intra_op_parallelism_threads}, or serialized as a @code{uint8}
+    ## vector.  See @code{TF_Session.fromSavedModel} for the fields.
+    ##
+    ## @item @qcode{'MaxBatchSize'} @tab @tab The most rows a batch of
+    ## submitted requests gathers, a positive integer.  The default is 32.
+    ##
+    ## @item @qcode{'MaxBatchWait'} @tab @tab The longest time, in seconds, a
+    ## submitted request waits for others to join its batch.  The default is
+    ## 0.005.
     ## @end multitable
     ##
     ## @end deftypefn
@@ -114,8 +178,13 @@ classdef TFModel < handle
         error ("TFModel: optional arguments must be given in Name/Value pairs.");
       endif
       tags = {"serve"};
+      signame = "";
       innames = {};
       outnames = {};
+      layout = "rowmajor";
+      maxbatch = 32;
+      maxwait = 0.005;
+      config = [];
       for i = 1:2:numel (varargin)
         name = varargin{i};
         if (! (ischar (name) && isrow (name)))
@@ -124,29 +193,68 @@ classdef TFModel < handle
         switch (lower (name))
           case 'tags'
             tags = varargin{i+1};
+          case 'signature'
+            signame = varargin{i+1};
+            if (! (ischar (signame) && isrow (signame)))
+              error ("TFModel: 'Signature' must be a character vector.");
+            endif
           case 'inputnames'
             innames = varargin{i+1};
           case 'outputnames'
             outnames = varargin{i+1};
+          case 'layout'
+            layout = TF_Tensor.checkLayout (varargin{i+1}, "TFModel");
+          case 'config'
+            config = varargin{i+1};
+          case 'maxbatchsize'
+            maxbatch = varargin{i+1};
+            if (! (isnumeric (maxbatch) && isreal (maxbatch) ...
+                   && isscalar (maxbatch)) || maxbatch < 1 ...
+                   || fix (maxbatch) != maxbatch)
+              error ("TFModel: 'MaxBatchSize' must be a positive integer.");
+            endif
+          case 'maxbatchwait'
+            maxwait = varargin{i+1};
+            if (! (isnumeric (maxwait) && isreal (maxwait) ...
+                   && isscalar (maxwait)) || ! (maxwait >= 0) ...
+                   || ! isfinite (maxwait))
+              error ("TFModel: 'MaxBatchWait' must be a non-negative scalar.");
+            endif
           otherwise
             error ("TFModel: unrecognized parameter name '%s'.", name);
         endswitch
       endfor
-      this.Session = TF_Session.fromSavedModel (dirname, tags);
+      this.Session = TF_Session.fromSavedModel (dirname, tags, config);
       this.Directory = dirname;
+      this.Layout = layout;
+      this.MaxBatchSize = double (maxbatch);
+      this.MaxBatchWait = double (maxwait);
       if (ischar (tags) && isrow (tags))
         tags = {tags};
       endif
       this.Tags = tags(:).';
-      if (isempty (innames))
+      sig = TFModel.findSignature (this.Session.Signatures, signame);
+      if (! isempty (sig) && (isempty (innames) || isempty (outnames)))
+        this.Signature = sig.Name;
+      endif
+      if (! isempty (innames))
+        if (ischar (innames) && isrow (innames))
+          innames = {innames};
+        endif
+      elseif (! isempty (sig))
+        ## A tensor is fed through its operation, whose first output it is
+        innames = regexprep ({sig.Inputs.Name}, ':0$', '');
+      else
         innames = TFModel.discoverInputs (this.Session.Graph);
-      elseif (ischar (innames) && isrow (innames))
-        innames = {innames};
       endif
-      if (isempty (outnames))
+      if (! isempty (outnames))
+        if (ischar (outnames) && isrow (outnames))
+          outnames = {outnames};
+        endif
+      elseif (! isempty (sig))
+        outnames = {sig.Outputs.Name};
+      else
         outnames = TFModel.discoverOutputs (this.Session.Graph);
-      elseif (ischar (outnames) && isrow (outnames))
-        outnames = {outnames};
       endif
       if (! iscellstr (innames) || isempty (innames))
         error (["TFModel: no input operation was found; give them with the", ...
@@ -158,6 +266,8 @@ classdef TFModel < handle
       endif
       this.InputNames = innames(:).';
       this.OutputNames = outnames(:).';
+      this.Runner = this.Session.prepare (this.InputNames, this.OutputNames, ...
+                                          "Layout", layout);
 
     endfunction
 
@@ -169,7 +279,11 @@ classdef TFModel < handle
     ##
     ## As many inputs must be given as the model has @qcode{'InputNames'}, in
     ## that order.  @var{y} is an Octave array when the model has a single
-    ## output, and a cell array of them otherwise.
+    ## output, and a cell array of them otherwise.  Inputs and outputs follow
+    ## the @qcode{'Layout'} the model was loaded with, and inputs given as
+    ## @code{double} or @code{single} arrays are converted to the
+    ## @qcode{'TF_FLOAT'} or @qcode{'TF_DOUBLE'} type the model takes as they
+    ## are copied.
     ##
     ## @end deftypefn
     function y = predict (this, varargin)
@@ -182,7 +296,92 @@ classdef TFModel < handle
         error ("TFModel.predict: %d input(s) expected, %d given.", ...
                numel (this.InputNames), numel (varargin));
       endif
-      y = this.Session.run (this.InputNames, varargin, this.OutputNames);
+      y = this.Runner.run (varargin);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModel} {@var{ticket} =} submit (@var{obj}, @var{x})
+    ## @deftypefnx {TFModel} {@var{ticket} =} submit (@var{obj}, @var{x1}, @dots{}, @var{xN})
+    ##
+    ## Queue a request to run the model on @var{x}, to be batched with other
+    ## requests, and return the @var{ticket} its output is collected with.
+    ##
+    ## Requests are gathered in a native queue and run together in a single
+    ## call to TensorFlow, their inputs concatenated along the first
+    ## dimension, or along the last one in @qcode{'native'} layout.  A batch is
+    ## run on a worker thread once it holds @qcode{'MaxBatchSize'} rows or its
+    ## oldest request has waited @qcode{'MaxBatchWait'} seconds, and only
+    ## gathers requests whose inputs agree in type and in every other
+    ## dimension.  Each input of a request must have as many rows.  The model
+    ## must return outputs with a first dimension as long as the batch, which
+    ## is split back between the requests.
+    ##
+    ## @end deftypefn
+    function ticket = submit (this, varargin)
+
+      if (nargin < 2)
+        print_usage ();
+      endif
+      this.assertValid ("TFModel.submit");
+      if (numel (varargin) != numel (this.InputNames))
+        error ("TFModel.submit: %d input(s) expected, %d given.", ...
+               numel (this.InputNames), numel (varargin));
+      endif
+      if (this.Batcher == 0)
+        this.Batcher = this.newBatcher ();
+      endif
+      ticket = tensorflow ("TF_BatcherSubmit", this.Batcher, varargin);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModel} {@var{y} =} collect (@var{obj}, @var{ticket})
+    ##
+    ## Return the output of the request identified by @var{ticket}, as
+    ## @code{predict} would have.
+    ##
+    ## A request whose batch has not been run yet is run straight away, along
+    ## with every request queued before it, since nothing can be submitted
+    ## while Octave waits.  Each ticket is collected once.
+    ##
+    ## @end deftypefn
+    function y = collect (this, ticket)
+
+      if (nargin != 2)
+        print_usage ();
+      endif
+      this.assertValid ("TFModel.collect");
+      if (this.Batcher == 0)
+        error ("TFModel.collect: no request has been submitted.");
+      endif
+      y = tensorflow ("TF_BatcherCollect", this.Batcher, uint64 (ticket));
+      if (numel (y) == 1)
+        y = y{1};
+      endif
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModel} {@var{s} =} batchStats (@var{obj})
+    ##
+    ## Return how the submitted requests were batched, as a structure with the
+    ## fields @qcode{requests}, @qcode{batches}, @qcode{largest} and
+    ## @qcode{pending}: the number of requests submitted, of batches run, of
+    ## rows in the largest batch and of requests still queued.
+    ##
+    ## @end deftypefn
+    function s = batchStats (this)
+
+      if (nargin != 1)
+        print_usage ();
+      endif
+      this.assertValid ("TFModel.batchStats");
+      if (this.Batcher == 0)
+        s = struct ("requests", 0, "batches", 0, "largest", 0, "pending", 0);
+      else
+        s = tensorflow ("TF_BatcherStats", this.Batcher);
+      endif
 
     endfunction
 
@@ -194,6 +393,11 @@ classdef TFModel < handle
     ## @end deftypefn
     function delete (this)
 
+      if (this.Batcher != 0)
+        tensorflow ("TF_DeleteBatcher", this.Batcher);
+        this.Batcher = uint64 (0);
+      endif
+      this.Runner = [];
       this.Session = [];
 
     endfunction
@@ -208,10 +412,58 @@ classdef TFModel < handle
       endif
     endfunction
 
+    ## Create the queue submitted requests are batched in
+    function ptr = newBatcher (this)
+      in_ptr = zeros (1, numel (this.InputNames), "uint64");
+      out_ptr = zeros (1, numel (this.OutputNames), "uint64");
+      unwind_protect
+        in_ptr = this.Session.resolveOutputs (this.InputNames, ...
+                                              "TFModel.submit");
+        out_ptr = this.Session.resolveOutputs (this.OutputNames, ...
+                                               "TFModel.submit");
+        ptr = tensorflow ("TF_NewBatcher", this.Session.Pointer, in_ptr, ...
+                          out_ptr, this.MaxBatchSize, this.MaxBatchWait, ...
+                          this.Layout);
+      unwind_protect_cleanup
+        for i = 1:numel (in_ptr)
+          if (in_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", in_ptr(i));
+          endif
+        endfor
+        for i = 1:numel (out_ptr)
+          if (out_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", out_ptr(i));
+          endif
+        endfor
+      end_unwind_protect
+    endfunction
+
   endmethods
 
   methods (Static, Access = private)
 
+    ## The signature named 'name', or when no name is given 'serving_default',
+    ## or else the only signature with inputs, if there is a single one.  The
+    ## '__saved_model_init_op' signature tf.saved_model.save adds takes none.
+    function sig = findSignature (sigs, name)
+      names = {sigs.Name};
+      if (! isempty (name))
+        k = find (strcmp (names, name));
+        if (isempty (k))
+          error ("TFModel: the SavedModel has no signature named '%s'.", name);
+        endif
+      else
+        k = find (strcmp (names, "serving_default"));
+        if (isempty (k))
+          k = find (arrayfun (@(s) ! isempty (s.Inputs), sigs));
+          if (numel (k) != 1)
+            k = [];
+          endif
+        endif
+      endif
+      sig = sigs(k);
+    endfunction
+
     ## The placeholders a serving signature feeds, which tf.saved_model.save
     ## names after the signature input.  Other placeholders, such as the
     ## 'saver_filename' of the checkpoint saver, are not model inputs.
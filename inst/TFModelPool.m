@@ -0,0 +1,290 @@
+## Copyright (C) 2026 Andreas Bertsatos <abertsatos@biol.uoa.gr>
+##
+## This file is part of the tensorflow package for GNU Octave.
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+## more details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+classdef TFModelPool < handle
+  ## -*- texinfo -*-
+  ## @deftp {tensorflow} TFModelPool
+  ##
+  ## Several Sessions over the same SavedModel, running requests in parallel.
+  ##
+  ## @example
+  ## @group
+  ## pool = TFModelPool ("path/to/saved_model", 8);
+  ## for i = 1:numel (x)
+  ##   ticket(i) = pool.submit (x@{i@});
+  ## endfor
+  ## for i = 1:numel (x)
+  ##   y@{i@} = pool.collect (ticket(i));
+  ## endfor
+  ## @end group
+  ## @end example
+  ##
+  ## A single Session runs one request at a time on behalf of Octave.  A pool
+  ## loads the model into several, each given its own budget of threads, and
+  ## dispatches the requests submitted to it on native threads, to whichever
+  ## Session is idle.  For small inputs several Sessions of a few threads each
+  ## keep many cores busier than one Session with all of them.
+  ##
+  ## @end deftp
+
+  properties (SetAccess = private)
+
+    ## -*- texinfo -*-
+    ## @deftp {TFModelPool} {property} Pointer
+    ## The @code{uint64} pointer to the pool, for use with the @code{OCT}
+    ## interface.  It is 0 once the pool has been released.
+    ## @end deftp
+    Pointer = uint64 (0);
+
+    ## -*- texinfo -*-
+    ## @deftp {TFModelPool} {property} Models
+    ## The @code{TFModel} objects holding the Sessions of the pool, as a cell
+    ## row vector.
+    ## @end deftp
+    Models = {};
+
+    ## -*- texinfo -*-
+    ## @deftp {TFModelPool} {property} IntraOpThreads
+    ## The number of threads each Session may use within an operation.
+    ## @end deftp
+    IntraOpThreads = 1;
+
+    ## -*- texinfo -*-
+    ## @deftp {TFModelPool} {property} InterOpThreads
+    ## The number of threads each Session runs independent operations on.
+    ## @end deftp
+    InterOpThreads = 1;
+
+  endproperties
+
+  properties (Access = private)
+
+    ## The TF_Runner of each Session, which the pool runs requests through
+    Runners = {};
+
+  endproperties
+
+  methods (Access = public)
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModelPool} {@var{obj} =} TFModelPool (@var{dirname}, @var{n})
+    ## @deftypefnx {TFModelPool} {@var{obj} =} TFModelPool (@var{dirname}, @var{n}, @var{name}, @var{value}, @dots{})
+    ##
+    ## Load the SavedModel in the directory @var{dirname} into @var{n}
+    ## Sessions.
+    ##
+    ## The following optional Name/Value pairs are accepted, along with those
+    ## of @code{TFModel}, which apply to every Session.  A @qcode{'Config'}
+    ## must be given as a struct, whose thread counts are those of the pool.
+    ##
+    ## @multitable @columnfractions 0.2 0.05 0.75
+    ## @headitem @var{Name} @tab @tab @var{Value}
+    ##
+    ## @item @qcode{'IntraOpThreads'} @tab @tab The number of threads each
+    ## Session may use within an operation.  The default shares the cores
+    ## reported by @code{nproc} evenly between the Sessions.
+    ##
+    ## @item @qcode{'InterOpThreads'} @tab @tab The number of threads each
+    ## Session runs independent operations on, in a thread pool of its own.
+    ## The default is 2.
+    ## @end multitable
+    ##
+    ## @end deftypefn
+    function this = TFModelPool (dirname, n, varargin)
+
+      if (nargin < 2)
+        print_usage ();
+      endif
+      if (! (isnumeric (n) && isreal (n) && isscalar (n)) || n < 1 ...
+          || fix (n) != n)
+        error ("TFModelPool: N must be a positive integer.");
+      endif
+      if (mod (numel (varargin), 2) != 0)
+        error (["TFModelPool: optional arguments must be given in", ...
+                " Name/Value pairs."]);
+      endif
+      intra = max (1, floor (nproc () / n));
+      inter = 2;
+      config = struct ();
+      args = {};
+      for i = 1:2:numel (varargin)
+        name = varargin{i};
+        if (! (ischar (name) && isrow (name)))
+          error ("TFModelPool: Name must be a character vector.");
+        endif
+        switch (lower (name))
+          case 'intraopthreads'
+            intra = TFModelPool.checkThreads (varargin{i+1}, ...
+                                              "IntraOpThreads");
+          case 'interopthreads'
+            inter = TFModelPool.checkThreads (varargin{i+1}, ...
+                                              "InterOpThreads");
+          case 'config'
+            config = varargin{i+1};
+            if (! (isstruct (config) && isscalar (config)))
+              error ("TFModelPool: 'Config' must be a scalar struct.");
+            endif
+          otherwise
+            args(end+1:end+2) = varargin(i:i+1);
+        endswitch
+      endfor
+      this.IntraOpThreads = intra;
+      this.InterOpThreads = inter;
+      config.intra_op_parallelism_threads = intra;
+      config.inter_op_parallelism_threads = inter;
+      config.use_per_session_threads = true;
+      this.Models = cell (1, n);
+      this.Runners = cell (1, n);
+      runners = zeros (1, n, "uint64");
+      for k = 1:n
+        m = TFModel (dirname, args{:}, "Config", config);
+        this.Models{k} = m;
+        this.Runners{k} = m.Session.prepare (m.InputNames, m.OutputNames, ...
+                                             "Layout", m.Layout);
+        runners(k) = this.Runners{k}.Pointer;
+      endfor
+      this.Pointer = tensorflow ("TF_NewModelPool", runners);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModelPool} {@var{ticket} =} submit (@var{obj}, @var{x})
+    ## @deftypefnx {TFModelPool} {@var{ticket} =} submit (@var{obj}, @var{x1}, @dots{}, @var{xN})
+    ##
+    ## Queue a request to run the model on @var{x} and return the
+    ## @var{ticket} its output is collected with.
+    ##
+    ## The inputs are converted before returning, and the request is run on a
+    ## native thread by the next idle Session, while Octave carries on.
+    ##
+    ## @end deftypefn
+    function ticket = submit (this, varargin)
+
+      if (nargin < 2)
+        print_usage ();
+      endif
+      this.assertValid ("TFModelPool.submit");
+      nin = numel (this.Models{1}.InputNames);
+      if (numel (varargin) != nin)
+        error ("TFModelPool.submit: %d input(s) expected, %d given.", ...
+               nin, numel (varargin));
+      endif
+      ticket = tensorflow ("TF_ModelPoolSubmit", this.Pointer, varargin);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModelPool} {@var{y} =} collect (@var{obj}, @var{ticket})
+    ##
+    ## Wait for the request identified by @var{ticket} to be run and return its
+    ## output, as @code{TFModel.predict} would have.  Each ticket is collected
+    ## once.
+    ##
+    ## @end deftypefn
+    function y = collect (this, ticket)
+
+      if (nargin != 2)
+        print_usage ();
+      endif
+      this.assertValid ("TFModelPool.collect");
+      y = tensorflow ("TF_ModelPoolCollect", this.Pointer, uint64 (ticket));
+      if (numel (y) == 1)
+        y = y{1};
+      endif
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModelPool} {@var{y} =} predict (@var{obj}, @var{x})
+    ## @deftypefnx {TFModelPool} {@var{y} =} predict (@var{obj}, @var{x1}, @dots{}, @var{xN})
+    ##
+    ## Run the model on @var{x} in the next idle Session and return its output.
+    ##
+    ## @end deftypefn
+    function y = predict (this, varargin)
+
+      if (nargin < 2)
+        print_usage ();
+      endif
+      y = this.collect (this.submit (varargin{:}));
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModelPool} {@var{s} =} stats (@var{obj})
+    ##
+    ## Return the state of the pool as a structure with the fields
+    ## @qcode{sessions}, @qcode{requests}, @qcode{pending} and @qcode{busy},
+    ## counting the Sessions, the requests submitted, those still queued and
+    ## the Sessions running one, and @qcode{runs}, the number of requests run
+    ## by each Session.
+    ##
+    ## @end deftypefn
+    function s = stats (this)
+
+      if (nargin != 1)
+        print_usage ();
+      endif
+      this.assertValid ("TFModelPool.stats");
+      s = tensorflow ("TF_ModelPoolStats", this.Pointer);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TFModelPool} {} delete (@var{obj})
+    ##
+    ## Release the pool and its Sessions, dropping the requests still queued
+    ## and waiting for those being run.
+    ##
+    ## @end deftypefn
+    function delete (this)
+
+      if (this.Pointer != 0)
+        tensorflow ("TF_DeleteModelPool", this.Pointer);
+      endif
+      this.Pointer = uint64 (0);
+      this.Runners = {};
+      this.Models = {};
+
+    endfunction
+
+  endmethods
+
+  methods (Access = private)
+
+    function assertValid (this, caller)
+      if (this.Pointer == 0)
+        error ("%s: the pool has already been released.", caller);
+      endif
+    endfunction
+
+  endmethods
+
+  methods (Static, Access = private)
+
+    ## Validate a number of threads
+    function n = checkThreads (n, name)
+      if (! (isnumeric (n) && isreal (n) && isscalar (n)) || n < 1 ...
+          || fix (n) != n)
+        error ("TFModelPool: '%s' must be a positive integer.", name);
+      endif
+      n = double (n);
+    endfunction
+
+  endmethods
+
+endclassdef
@@ -0,0 +1,231 @@
+## Copyright (C) 2026 Andreas Bertsatos <abertsatos@biol.uoa.gr>
+##
+## This file is part of the tensorflow package for GNU Octave.
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+## more details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+classdef TF_AsyncRun < handle
+  ## -*- texinfo -*-
+  ## @deftp {tensorflow} TF_AsyncRun
+  ##
+  ## A run of a Session executing in the background.
+  ##
+  ## @example
+  ## @group
+  ## h = session.runAsync ("serving_default_x", x, "StatefulPartitionedCall");
+  ## ## ... prepare the next input meanwhile ...
+  ## y = h.fetch ();
+  ## @end group
+  ## @end example
+  ##
+  ## The values are converted when the run is started, and the Session then
+  ## executes on a worker thread while Octave carries on.  @code{isDone} and
+  ## @code{wait} tell when it has completed, and @code{fetch} returns the
+  ## outputs, waiting for them if need be.  The Tensors the run is fed are
+  ## held until the object is released, including any @code{TF_Tensor} given
+  ## among the values.
+  ##
+  ## @end deftp
+
+  properties (SetAccess = private)
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_AsyncRun} {property} Pointer
+    ## The @code{uint64} pointer to the run, for use with the @code{OCT}
+    ## interface.  It is 0 once the run has been released.
+    ## @end deftp
+    Pointer = uint64 (0);
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_AsyncRun} {property} Session
+    ## The @code{TF_Session} the run executes in.
+    ## @end deftp
+    Session = [];
+
+  endproperties
+
+  properties (Access = private)
+
+    ## The TF_Tensor objects fed to the run, kept until it is released
+    Tensors = {};
+
+  endproperties
+
+  methods (Access = public)
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_AsyncRun} {@var{obj} =} TF_AsyncRun (@var{session}, @var{inputs}, @var{values}, @var{outputs})
+    ## @deftypefnx {TF_AsyncRun} {@var{obj} =} TF_AsyncRun (@dots{}, @qcode{'Layout'}, @var{layout})
+    ##
+    ## Start running @var{session}, which must be a @code{TF_Session} object,
+    ## in the background.  The arguments are those of @code{TF_Session.run},
+    ## and this is what @code{TF_Session.runAsync} returns.
+    ##
+    ## @end deftypefn
+    function this = TF_AsyncRun (session, inputs, values, outputs, varargin)
+
+      if (nargin == 0)
+        return;
+      endif
+      if (nargin != 4 && nargin != 6)
+        print_usage ();
+      endif
+      if (! isa (session, "TF_Session"))
+        error ("TF_AsyncRun: SESSION must be a TF_Session object.");
+      endif
+      if (session.Pointer == 0)
+        error ("TF_AsyncRun: the Session has already been released.");
+      endif
+      layout = "rowmajor";
+      if (nargin == 6)
+        if (! strcmpi (varargin{1}, "Layout"))
+          error ("TF_AsyncRun: unrecognized parameter name '%s'.", ...
+                 num2str (varargin{1}));
+        endif
+        layout = TF_Tensor.checkLayout (varargin{2}, "TF_AsyncRun");
+      endif
+      inputs = TF_Session.asCellstr (inputs, "INPUTS", "TF_AsyncRun");
+      outputs = TF_Session.asCellstr (outputs, "OUTPUTS", "TF_AsyncRun");
+      if (! iscell (values))
+        values = {values};
+      endif
+      if (numel (values) != numel (inputs))
+        error ("TF_AsyncRun: VALUES must have as many elements as INPUTS.");
+      endif
+      tensors = false (1, numel (values));
+      for i = 1:numel (values)
+        if (isa (values{i}, "TF_Tensor"))
+          tensors(i) = true;
+          this.Tensors{end+1} = values{i};
+          values{i} = values{i}.Pointer;
+        endif
+      endfor
+      in_ptr = zeros (1, numel (inputs), "uint64");
+      out_ptr = zeros (1, numel (outputs), "uint64");
+      unwind_protect
+        in_ptr = session.resolveOutputs (inputs, "TF_AsyncRun");
+        out_ptr = session.resolveOutputs (outputs, "TF_AsyncRun");
+        this.Pointer = tensorflow ("TF_SessionRunAsync", session.Pointer, ...
+                                   in_ptr, values, out_ptr, layout, tensors);
+      unwind_protect_cleanup
+        for i = 1:numel (in_ptr)
+          if (in_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", in_ptr(i));
+          endif
+        endfor
+        for i = 1:numel (out_ptr)
+          if (out_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", out_ptr(i));
+          endif
+        endfor
+      end_unwind_protect
+      this.Session = session;
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_AsyncRun} {@var{tf} =} isDone (@var{obj})
+    ##
+    ## Return true once the run has completed, successfully or not.
+    ##
+    ## @end deftypefn
+    function tf = isDone (this)
+
+      if (nargin != 1)
+        print_usage ();
+      endif
+      this.assertValid ("TF_AsyncRun.isDone");
+      tf = tensorflow ("TF_AsyncRunIsDone", this.Pointer);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_AsyncRun} {@var{tf} =} wait (@var{obj})
+    ## @deftypefnx {TF_AsyncRun} {@var{tf} =} wait (@var{obj}, @var{timeout})
+    ##
+    ## Wait for the run to complete, for at most @var{timeout} seconds, and
+    ## return whether it has.  Without @var{timeout} it waits as long as the
+    ## run takes.
+    ##
+    ## @end deftypefn
+    function tf = wait (this, timeout)
+
+      if (nargin < 1 || nargin > 2)
+        print_usage ();
+      endif
+      this.assertValid ("TF_AsyncRun.wait");
+      if (nargin < 2)
+        timeout = Inf;
+      endif
+      if (! (isnumeric (timeout) && isreal (timeout) && isscalar (timeout)) ...
+          || timeout < 0)
+        error ("TF_AsyncRun.wait: TIMEOUT must be a non-negative scalar.");
+      endif
+      tf = tensorflow ("TF_AsyncRunWait", this.Pointer, double (timeout));
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_AsyncRun} {@var{out} =} fetch (@var{obj})
+    ##
+    ## Wait for the run to complete and return its outputs, as
+    ## @code{TF_Session.run} would have.  The outputs can be fetched once.
+    ##
+    ## @end deftypefn
+    function out = fetch (this)
+
+      if (nargin != 1)
+        print_usage ();
+      endif
+      this.assertValid ("TF_AsyncRun.fetch");
+      out = tensorflow ("TF_AsyncRunFetch", this.Pointer);
+      if (numel (out) == 1)
+        out = out{1};
+      endif
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_AsyncRun} {} delete (@var{obj})
+    ##
+    ## Release the run, waiting for it first if it is still executing.
+    ##
+    ## This is called automatically when no variable refers to the object any
+    ## more, and calling it a second time does nothing.
+    ##
+    ## @end deftypefn
+    function delete (this)
+
+      if (this.Pointer != 0)
+        tensorflow ("TF_DeleteAsyncRun", this.Pointer);
+      endif
+      this.Pointer = uint64 (0);
+      this.Tensors = {};
+      this.Session = [];
+
+    endfunction
+
+  endmethods
+
+  methods (Access = private)
+
+    function assertValid (this, caller)
+      if (this.Pointer == 0)
+        error ("%s: the run has already been released.", caller);
+      endif
+    endfunction
+
+  endmethods
+
+endclassdef
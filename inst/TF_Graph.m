@@ -47,9 +47,14 @@ classdef TF_Graph < handle
     ## Create an empty Graph.
     ##
     ## @end deftypefn
-    function this = TF_Graph ()
+    function this = TF_Graph (ptr)
 
-      this.Pointer = tensorflow ("TF_NewGraph");
+      if (nargin == 0)
+        this.Pointer = tensorflow ("TF_NewGraph");
+      else
+        ## Take over a Graph from the OCT interface, as fromPointer does
+        this.Pointer = uint64 (ptr);
+      endif
 
     endfunction
 
@@ -64,7 +69,8 @@ classdef TF_Graph < handle
       if (nargin != 1)
         print_usage ();
       endif
-      names = this.operationField ("TF_OperationName");
+      this.assertValid ("TF_Graph.operationNames");
+      names = tensorflow ("TF_GraphOperationTable", this.Pointer).Name.';
 
     endfunction
 
@@ -80,7 +86,127 @@ classdef TF_Graph < handle
       if (nargin != 1)
         print_usage ();
       endif
-      types = this.operationField ("TF_OperationOpType");
+      this.assertValid ("TF_Graph.operationTypes");
+      types = tensorflow ("TF_GraphOperationTable", this.Pointer).OpType.';
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Graph} {@var{t} =} operationTable (@var{obj})
+    ##
+    ## Describe every operation in the Graph, in a single call to the
+    ## @code{OCT} interface.
+    ##
+    ## @var{t} is a scalar struct of column vectors with one row per operation,
+    ## in the same order as @code{operationNames}: @qcode{'Pointer'},
+    ## @qcode{'Name'}, @qcode{'OpType'}, @qcode{'Device'}, @qcode{'NumInputs'},
+    ## @qcode{'NumOutputs'} and @qcode{'OutputTypes'}, the last a cell array of
+    ## @code{uint32} row vectors holding the data type of each output, whose
+    ## name @code{tensorflow ("TF_DataTypeName", @var{type})} returns.
+    ##
+    ## @end deftypefn
+    function t = operationTable (this)
+
+      if (nargin != 1)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Graph.operationTable");
+      t = tensorflow ("TF_GraphOperationTable", this.Pointer);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Graph} {@var{a} =} adjacency (@var{obj})
+    ## @deftypefnx {TF_Graph} {@var{a} =} adjacency (@var{obj}, @var{sparse})
+    ##
+    ## Return every data and control edge of the Graph, in a single call to
+    ## the @code{OCT} interface.
+    ##
+    ## @var{a} is a scalar struct holding the @code{uint64} column
+    ## @qcode{'Pointer'} to each operation, in the same order as
+    ## @code{operationNames}, and the edges between them, referred to by their
+    ## row in @qcode{'Pointer'}: @qcode{'Data'}, a matrix with a row of the
+    ## source row, its output index, the target row and its input index per
+    ## data edge, the indices being zero based, and @qcode{'Control'}, a matrix
+    ## with a row of the source and target row per control edge.  When
+    ## @var{sparse} is true, @qcode{'Adjacency'} is added, a sparse matrix
+    ## counting the edges of both kinds from the operation of each row to the
+    ## operation of each column.
+    ##
+    ## @end deftypefn
+    function a = adjacency (this, sparse = false)
+
+      if (nargin < 1 || nargin > 2)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Graph.adjacency");
+      if (! (isscalar (sparse) && (islogical (sparse) || isnumeric (sparse))))
+        error ("TF_Graph.adjacency: SPARSE must be a logical scalar.");
+      endif
+      a = tensorflow ("TF_GraphAdjacency", this.Pointer, logical (sparse));
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Graph} {@var{g} =} prune (@var{obj}, @var{fetches})
+    ## @deftypefnx {TF_Graph} {@var{g} =} prune (@var{obj}, @var{fetches}, @var{feeds})
+    ##
+    ## Return a new @code{TF_Graph} holding only the operations needed to
+    ## compute @var{fetches}.
+    ##
+    ## @var{fetches} is the name of an operation or a cellstr array of them,
+    ## each optionally followed by @qcode{:index}.  The operations they depend
+    ## on, through their data and control inputs, are kept, and everything
+    ## else, such as saver operations or unused heads, is dropped.  The walk
+    ## stops at the operations named in the cellstr array @var{feeds}, whose
+    ## own inputs are dropped, each being replaced with a @qcode{Placeholder}
+    ## of the same data type and shape unless it is one.  A Session over the
+    ## pruned Graph starts faster and holds less memory.
+    ##
+    ## @end deftypefn
+    function g = prune (this, fetches, feeds = {})
+
+      if (nargin < 2 || nargin > 3)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Graph.prune");
+      if (ischar (fetches))
+        fetches = {fetches};
+      endif
+      if (! iscellstr (fetches) || isempty (fetches))
+        error ("TF_Graph.prune: FETCHES must be a character vector or a %s", ...
+               "non-empty cellstr array.");
+      endif
+      if (! iscellstr (feeds))
+        error ("TF_Graph.prune: FEEDS must be a cellstr array.");
+      endif
+      g = TF_Graph.fromPointer (tensorflow ("TF_GraphPrune", this.Pointer, ...
+                                            fetches, feeds));
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Graph} {@var{ptr} =} operations (@var{obj}, @var{names})
+    ##
+    ## Return the pointers to the operations named in the cellstr array
+    ## @var{names}, in a @code{uint64} array of the same size, holding 0 for
+    ## each name the Graph does not hold.
+    ##
+    ## The names are resolved in a single call to the @code{OCT} interface,
+    ## through a hash index of the Graph which is kept until an operation is
+    ## added to it.
+    ##
+    ## @end deftypefn
+    function ptr = operations (this, names)
+
+      if (nargin != 2)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Graph.operations");
+      if (! iscellstr (names))
+        error ("TF_Graph.operations: NAMES must be a cellstr array.");
+      endif
+      ptr = tensorflow ("TF_GraphOperationsByName", this.Pointer, names);
 
     endfunction
 
@@ -99,7 +225,7 @@ classdef TF_Graph < handle
       if (! (ischar (name) && isrow (name)))
         error ("TF_Graph.hasOperation: NAME must be a character vector.");
       endif
-      tf = tensorflow ("TF_GraphOperationByName", this.Pointer, name) != 0;
+      tf = tensorflow ("TF_GraphOperationsByName", this.Pointer, name) != 0;
 
     endfunction
 
@@ -147,7 +273,7 @@ classdef TF_Graph < handle
       if (! (ischar (name) && isrow (name)))
         error ("%s: NAME must be a character vector.", caller);
       endif
-      ptr = tensorflow ("TF_GraphOperationByName", this.Pointer, name);
+      ptr = tensorflow ("TF_GraphOperationsByName", this.Pointer, name);
       if (ptr == 0)
         error ("%s: the Graph holds no operation named '%s'.", caller, name);
       endif
@@ -157,16 +283,6 @@ classdef TF_Graph < handle
 
   methods (Access = private)
 
-    ## Apply an OCT interface call returning a string to every operation
-    function out = operationField (this, call)
-      this.assertValid (["TF_Graph." call]);
-      opers = tensorflow ("TF_GraphOperations", this.Pointer);
-      out = cell (1, numel (opers));
-      for i = 1:numel (opers)
-        out{i} = tensorflow (call, opers(i));
-      endfor
-    endfunction
-
     function assertValid (this, caller)
       if (this.Pointer == 0)
         error ("%s: the Graph has already been released.", caller);
@@ -179,9 +295,7 @@ classdef TF_Graph < handle
 
     ## Wrap a Graph pointer that came from the OCT interface
     function this = fromPointer (ptr)
-      this = TF_Graph ();
-      tensorflow ("TF_DeleteGraph", this.Pointer);
-      this.Pointer = uint64 (ptr);
+      this = TF_Graph (ptr);
     endfunction
 
   endmethods
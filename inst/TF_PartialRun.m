@@ -0,0 +1,258 @@
+## Copyright (C) 2026 Andreas Bertsatos <abertsatos@biol.uoa.gr>
+##
+## This file is part of the tensorflow package for GNU Octave.
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+## more details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+classdef TF_PartialRun < handle
+  ## -*- texinfo -*-
+  ## @deftp {tensorflow} TF_PartialRun
+  ##
+  ## A partial run of a Session, which feeds its inputs and fetches its
+  ## outputs over several calls.
+  ##
+  ## @example
+  ## @group
+  ## p = session.partialRun (@{"encoder_in", "decoder_in"@}, "decoder_out");
+  ## p.run ("encoder_in", x, @{@});
+  ## y = p.run ("decoder_in", z, "decoder_out");
+  ## @end group
+  ## @end example
+  ##
+  ## Every input and output the run will use is named when it is set up, and
+  ## each is then fed or fetched once, in any number of steps.  Whatever the
+  ## Graph computes in between stays inside TensorFlow, so the intermediate
+  ## state of a staged model never crosses into Octave.
+  ##
+  ## A @code{TF_PartialRun} keeps a reference to its @code{TF_Session}, so the
+  ## Session outlives it whatever order the variables are cleared in.
+  ##
+  ## @end deftp
+
+  properties (SetAccess = private)
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_PartialRun} {property} Handle
+    ## The @code{uint64} pointer to the handle of the partial run, for use
+    ## with the @code{OCT} interface.  It is 0 once the handle has been
+    ## released.
+    ## @end deftp
+    Handle = uint64 (0);
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_PartialRun} {property} Session
+    ## The @code{TF_Session} the partial run executes in.
+    ## @end deftp
+    Session = [];
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_PartialRun} {property} InputNames
+    ## The operations that may be fed, as a cellstr row vector.
+    ## @end deftp
+    InputNames = {};
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_PartialRun} {property} OutputNames
+    ## The operations that may be fetched, as a cellstr row vector.
+    ## @end deftp
+    OutputNames = {};
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_PartialRun} {property} Layout
+    ## How inputs and outputs are laid out, either @qcode{'rowmajor'} or
+    ## @qcode{'native'}.  See @code{TF_Tensor}.
+    ## @end deftp
+    Layout = "rowmajor";
+
+  endproperties
+
+  methods (Access = public)
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_PartialRun} {@var{obj} =} TF_PartialRun (@var{session}, @var{inputs}, @var{outputs})
+    ## @deftypefnx {TF_PartialRun} {@var{obj} =} TF_PartialRun (@dots{}, @qcode{'Layout'}, @var{layout})
+    ##
+    ## Set up a partial run of @var{session}, which must be a
+    ## @code{TF_Session} object, feeding the operations named by @var{inputs}
+    ## and fetching those named by @var{outputs}.  This is what
+    ## @code{TF_Session.partialRun} returns.
+    ##
+    ## @var{inputs} and @var{outputs} are either a character vector or a
+    ## cellstr vector, each name optionally carrying an output index as
+    ## @qcode{'name:index'}.  @var{layout} is either @qcode{'rowmajor'}, the
+    ## default, or @qcode{'native'}, as for @code{TF_Session.run}.
+    ##
+    ## @end deftypefn
+    function this = TF_PartialRun (session, inputs, outputs, varargin)
+
+      if (nargin == 0)
+        return;
+      endif
+      if (nargin != 3 && nargin != 5)
+        print_usage ();
+      endif
+      if (! isa (session, "TF_Session"))
+        error ("TF_PartialRun: SESSION must be a TF_Session object.");
+      endif
+      if (session.Pointer == 0)
+        error ("TF_PartialRun: the Session has already been released.");
+      endif
+      if (nargin == 5)
+        if (! strcmpi (varargin{1}, "Layout"))
+          error ("TF_PartialRun: unrecognized parameter name '%s'.", ...
+                 num2str (varargin{1}));
+        endif
+        this.Layout = TF_Tensor.checkLayout (varargin{2}, "TF_PartialRun");
+      endif
+      inputs = TF_Session.asCellstr (inputs, "INPUTS", "TF_PartialRun");
+      outputs = TF_Session.asCellstr (outputs, "OUTPUTS", "TF_PartialRun");
+      in_ptr = zeros (1, numel (inputs), "uint64");
+      out_ptr = zeros (1, numel (outputs), "uint64");
+      unwind_protect
+        in_ptr = session.resolveOutputs (inputs, "TF_PartialRun");
+        out_ptr = session.resolveOutputs (outputs, "TF_PartialRun");
+        status = tensorflow ("TF_NewStatus");
+        handle = tensorflow ("TF_SessionPRunSetup", session.Pointer, ...
+                             in_ptr, out_ptr, uint64 ([]), status);
+        __tf_check__ (status, "TF_PartialRun");
+      unwind_protect_cleanup
+        TF_PartialRun.deleteOutputs ([in_ptr, out_ptr]);
+      end_unwind_protect
+      this.Handle = handle;
+      this.Session = session;
+      this.InputNames = inputs;
+      this.OutputNames = outputs;
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_PartialRun} {@var{out} =} run (@var{obj}, @var{inputs}, @var{values}, @var{outputs})
+    ##
+    ## Feed @var{values} to @var{inputs} and fetch @var{outputs}, continuing
+    ## the partial run.
+    ##
+    ## @var{inputs} and @var{outputs} name some of the operations the partial
+    ## run was set up with, either of them possibly an empty cell for a step
+    ## that only feeds or only fetches.  @var{values} and @var{out} are as for
+    ## @code{TF_Session.run}.  Each input and each output may be named by a
+    ## single step of the partial run.
+    ##
+    ## @end deftypefn
+    function out = run (this, inputs, values, outputs)
+
+      if (nargin != 4)
+        print_usage ();
+      endif
+      this.assertValid ("TF_PartialRun.run");
+      inputs = TF_Session.asCellstr (inputs, "INPUTS", "TF_PartialRun.run");
+      outputs = TF_Session.asCellstr (outputs, "OUTPUTS", "TF_PartialRun.run");
+      if (! iscell (values))
+        values = {values};
+      endif
+      if (numel (values) != numel (inputs))
+        error (["TF_PartialRun.run: VALUES must have as many elements as", ...
+                " INPUTS."]);
+      endif
+      session = this.Session;
+      in_ptr = zeros (1, numel (inputs), "uint64");
+      val_ptr = zeros (1, numel (values), "uint64");
+      own = false (1, numel (values));
+      out_ptr = zeros (1, numel (outputs), "uint64");
+      res = zeros (1, 0, "uint64");
+      unwind_protect
+        in_ptr = session.resolveOutputs (inputs, "TF_PartialRun.run");
+        for i = 1:numel (inputs)
+          if (isa (values{i}, "TF_Tensor"))
+            val_ptr(i) = values{i}.Pointer;
+          else
+            val_ptr(i) = tensorflow ("TF_LoadTensor", values{i}, this.Layout);
+            own(i) = true;
+          endif
+        endfor
+        out_ptr = session.resolveOutputs (outputs, "TF_PartialRun.run");
+        status = tensorflow ("TF_NewStatus");
+        res = tensorflow ("TF_SessionPRun", session.Pointer, this.Handle, ...
+                          in_ptr, val_ptr, out_ptr, uint64 ([]), status);
+        __tf_check__ (status, "TF_PartialRun.run");
+        out = cell (1, numel (res));
+        for i = 1:numel (res)
+          out{i} = tensorflow ("TF_SaveTensor", res(i), this.Layout, true);
+          res(i) = 0;
+        endfor
+        if (numel (out) == 1)
+          out = out{1};
+        endif
+      unwind_protect_cleanup
+        for i = 1:numel (res)
+          if (res(i) != 0)
+            tensorflow ("TF_DeleteTensor", res(i));
+          endif
+        endfor
+        for i = 1:numel (val_ptr)
+          if (own(i) && val_ptr(i) != 0)
+            tensorflow ("TF_DeleteTensor", val_ptr(i));
+          endif
+        endfor
+        TF_PartialRun.deleteOutputs ([in_ptr, out_ptr]);
+      end_unwind_protect
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_PartialRun} {} delete (@var{obj})
+    ##
+    ## Release the handle of the partial run, leaving its Session open.
+    ##
+    ## This is called automatically when no variable refers to the object any
+    ## more, and calling it a second time does nothing.
+    ##
+    ## @end deftypefn
+    function delete (this)
+
+      if (this.Handle != 0)
+        tensorflow ("TF_DeletePRunHandle", this.Handle);
+      endif
+      this.Handle = uint64 (0);
+      this.Session = [];
+
+    endfunction
+
+  endmethods
+
+  methods (Access = private)
+
+    function assertValid (this, caller)
+      if (this.Handle == 0)
+        error ("%s: the partial run has already been released.", caller);
+      endif
+      if (this.Session.Pointer == 0)
+        error ("%s: the Session has already been released.", caller);
+      endif
+    endfunction
+
+  endmethods
+
+  methods (Static, Access = private)
+
+    function deleteOutputs (ptr)
+      for i = 1:numel (ptr)
+        if (ptr(i) != 0)
+          tensorflow ("TF_DeleteOutput", ptr(i));
+        endif
+      endfor
+    endfunction
+
+  endmethods
+
+endclassdef
@@ -0,0 +1,216 @@
+## Copyright (C) 2026 Andreas Bertsatos <abertsatos@biol.uoa.gr>
+##
+## This file is part of the tensorflow package for GNU Octave.
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+## more details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+classdef TF_Runner < handle
+  ## -*- texinfo -*-
+  ## @deftp {tensorflow} TF_Runner
+  ##
+  ## A Session prepared to be run repeatedly with the same inputs and outputs.
+  ##
+  ## @example
+  ## @group
+  ## runner = session.prepare ("serving_default_x", "StatefulPartitionedCall");
+  ## y = runner.run (x);
+  ## @end group
+  ## @end example
+  ##
+  ## The operation names are resolved once, when the Runner is created, and
+  ## held natively along with the Status every run reports through.  Each
+  ## @code{run} then converts the values, executes the Graph and converts the
+  ## outputs back in a single call to the @code{OCT} interface, instead of the
+  ## dozen or so @code{TF_Session.run} makes.
+  ##
+  ## A @code{TF_Runner} keeps a reference to its @code{TF_Session}, so the
+  ## Session outlives it whatever order the variables are cleared in.
+  ##
+  ## @end deftp
+
+  properties (SetAccess = private)
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_Runner} {property} Pointer
+    ## The @code{uint64} pointer to the Runner, for use with the @code{OCT}
+    ## interface.  It is 0 once the Runner has been released.
+    ## @end deftp
+    Pointer = uint64 (0);
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_Runner} {property} Session
+    ## The @code{TF_Session} the Runner executes.
+    ## @end deftp
+    Session = [];
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_Runner} {property} InputNames
+    ## The operations the values are fed to, as a cellstr row vector.
+    ## @end deftp
+    InputNames = {};
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_Runner} {property} OutputNames
+    ## The operations the outputs are read from, as a cellstr row vector.
+    ## @end deftp
+    OutputNames = {};
+
+    ## -*- texinfo -*-
+    ## @deftp {TF_Runner} {property} Layout
+    ## How inputs and outputs are laid out, either @qcode{'rowmajor'} or
+    ## @qcode{'native'}.  See @code{TF_Tensor}.
+    ## @end deftp
+    Layout = "rowmajor";
+
+  endproperties
+
+  methods (Access = public)
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Runner} {@var{obj} =} TF_Runner (@var{session}, @var{inputs}, @var{outputs})
+    ## @deftypefnx {TF_Runner} {@var{obj} =} TF_Runner (@dots{}, @qcode{'Layout'}, @var{layout})
+    ##
+    ## Prepare @var{session}, which must be a @code{TF_Session} object, to be
+    ## run with the operations named by @var{inputs} fed and those named by
+    ## @var{outputs} read.  This is what @code{TF_Session.prepare} returns.
+    ##
+    ## @var{inputs} and @var{outputs} are either a character vector or a
+    ## cellstr vector, each name optionally carrying an output index as
+    ## @qcode{'name:index'}.  @var{layout} is either @qcode{'rowmajor'}, the
+    ## default, or @qcode{'native'}, as for @code{TF_Session.run}.
+    ##
+    ## @end deftypefn
+    function this = TF_Runner (session, inputs, outputs, varargin)
+
+      if (nargin == 0)
+        return;
+      endif
+      if (nargin != 3 && nargin != 5)
+        print_usage ();
+      endif
+      if (! isa (session, "TF_Session"))
+        error ("TF_Runner: SESSION must be a TF_Session object.");
+      endif
+      if (session.Pointer == 0)
+        error ("TF_Runner: the Session has already been released.");
+      endif
+      if (nargin == 5)
+        if (! strcmpi (varargin{1}, "Layout"))
+          error ("TF_Runner: unrecognized parameter name '%s'.", ...
+                 num2str (varargin{1}));
+        endif
+        this.Layout = TF_Tensor.checkLayout (varargin{2}, "TF_Runner");
+      endif
+      inputs = TF_Session.asCellstr (inputs, "INPUTS", "TF_Runner");
+      outputs = TF_Session.asCellstr (outputs, "OUTPUTS", "TF_Runner");
+      ## The Outputs are copied into the Runner, so those built here are
+      ## released as soon as it is created.
+      in_ptr = zeros (1, numel (inputs), "uint64");
+      out_ptr = zeros (1, numel (outputs), "uint64");
+      unwind_protect
+        in_ptr = session.resolveOutputs (inputs, "TF_Runner");
+        out_ptr = session.resolveOutputs (outputs, "TF_Runner");
+        this.Pointer = tensorflow ("TF_NewRunner", session.Pointer, ...
+                                   in_ptr, out_ptr, this.Layout);
+      unwind_protect_cleanup
+        for i = 1:numel (in_ptr)
+          if (in_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", in_ptr(i));
+          endif
+        endfor
+        for i = 1:numel (out_ptr)
+          if (out_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", out_ptr(i));
+          endif
+        endfor
+      end_unwind_protect
+      this.Session = session;
+      this.InputNames = inputs;
+      this.OutputNames = outputs;
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Runner} {@var{out} =} run (@var{obj}, @var{values})
+    ##
+    ## Execute the Graph on @var{values} and return the outputs.
+    ##
+    ## @var{values} is either an Octave array, a @code{TF_Tensor}, or a cell
+    ## array of either, and must have as many elements as the Runner has
+    ## @qcode{'InputNames'}.  @var{out} is an Octave array when the Runner has
+    ## a single output, and a cell array of them otherwise.
+    ##
+    ## @end deftypefn
+    function out = run (this, values)
+
+      if (nargin != 2)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Runner.run");
+      if (! iscell (values))
+        values = {values};
+      endif
+      if (numel (values) != numel (this.InputNames))
+        error ("TF_Runner.run: VALUES must have as many elements as INPUTS.");
+      endif
+      ## Tensors are fed by their pointer, and left to the caller
+      tensors = false (1, numel (values));
+      for i = 1:numel (values)
+        if (isa (values{i}, "TF_Tensor"))
+          tensors(i) = true;
+          values{i} = values{i}.Pointer;
+        endif
+      endfor
+      out = tensorflow ("TF_RunnerRun", this.Pointer, values, tensors);
+      if (numel (out) == 1)
+        out = out{1};
+      endif
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Runner} {} delete (@var{obj})
+    ##
+    ## Release the Runner, leaving its Session open.
+    ##
+    ## This is called automatically when no variable refers to the object any
+    ## more, and calling it a second time does nothing.
+    ##
+    ## @end deftypefn
+    function delete (this)
+
+      if (this.Pointer != 0)
+        tensorflow ("TF_DeleteRunner", this.Pointer);
+      endif
+      this.Pointer = uint64 (0);
+      this.Session = [];
+
+    endfunction
+
+  endmethods
+
+  methods (Access = private)
+
+    function assertValid (this, caller)
+      if (this.Pointer == 0)
+        error ("%s: the Runner has already been released.", caller);
+      endif
+      if (this.Session.Pointer == 0)
+        error ("%s: the Session has already been released.", caller);
+      endif
+    endfunction
+
+  endmethods
+
+endclassdef
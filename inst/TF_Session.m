@@ -46,6 +46,17 @@ classdef TF_Session < handle
     ## @end deftp
     Graph = [];
 
+    ## -*- texinfo -*-
+    ## @deftp {TF_Session} {property} Signatures
+    ## The signatures of the SavedModel the Session was loaded from, as a
+    ## struct column vector with the fields @qcode{'Name'},
+    ## @qcode{'MethodName'}, @qcode{'Inputs'} and @qcode{'Outputs'}, as
+    ## returned by @code{TF_SignatureDefs}.  It is empty for a Session created
+    ## over a Graph.
+    ## @end deftp
+    Signatures = struct ("Name", {}, "MethodName", {}, "Inputs", {}, ...
+                         "Outputs", {});
+
   endproperties
 
   methods (Access = public)
@@ -80,6 +91,7 @@ classdef TF_Session < handle
 
     ## -*- texinfo -*-
     ## @deftypefn  {TF_Session} {@var{out} =} run (@var{obj}, @var{inputs}, @var{values}, @var{outputs})
+    ## @deftypefnx {TF_Session} {@var{out} =} run (@dots{}, @qcode{'Layout'}, @var{layout})
     ##
     ## Execute the Graph and return the requested outputs.
     ##
@@ -88,77 +100,145 @@ classdef TF_Session < handle
     ## vector or a cellstr vector, each name optionally carrying an output index
     ## as @qcode{'name:index'}.  @var{values} holds the values fed to
     ## @var{inputs}, either an Octave array, a @code{TF_Tensor}, or a cell array
-    ## of either, and must have as many elements as @var{inputs}.
+    ## of either, and must have as many elements as @var{inputs}.  A
+    ## @code{double} or @code{single} array fed to a @qcode{'TF_FLOAT'} or
+    ## @qcode{'TF_DOUBLE'} input is converted to its data type as it is copied,
+    ## so a @code{double} array may be fed to a @qcode{'TF_FLOAT'} input
+    ## without calling @code{single}.  Other floating point inputs, such as
+    ## @qcode{'TF_HALF'}, take a @code{TF_Tensor} of their own data type.
     ##
     ## @var{out} is an Octave array when a single output is requested, and a
     ## cell array of them otherwise.
     ##
+    ## @var{layout} is either @qcode{'rowmajor'}, the default, or
+    ## @qcode{'native'}, in which the Octave arrays among @var{values} are fed
+    ## with their dimensions reversed and the outputs are returned with theirs
+    ## reversed, with the data copied as it is in both directions.  See
+    ## @code{TF_Tensor}.
+    ##
     ## @end deftypefn
-    function out = run (this, inputs, values, outputs)
+    function out = run (this, inputs, values, outputs, varargin)
 
-      if (nargin != 4)
+      if (nargin != 4 && nargin != 6)
         print_usage ();
       endif
-      this.assertValid ("TF_Session.run");
-      inputs = TF_Session.asCellstr (inputs, "INPUTS", "TF_Session.run");
-      outputs = TF_Session.asCellstr (outputs, "OUTPUTS", "TF_Session.run");
-      if (! iscell (values))
-        values = {values};
+      out = this.runValues ("TF_SessionRunValues", "TF_Session.run", ...
+                            inputs, values, outputs, varargin);
+      if (numel (out) == 1)
+        out = out{1};
       endif
-      if (numel (values) != numel (inputs))
-        error (["TF_Session.run: VALUES must have as many elements as", ...
-                " INPUTS."]);
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Session} {@var{prof} =} profile (@var{obj}, @var{inputs}, @var{values}, @var{outputs})
+    ## @deftypefnx {TF_Session} {@var{prof} =} profile (@dots{}, @qcode{'Layout'}, @var{layout})
+    ## @deftypefnx {TF_Session} {[@var{prof}, @var{out}] =} profile (@dots{})
+    ##
+    ## Execute the Graph as @code{run} does, tracing every node it executes,
+    ## and return where the time went.
+    ##
+    ## @var{prof} is a struct column vector with one element per node, in the
+    ## order they started, and the fields @qcode{'Name'}, @qcode{'Op'},
+    ## @qcode{'Device'}, @qcode{'StartMicros'}, the time the node started since
+    ## the first node started, @qcode{'WallMicros'}, the time it took, and
+    ## @qcode{'OutputBytes'}, the bytes allocated for its outputs.  @var{out}
+    ## is what @code{run} would have returned.
+    ##
+    ## Tracing slows the run down, so the times are best compared with each
+    ## other rather than with those of @code{run}.
+    ##
+    ## @end deftypefn
+    function [prof, out] = profile (this, inputs, values, outputs, varargin)
+
+      if (nargin != 4 && nargin != 6)
+        print_usage ();
       endif
-      ## Resolve every name to an Output, and every value to a Tensor.  The
-      ## Tensors built here are owned locally and released before returning,
-      ## while those handed in by the caller are left alone.
-      in_ptr = zeros (1, numel (inputs), "uint64");
-      val_ptr = zeros (1, numel (values), "uint64");
-      own = false (1, numel (values));
-      out_ptr = zeros (1, numel (outputs), "uint64");
-      unwind_protect
-        for i = 1:numel (inputs)
-          in_ptr(i) = this.resolveOutput (inputs{i}, "TF_Session.run");
-          if (isa (values{i}, "TF_Tensor"))
-            val_ptr(i) = values{i}.Pointer;
-          else
-            val_ptr(i) = tensorflow ("TF_LoadTensor", values{i});
-            own(i) = true;
-          endif
-        endfor
-        for i = 1:numel (outputs)
-          out_ptr(i) = this.resolveOutput (outputs{i}, "TF_Session.run");
-        endfor
-        status = tensorflow ("TF_NewStatus");
-        res = tensorflow ("TF_SessionRun", this.Pointer, uint64 (0), ...
-                          in_ptr, val_ptr, out_ptr, uint64 ([]), ...
-                          uint64 (0), status);
-        __tf_check__ (status, "TF_Session.run");
-        out = cell (1, numel (res));
-        for i = 1:numel (res)
-          out{i} = tensorflow ("TF_SaveTensor", res(i));
-          tensorflow ("TF_DeleteTensor", res(i));
-        endfor
-        if (numel (out) == 1)
-          out = out{1};
+      res = this.runValues ("TF_SessionProfile", "TF_Session.profile", ...
+                            inputs, values, outputs, varargin);
+      prof = res.nodes;
+      ## Nodes whose type the runtime did not record are looked up in the
+      ## Graph, which holds all but those TensorFlow added to it
+      for i = find (cellfun (@isempty, {prof.Op}))
+        oper = tensorflow ("TF_GraphOperationByName", this.Graph.Pointer, ...
+                           prof(i).Name);
+        if (oper != 0)
+          prof(i).Op = tensorflow ("TF_OperationOpType", oper);
         endif
-      unwind_protect_cleanup
-        for i = 1:numel (val_ptr)
-          if (own(i) && val_ptr(i) != 0)
-            tensorflow ("TF_DeleteTensor", val_ptr(i));
-          endif
-        endfor
-        for i = 1:numel (in_ptr)
-          if (in_ptr(i) != 0)
-            tensorflow ("TF_DeleteOutput", in_ptr(i));
-          endif
-        endfor
-        for i = 1:numel (out_ptr)
-          if (out_ptr(i) != 0)
-            tensorflow ("TF_DeleteOutput", out_ptr(i));
-          endif
-        endfor
-      end_unwind_protect
+      endfor
+      out = res.outputs;
+      if (numel (out) == 1)
+        out = out{1};
+      endif
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Session} {@var{h} =} runAsync (@var{obj}, @var{inputs}, @var{values}, @var{outputs})
+    ## @deftypefnx {TF_Session} {@var{h} =} runAsync (@dots{}, @qcode{'Layout'}, @var{layout})
+    ##
+    ## Start executing the Graph in the background and return a
+    ## @code{TF_AsyncRun} to collect the outputs from.
+    ##
+    ## The arguments are those of @code{run}.  The values are converted before
+    ## returning and the Session then runs on a worker thread, leaving Octave
+    ## free to prepare the next input meanwhile.  @code{@var{h}.fetch ()}
+    ## returns what @code{run} would have, once the run has completed.
+    ##
+    ## The Session must not be deleted while a run is pending.
+    ##
+    ## @end deftypefn
+    function h = runAsync (this, inputs, values, outputs, varargin)
+
+      if (nargin != 4 && nargin != 6)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Session.runAsync");
+      h = TF_AsyncRun (this, inputs, values, outputs, varargin{:});
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Session} {@var{runner} =} prepare (@var{obj}, @var{inputs}, @var{outputs})
+    ## @deftypefnx {TF_Session} {@var{runner} =} prepare (@dots{}, @qcode{'Layout'}, @var{layout})
+    ##
+    ## Prepare the Session to be run repeatedly with the same inputs and
+    ## outputs, and return a @code{TF_Runner} doing so.
+    ##
+    ## The names in @var{inputs} and @var{outputs} are resolved once, here,
+    ## rather than on every run, and @code{@var{runner}.run (@var{values})}
+    ## then returns what @code{run (@var{obj}, @var{inputs}, @var{values},
+    ## @var{outputs})} would.  Prefer it when the same operations are run many
+    ## times.
+    ##
+    ## @end deftypefn
+    function runner = prepare (this, inputs, outputs, varargin)
+
+      if (nargin != 3 && nargin != 5)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Session.prepare");
+      runner = TF_Runner (this, inputs, outputs, varargin{:});
+
+    endfunction
+
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Session} {@var{p} =} partialRun (@var{obj}, @var{inputs}, @var{outputs})
+    ## @deftypefnx {TF_Session} {@var{p} =} partialRun (@dots{}, @qcode{'Layout'}, @var{layout})
+    ##
+    ## Set up a partial run feeding @var{inputs} and fetching @var{outputs},
+    ## and return a @code{TF_PartialRun} which feeds and fetches them over
+    ## several calls to its @code{run} method.  The values the Graph computes
+    ## between those calls stay inside TensorFlow.
+    ##
+    ## @end deftypefn
+    function p = partialRun (this, inputs, outputs, varargin)
+
+      if (nargin != 3 && nargin != 5)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Session.partialRun");
+      p = TF_PartialRun (this, inputs, outputs, varargin{:});
 
     endfunction
 
@@ -198,6 +278,34 @@ classdef TF_Session < handle
 
     endfunction
 
+    ## -*- texinfo -*-
+    ## @deftypefn  {TF_Session} {@var{s} =} poolStats (@var{obj})
+    ##
+    ## Return how the buffers of the Tensors fed to the Session were reused, as
+    ## a structure with the fields @qcode{hits}, @qcode{misses}, @qcode{rate},
+    ## @qcode{held} and @qcode{idle}.
+    ##
+    ## The arrays @code{run}, @code{profile}, @code{runAsync} and the
+    ## @code{TF_Runner} objects prepared from the Session copy into a Tensor
+    ## are copied into 64 byte aligned buffers kept by the Session for each
+    ## data type and shape, and reused by the next run feeding the same ones.
+    ## @qcode{hits} and @qcode{misses} count the Tensors fed over a reused and
+    ## over a newly allocated buffer, @qcode{rate} is the fraction of hits, and
+    ## @qcode{held} and @qcode{idle} are the bytes of every buffer of the
+    ## Session and of those not in use.  A @code{TFModel} reports those of its
+    ## @code{Session}.
+    ##
+    ## @end deftypefn
+    function s = poolStats (this)
+
+      if (nargin != 1)
+        print_usage ();
+      endif
+      this.assertValid ("TF_Session.poolStats");
+      s = tensorflow ("TF_SessionPoolStats", this.Pointer);
+
+    endfunction
+
     ## -*- texinfo -*-
     ## @deftypefn  {TF_Session} {} delete (@var{obj})
     ##
@@ -222,28 +330,99 @@ classdef TF_Session < handle
 
   endmethods
 
+  methods (Hidden)
+
+    ## Build an Output from each 'name' or 'name:index' string of the cellstr
+    ## 'names'.  The operations are looked up in a single call, and every name
+    ## is checked before any Output is built.  The caller owns the returned
+    ## pointers.
+    function ptr = resolveOutputs (this, names, caller)
+      idx = zeros (1, numel (names));
+      for i = 1:numel (names)
+        colon = strfind (names{i}, ":");
+        if (! isempty (colon))
+          tail = names{i}(colon(end)+1:end);
+          num = str2double (tail);
+          if (! isnan (num) && num == fix (num) && num >= 0)
+            idx(i) = num;
+            names{i} = names{i}(1:colon(end)-1);
+          endif
+        endif
+      endfor
+      oper = this.Graph.operations (names);
+      for i = 1:numel (names)
+        if (oper(i) == 0)
+          error ("%s: the Graph holds no operation named '%s'.", ...
+                 caller, names{i});
+        endif
+        nout = tensorflow ("TF_OperationNumOutputs", oper(i));
+        if (idx(i) >= double (nout))
+          error ("%s: operation '%s' has %d output(s), index %d requested.", ...
+                 caller, names{i}, double (nout), idx(i));
+        endif
+      endfor
+      ptr = zeros (1, numel (names), "uint64");
+      for i = 1:numel (names)
+        ptr(i) = tensorflow ("TF_NewOutput", oper(i), int32 (idx(i)));
+      endfor
+    endfunction
+
+  endmethods
+
   methods (Access = private)
 
-    ## Build an Output from a 'name' or 'name:index' string.  The caller owns
-    ## the returned pointer.
-    function ptr = resolveOutput (this, name, caller)
-      idx = 0;
-      colon = strfind (name, ":");
-      if (! isempty (colon))
-        tail = name(colon(end)+1:end);
-        num = str2double (tail);
-        if (! isnan (num) && num == fix (num) && num >= 0)
-          idx = num;
-          name = name(1:colon(end)-1);
+    ## Convert the values, execute the Graph and convert the outputs back
+    ## through the OCT interface function 'call', which takes the arguments of
+    ## TF_SessionRunValues
+    function out = runValues (this, call, caller, inputs, values, outputs, ...
+                              options)
+      this.assertValid (caller);
+      layout = "rowmajor";
+      if (! isempty (options))
+        if (! strcmpi (options{1}, "Layout"))
+          error ("%s: unrecognized parameter name '%s'.", caller, ...
+                 num2str (options{1}));
         endif
+        layout = TF_Tensor.checkLayout (options{2}, caller);
       endif
-      oper = this.Graph.operationByName (name, caller);
-      nout = tensorflow ("TF_OperationNumOutputs", oper);
-      if (idx >= double (nout))
-        error ("%s: operation '%s' has %d output(s), index %d requested.", ...
-               caller, name, double (nout), idx);
+      inputs = TF_Session.asCellstr (inputs, "INPUTS", caller);
+      outputs = TF_Session.asCellstr (outputs, "OUTPUTS", caller);
+      if (! iscell (values))
+        values = {values};
+      endif
+      if (numel (values) != numel (inputs))
+        error ("%s: VALUES must have as many elements as INPUTS.", caller);
       endif
-      ptr = tensorflow ("TF_NewOutput", oper, int32 (idx));
+      ## Resolve every name to an Output.  The values are converted, the
+      ## Graph executed and the outputs converted back in a single call,
+      ## which releases every Tensor it builds; Tensors handed in by the
+      ## caller are fed by their pointer and left alone.
+      tensors = false (1, numel (values));
+      for i = 1:numel (values)
+        if (isa (values{i}, "TF_Tensor"))
+          tensors(i) = true;
+          values{i} = values{i}.Pointer;
+        endif
+      endfor
+      in_ptr = zeros (1, numel (inputs), "uint64");
+      out_ptr = zeros (1, numel (outputs), "uint64");
+      unwind_protect
+        in_ptr = this.resolveOutputs (inputs, caller);
+        out_ptr = this.resolveOutputs (outputs, caller);
+        out = tensorflow (call, this.Pointer, in_ptr, values, out_ptr, ...
+                          layout, tensors);
+      unwind_protect_cleanup
+        for i = 1:numel (in_ptr)
+          if (in_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", in_ptr(i));
+          endif
+        endfor
+        for i = 1:numel (out_ptr)
+          if (out_ptr(i) != 0)
+            tensorflow ("TF_DeleteOutput", out_ptr(i));
+          endif
+        endfor
+      end_unwind_protect
     endfunction
 
     function assertValid (this, caller)
@@ -259,22 +438,63 @@ classdef TF_Session < handle
     ## -*- texinfo -*-
     ## @deftypefn  {TF_Session} {@var{obj} =} TF_Session.fromSavedModel (@var{dirname})
     ## @deftypefnx {TF_Session} {@var{obj} =} TF_Session.fromSavedModel (@var{dirname}, @var{tags})
+    ## @deftypefnx {TF_Session} {@var{obj} =} TF_Session.fromSavedModel (@var{dirname}, @var{tags}, @var{config})
     ##
     ## Load a SavedModel from the directory @var{dirname} and return a Session
     ## over the Graph it was exported with.
     ##
     ## @var{tags} identifies the MetaGraphDef to load, either a character vector
     ## or a cellstr vector, and defaults to @qcode{@{'serve'@}}.
+    ## The signatures of the MetaGraphDef are decoded into the
+    ## @qcode{'Signatures'} property.
+    ##
+    ## @var{config} sets the @code{ConfigProto} the Session is created with.
+    ## It is a scalar struct whose fields are named after those of the
+    ## @code{ConfigProto}, encoded by @code{TF_EncodeConfig}, or a
+    ## @code{ConfigProto} already serialized, as a @code{uint8} vector.  It is
+    ## left out when empty.  The supported fields are:
+    ##
+    ## @multitable @columnfractions 0.4 0.6
+    ## @headitem Field @tab Value
+    ## @item @qcode{intra_op_parallelism_threads} @tab threads an operation
+    ## may be split across, 0 letting TensorFlow choose
+    ## @item @qcode{inter_op_parallelism_threads} @tab threads independent
+    ## operations are run on, 0 letting TensorFlow choose
+    ## @item @qcode{use_per_session_threads} @tab true to give the Session a
+    ## thread pool of its own rather than share the one of the process
+    ## @item @qcode{session_inter_op_thread_pool} @tab struct array with the
+    ## fields @qcode{num_threads} and @qcode{global_name}, or a vector of
+    ## thread counts, one per pool
+    ## @item @qcode{allow_soft_placement} @tab true to place an operation on
+    ## another device when its own cannot run it
+    ## @item @qcode{opt_level} @tab @qcode{'L1'}, the default, or @qcode{'L0'}
+    ## to turn off the graph optimizations
+    ## @item @qcode{global_jit_level} @tab @qcode{'DEFAULT'}, @qcode{'OFF'},
+    ## @qcode{'ON_1'} or @qcode{'ON_2'}, for XLA compilation
+    ## @end multitable
+    ##
+    ## For instance, to keep TensorFlow to four cores on a shared host:
+    ##
+    ## @example
+    ## @group
+    ## config = struct ("intra_op_parallelism_threads", 4, ...
+    ##                  "inter_op_parallelism_threads", 1);
+    ## s = TF_Session.fromSavedModel ("path/to/saved_model", "serve", config);
+    ## @end group
+    ## @end example
     ##
     ## @end deftypefn
-    function this = fromSavedModel (dirname, tags)
+    function this = fromSavedModel (dirname, tags, config)
 
-      if (nargin < 1 || nargin > 2)
+      if (nargin < 1 || nargin > 3)
         print_usage ();
       endif
       if (nargin < 2)
         tags = {"serve"};
       endif
+      if (nargin < 3)
+        config = [];
+      endif
       if (! (ischar (dirname) && isrow (dirname)))
         error (["TF_Session.fromSavedModel: DIRNAME must be a character", ...
                 " vector."]);
@@ -283,22 +503,42 @@ classdef TF_Session < handle
         error ("TF_Session.fromSavedModel: '%s' is not a directory.", dirname);
       endif
       tags = TF_Session.asCellstr (tags, "TAGS", "TF_Session.fromSavedModel");
+      if (isstruct (config))
+        config = tensorflow ("TF_EncodeConfig", config);
+      elseif (! isempty (config) ...
+              && ! (isa (config, "uint8") && isvector (config)))
+        error (["TF_Session.fromSavedModel: CONFIG must be a struct or a", ...
+                " uint8 vector holding a serialized ConfigProto."]);
+      endif
       graph = TF_Graph ();
       opts = tensorflow ("TF_NewSessionOptions");
-      status = tensorflow ("TF_NewStatus");
-      ptr = tensorflow ("TF_LoadSessionFromSavedModel", opts, uint64 (0), ...
-                        dirname, tags, graph.Pointer, uint64 (0), status);
-      tensorflow ("TF_DeleteSessionOptions", opts);
-      __tf_check__ (status, "TF_Session.fromSavedModel");
-      this = TF_Session ();
-      this.Pointer = ptr;
-      this.Graph = graph;
+      meta = tensorflow ("TF_NewBuffer");
+      unwind_protect
+        if (! isempty (config))
+          status = tensorflow ("TF_NewStatus");
+          tensorflow ("TF_SetConfig", opts, config(:).', status);
+          __tf_check__ (status, "TF_Session.fromSavedModel");
+        endif
+        status = tensorflow ("TF_NewStatus");
+        ptr = tensorflow ("TF_LoadSessionFromSavedModel", opts, uint64 (0), ...
+                          dirname, tags, graph.Pointer, meta, status);
+        __tf_check__ (status, "TF_Session.fromSavedModel");
+        this = TF_Session ();
+        this.Pointer = ptr;
+        this.Graph = graph;
+        ## Only the signatures are decoded out of the MetaGraphDef, natively,
+        ## rather than walking the operations of the Graph
+        this.Signatures = tensorflow ("TF_SignatureDefs", meta);
+      unwind_protect_cleanup
+        tensorflow ("TF_DeleteSessionOptions", opts);
+        tensorflow ("TF_DeleteBuffer", meta);
+      end_unwind_protect
 
     endfunction
 
   endmethods
 
-  methods (Static, Access = private)
+  methods (Static, Hidden)
 
     ## Accept a character vector or a cellstr vector and return a cellstr row
     function c = asCellstr (val, argname, caller)
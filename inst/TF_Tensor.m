@@ -30,7 +30,9 @@ classdef TF_Tensor < handle
   ## The elements are repositioned on the way in and on the way out, since
   ## Octave stores arrays column major and TensorFlow stores them row major, so
   ## the shape and the element positions are those of the Octave array in both
-  ## directions.
+  ## directions.  In @qcode{'native'} layout they are not: the Tensor takes the
+  ## dimensions of the array in reverse order and the data is copied as it is,
+  ## which suits models exported to take the transposed input.
   ##
   ## @end deftp
 
@@ -43,6 +45,13 @@ classdef TF_Tensor < handle
     ## @end deftp
     Pointer = uint64 (0);
 
+    ## -*- texinfo -*-
+    ## @deftp {TF_Tensor} {property} Layout
+    ## How the Tensor relates to Octave arrays, either @qcode{'rowmajor'} or
+    ## @qcode{'native'}.
+    ## @end deftp
+    Layout = "rowmajor";
+
   endproperties
 
   properties (Access = private)
@@ -56,6 +65,8 @@ classdef TF_Tensor < handle
 
     ## -*- texinfo -*-
     ## @deftypefn  {TF_Tensor} {@var{obj} =} TF_Tensor (@var{data})
+    ## @deftypefnx {TF_Tensor} {@var{obj} =} TF_Tensor (@dots{}, @qcode{'Layout'}, @var{layout})
+    ## @deftypefnx {TF_Tensor} {@var{obj} =} TF_Tensor (@dots{}, @qcode{'DataType'}, @var{type})
     ##
     ## Create a Tensor holding a copy of an Octave array.
     ##
@@ -63,38 +74,86 @@ classdef TF_Tensor < handle
     ## data type supported by TensorFlow.  The values are copied, so @var{data}
     ## may be modified or cleared afterwards without affecting the Tensor.
     ##
+    ## @var{layout} is either @qcode{'rowmajor'}, the default, which keeps the
+    ## shape of @var{data}, or @qcode{'native'}, which reverses its dimensions
+    ## and copies the data with no repositioning.  @code{value} and
+    ## @code{shape} follow the same layout.
+    ##
+    ## @var{type} is the TensorFlow data type of the Tensor, given by its name,
+    ## such as @qcode{'TF_HALF'}, or by its @code{uint32} value.  A
+    ## @code{single} or @code{double} array is converted to @qcode{'TF_HALF'},
+    ## @qcode{'TF_BFLOAT16'}, @qcode{'TF_FLOAT8_E5M2'} or
+    ## @qcode{'TF_FLOAT8_E4M3FN'} while it is copied, and @code{value} returns
+    ## such a Tensor as a @code{single} array.  An integer array is loaded
+    ## into the quantized type of the same width, such as @qcode{'TF_QINT8'}
+    ## for @code{int8}, and an @code{int8} or @code{uint8} array into
+    ## @qcode{'TF_INT4'} or @qcode{'TF_UINT4'}, saturating to 4 bits.  By
+    ## default the Tensor takes the type of @var{data}.
+    ##
     ## Called without arguments it returns an object referring to no Tensor,
     ## which every method rejects.
     ##
     ## @end deftypefn
-    function this = TF_Tensor (data)
+    function this = TF_Tensor (data, varargin)
 
       if (nargin == 0)
         return;
       endif
-      if (nargin != 1)
+      if (mod (nargin, 2) != 1)
         print_usage ();
       endif
       if (isempty (data))
         error ("TF_Tensor: DATA must not be empty.");
       endif
-      this.Pointer = tensorflow ("TF_LoadTensor", data);
+      dtype = uint32 (0);
+      for i = 1:2:numel (varargin)
+        switch (lower (num2str (varargin{i})))
+          case "layout"
+            this.Layout = TF_Tensor.checkLayout (varargin{i+1}, "TF_Tensor");
+          case "datatype"
+            dtype = TF_Tensor.checkDataType (varargin{i+1}, "TF_Tensor");
+          otherwise
+            error ("TF_Tensor: unrecognized parameter name '%s'.", ...
+                   num2str (varargin{i}));
+        endswitch
+      endfor
+      if (dtype == 0)
+        this.Pointer = tensorflow ("TF_LoadTensor", data, this.Layout);
+      else
+        this.Pointer = tensorflow ("TF_LoadTensor", data, this.Layout, dtype);
+      endif
 
     endfunction
 
     ## -*- texinfo -*-
     ## @deftypefn  {TF_Tensor} {@var{data} =} value (@var{obj})
+    ## @deftypefnx {TF_Tensor} {@var{data} =} value (@var{obj}, @var{scale}, @var{zero_point})
     ##
     ## Return the contents of the Tensor as an Octave array.
     ##
+    ## A quantized Tensor is returned as an array of the integer type of the
+    ## same width, or, given its @var{scale} and @var{zero_point}, as a
+    ## @code{single} array of @code{(q - @var{zero_point}) * @var{scale}},
+    ## dequantized while it is copied.
+    ##
     ## @end deftypefn
-    function data = value (this)
+    function data = value (this, scale, zero_point)
 
-      if (nargin != 1)
+      if (nargin != 1 && nargin != 3)
         print_usage ();
       endif
       this.assertValid ("TF_Tensor.value");
-      data = tensorflow ("TF_SaveTensor", this.Pointer);
+      if (nargin == 1)
+        data = tensorflow ("TF_SaveTensor", this.Pointer, this.Layout);
+      else
+        if (! (isnumeric (scale) && isreal (scale) && isscalar (scale) ...
+               && isnumeric (zero_point) && isreal (zero_point) ...
+               && isscalar (zero_point)))
+          error ("TF_Tensor.value: SCALE and ZERO_POINT must be real scalars.");
+        endif
+        data = tensorflow ("TF_SaveTensor", this.Pointer, this.Layout, ...
+                           false, double ([scale, zero_point]));
+      endif
 
     endfunction
 
@@ -106,6 +165,8 @@ classdef TF_Tensor < handle
     ## A Tensor of no dimensions, which holds a single value, reports a size of
     ## @code{[1, 1]}, and a Tensor of one dimension reports @code{[1, N]}, so
     ## that the reported size is always that of the corresponding Octave array.
+    ## In @qcode{'native'} layout the dimensions of a Tensor of two or more are
+    ## reported in reverse order, for the same reason.
     ##
     ## @end deftypefn
     function sz = shape (this)
@@ -124,6 +185,9 @@ classdef TF_Tensor < handle
         for i = 1:nd
           sz(i) = double (tensorflow ("TF_Dim", this.Pointer, int32 (i)));
         endfor
+        if (strcmp (this.Layout, "native"))
+          sz = fliplr (sz);
+        endif
       endif
 
     endfunction
@@ -197,14 +261,54 @@ classdef TF_Tensor < handle
   methods (Static, Hidden)
 
     ## Wrap a Tensor pointer that came from the OCT interface.  OWNED tells
-    ## whether this object becomes responsible for releasing it.
-    function this = fromPointer (ptr, owned)
+    ## whether this object becomes responsible for releasing it, and LAYOUT how
+    ## it is read back.
+    function this = fromPointer (ptr, owned, layout)
       if (nargin < 2)
         owned = true;
       endif
       this = TF_Tensor ();
       this.Pointer = uint64 (ptr);
       this.Owned = logical (owned);
+      if (nargin > 2)
+        this.Layout = TF_Tensor.checkLayout (layout, "TF_Tensor.fromPointer");
+      endif
+    endfunction
+
+    ## Validate a data type, given by name or by value, and return its value
+    function dtype = checkDataType (dtype, caller)
+      if (isnumeric (dtype) && isscalar (dtype) && dtype == fix (dtype) ...
+          && dtype > 0)
+        dtype = uint32 (dtype);
+        if (isempty (tensorflow ("TF_DataTypeName", dtype)))
+          error ("%s: unknown TYPE %d.", caller, dtype);
+        endif
+        return;
+      endif
+      if (! (ischar (dtype) && isrow (dtype)))
+        error ("%s: TYPE must be a data type name or a positive integer.", ...
+               caller);
+      endif
+      name = upper (dtype);
+      if (! strncmp (name, "TF_", 3))
+        name = ["TF_", name];
+      endif
+      for k = uint32 (1:30)
+        if (strcmp (tensorflow ("TF_DataTypeName", k), name))
+          dtype = k;
+          return;
+        endif
+      endfor
+      error ("%s: unknown TYPE '%s'.", caller, dtype);
+    endfunction
+
+    ## Validate a layout name and return it in lower case
+    function layout = checkLayout (layout, caller)
+      if (! (ischar (layout) && isrow (layout)) ...
+          || ! any (strcmpi (layout, {"rowmajor", "native"})))
+        error ("%s: LAYOUT must be either 'rowmajor' or 'native'.", caller);
+      endif
+      layout = lower (layout);
     endfunction
 
   endmethods
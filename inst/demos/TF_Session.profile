@@ -0,0 +1,19 @@
+%!demo
+%! ## `profile` runs the graph as `run` does and returns, for every node it
+%! ## executed, when it started and how long it took, in microseconds.  Sorting
+%! ## by the time taken shows where a slow model spends it.
+%!
+%! sess = TF_Session.fromSavedModel (__tf_test_model__ ());
+%! x = single ([1, 2, 3]);
+%! prof = sess.profile ("serving_default_x", x, "StatefulPartitionedCall");
+%! [~, k] = sort ([prof.WallMicros], "descend");
+%! slowest = [{prof(k).Name}; {prof(k).Op}; {prof(k).WallMicros}]'
+
+%!demo
+%! ## The outputs are returned as the second output, the same as `run` would
+%! ## return them, along with the bytes allocated for the outputs of each node.
+%!
+%! sess = TF_Session.fromSavedModel (__tf_test_model__ ());
+%! [prof, y] = sess.profile ("serving_default_x", single ([1, 1, 1]), ...
+%!                           "StatefulPartitionedCall")
+%! total_bytes = sum ([prof.OutputBytes])
@@ -23,24 +23,11 @@ this program; if not, see <http://www.gnu.org/licenses/>.
 // OCTAVE specific functions referenced by the TF_Tensor classdef
 // -----------------------------------------------------------------------------
 
-// charMatrix TF_DataTypeName(TF_DataType dt);
-octave_value OCT_TF_DataTypeName (OCT_ARGS)
+// Name of the TF_DataType 'dt', or an empty string for an unknown one
+string data_type_name (TF_DataType dt)
 {
-  if (nrhs < 2)
-  {
-    error ("tensorflow: one extra argument is required "
-           "for the 'TF_DataTypeName' OCTAVE function.");
-  }
-  // Check octave_value type for DataType
-  if (! args(1).is_uint32_type () || ! args(1).is_scalar_type ())
-  {
-    error ("tensorflow: 2nd argument must be an uint32 scalar "
-           "indexing the appropriate TF_DataType to be parsed to "
-           "the 'TF_DataTypeName' OCTAVE function.");
-  }
-  // Get DataType id as uint32 value and return char string
   string dtype;
-  switch (args(1).uint_value ())
+  switch (dt)
   {
     case 1: dtype  = "TF_FLOAT"; break;
     case 2: dtype  = "TF_DOUBLE"; break;
@@ -70,6 +57,26 @@ octave_value OCT_TF_DataTypeName (OCT_ARGS)
     case 29: dtype = "TF_INT4"; break;
     case 30: dtype = "TF_UINT4"; break;
   }
+  return dtype;
+}
+
+// charMatrix TF_DataTypeName(TF_DataType dt);
+octave_value OCT_TF_DataTypeName (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_DataTypeName' OCTAVE function.");
+  }
+  // Check octave_value type for DataType
+  if (! args(1).is_uint32_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint32 scalar "
+           "indexing the appropriate TF_DataType to be parsed to "
+           "the 'TF_DataTypeName' OCTAVE function.");
+  }
+  // Get DataType id as uint32 value and return char string
+  string dtype = data_type_name ((TF_DataType) args(1).uint_value ());
   charMatrix dt_str = dtype.c_str ();
   octave_value plhs = dt_str;
   return plhs;
@@ -17,6 +17,10 @@ You should have received a copy of the GNU General Public License along with
 this program; if not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "tensorflow.h"
@@ -25,6 +29,42 @@ this program; if not, see <http://www.gnu.org/licenses/>.
 // C API functions referenced by the TF_Graph classdef
 // -----------------------------------------------------------------------------
 
+// Operations are looked up by name in an index built for each Graph on its
+// first lookup.  Every function of the package adding operations to a Graph
+// calls graph_changed, which makes each index be rebuilt on its next lookup,
+// and TF_DeleteGraph drops the index of its Graph, whose address may be
+// reused by the next one.
+struct graph_index
+{
+  uint64_t generation = UINT64_MAX;
+  std::unordered_map<string, TF_Operation*> opers;
+};
+static std::unordered_map<TF_Graph*, graph_index> graph_indexes;
+static uint64_t graph_generation = 0;
+
+void graph_changed (void)
+{
+  graph_generation++;
+}
+
+// The index of a Graph, built or rebuilt if needed
+static const graph_index& index_graph (TF_Graph* graph)
+{
+  graph_index& index = graph_indexes[graph];
+  if (index.generation != graph_generation)
+  {
+    index.opers.clear ();
+    size_t op_pos = 0;
+    TF_Operation* oper;
+    while ((oper = TF_GraphNextOperation (graph, &op_pos)) != nullptr)
+    {
+      index.opers.emplace (TF_OperationName (oper), oper);
+    }
+    index.generation = graph_generation;
+  }
+  return index;
+}
+
 // TF_CAPI_EXPORT extern TF_Graph* TF_NewGraph(void);
 octave_value OCT_TF_NewGraph (void)
 {
@@ -50,6 +90,7 @@ void OCT_TF_DeleteGraph (OCT_ARGS)
   }
   // Get pointer to Graph
   TF_Graph* graph = (TF_Graph*) args(1).uint64_value ();
+  graph_indexes.erase (graph);
   TF_DeleteGraph (graph);
 }
 
@@ -325,6 +366,56 @@ octave_value OCT_TF_GraphOperationByName (OCT_ARGS)
   return plhs;
 }
 
+// uint64NDArray TF_GraphOperationsByName(TF_Graph* graph,
+//                                        cellstr names);   // OCTAVE specific
+//
+// Return the pointer to the Operation of each name, 0 for a name the Graph
+// holds no Operation of, in an array of the size of 'names'.  The names are
+// looked up in an index of the Graph, built once and kept until operations
+// are added to it, so that many names cost one call and a hash lookup each.
+octave_value OCT_TF_GraphOperationsByName (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_GraphOperationsByName' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Graph
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Graph parsed to the 'TF_GraphOperationsByName' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for Operation names
+  if (! (args(2).is_string () && args(2).rows () == 1) && ! args(2).iscellstr ())
+  {
+    error ("tensorflow: 3rd argument must be a character vector or a cellstr "
+           "array of operation names parsed to the 'TF_GraphOperationsByName' "
+           "OCTAVE function.");
+  }
+  // Get pointer to Graph
+  TF_Graph* graph = (TF_Graph*) args(1).uint64_value ();
+  Array<string> names;
+  if (args(2).is_string ())
+  {
+    names = Array<string> (dim_vector (1, 1), args(2).string_value ());
+  }
+  else
+  {
+    names = args(2).cellstr_value ();
+  }
+  const graph_index& index = index_graph (graph);
+  uint64NDArray out (names.dims ());
+  for (octave_idx_type i = 0; i < names.numel (); i++)
+  {
+    auto it = index.opers.find (names(i));
+    out(i) = it == index.opers.end () ? 0 : (uint64_t) it->second;
+  }
+  octave_value plhs = out;
+  return plhs;
+}
+
 // TF_CAPI_EXPORT extern TF_Operation* TF_GraphNextOperation(TF_Graph* graph,
 //                                                           size_t* pos);
 octave_value OCT_TF_GraphNextOperation (OCT_ARGS)
@@ -404,6 +495,445 @@ octave_value OCT_TF_GraphOperations (OCT_ARGS)
   return plhs;
 }
 
+// struct TF_GraphOperationTable(TF_Graph* graph);   // OCTAVE specific
+//
+// Describe every Operation of the Graph in a single pass, as a scalar struct
+// of column vectors, one row per Operation in the order TF_GraphNextOperation
+// walks them: its Pointer, Name, OpType and Device, its NumInputs and
+// NumOutputs, and its OutputTypes, a uint32 row vector of the data type of
+// each output.
+octave_value OCT_TF_GraphOperationTable (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_GraphOperationTable' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Graph
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Graph parsed to the 'TF_GraphOperationTable' OCTAVE "
+           "function.");
+  }
+  // Get pointer to Graph
+  TF_Graph* graph = (TF_Graph*) args(1).uint64_value ();
+  // Collect the pointer to every Operation in the Graph
+  std::vector<TF_Operation*> opers;
+  size_t op_pos = 0;
+  TF_Operation* oper;
+  while ((oper = TF_GraphNextOperation (graph, &op_pos)) != nullptr)
+  {
+    opers.push_back (oper);
+  }
+  octave_idx_type n = (octave_idx_type) opers.size ();
+  uint64NDArray pointer (dim_vector (n, 1));
+  Cell name (dim_vector (n, 1));
+  Cell op_type (dim_vector (n, 1));
+  Cell device (dim_vector (n, 1));
+  int32NDArray num_inputs (dim_vector (n, 1));
+  int32NDArray num_outputs (dim_vector (n, 1));
+  Cell output_types (dim_vector (n, 1));
+  for (octave_idx_type i = 0; i < n; i++)
+  {
+    oper = opers[i];
+    pointer(i) = (uint64_t) oper;
+    name(i) = TF_OperationName (oper);
+    op_type(i) = TF_OperationOpType (oper);
+    device(i) = TF_OperationDevice (oper);
+    num_inputs(i) = TF_OperationNumInputs (oper);
+    int nout = TF_OperationNumOutputs (oper);
+    num_outputs(i) = nout;
+    uint32NDArray types (dim_vector (1, nout));
+    for (int k = 0; k < nout; k++)
+    {
+      types(k) = (uint32_t) TF_OperationOutputType ({oper, k});
+    }
+    output_types(i) = types;
+  }
+  octave_scalar_map table;
+  table.assign ("Pointer", pointer);
+  table.assign ("Name", name);
+  table.assign ("OpType", op_type);
+  table.assign ("Device", device);
+  table.assign ("NumInputs", num_inputs);
+  table.assign ("NumOutputs", num_outputs);
+  table.assign ("OutputTypes", output_types);
+  octave_value plhs = table;
+  return plhs;
+}
+
+// struct TF_GraphAdjacency(TF_Graph* graph, bool sparse);   // OCTAVE specific
+//
+// Return every edge of the Graph in a single pass, as a scalar struct holding
+// the Pointer to each Operation, in the order TF_GraphNextOperation walks
+// them, and the edges between them referred to by their row in Pointer.  Data
+// is an m-by-4 matrix of the source row, its output index, the target row
+// and its input index, and Control a k-by-2 matrix of the source and target
+// rows.  When sparse is true, Adjacency is added, an n-by-n sparse matrix
+// counting the edges of both kinds from each Operation to each other.
+octave_value OCT_TF_GraphAdjacency (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_GraphAdjacency' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Graph
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Graph parsed to the 'TF_GraphAdjacency' OCTAVE function.");
+  }
+  // Check octave_value type for the sparse flag
+  bool sparse = false;
+  if (nrhs > 2)
+  {
+    if (! args(2).is_bool_scalar ())
+    {
+      error ("tensorflow: 3rd argument must be a logical scalar requesting "
+             "the sparse matrix parsed to the 'TF_GraphAdjacency' OCTAVE "
+             "function.");
+    }
+    sparse = args(2).bool_value ();
+  }
+  // Get pointer to Graph
+  TF_Graph* graph = (TF_Graph*) args(1).uint64_value ();
+  // Number every Operation in the Graph by its row
+  std::vector<TF_Operation*> opers;
+  std::unordered_map<TF_Operation*, octave_idx_type> rows;
+  size_t op_pos = 0;
+  TF_Operation* oper;
+  while ((oper = TF_GraphNextOperation (graph, &op_pos)) != nullptr)
+  {
+    rows.emplace (oper, (octave_idx_type) opers.size ());
+    opers.push_back (oper);
+  }
+  // Gather the data and control inputs of every Operation
+  std::vector<octave_idx_type> data_src, data_out, data_dst, data_in;
+  std::vector<octave_idx_type> ctrl_src, ctrl_dst;
+  std::vector<TF_Output> inputs;
+  std::vector<TF_Operation*> controls;
+  for (size_t i = 0; i < opers.size (); i++)
+  {
+    oper = opers[i];
+    int num_inputs = TF_OperationNumInputs (oper);
+    inputs.resize (num_inputs);
+    if (num_inputs > 0)
+    {
+      TF_OperationAllInputs (oper, inputs.data (), num_inputs);
+    }
+    for (int k = 0; k < num_inputs; k++)
+    {
+      auto it = rows.find (inputs[k].oper);
+      if (it == rows.end ()) {continue;}
+      data_src.push_back (it->second);
+      data_out.push_back (inputs[k].index);
+      data_dst.push_back (i);
+      data_in.push_back (k);
+    }
+    int num_controls = TF_OperationNumControlInputs (oper);
+    controls.resize (num_controls);
+    if (num_controls > 0)
+    {
+      TF_OperationGetControlInputs (oper, controls.data (), num_controls);
+    }
+    for (int k = 0; k < num_controls; k++)
+    {
+      auto it = rows.find (controls[k]);
+      if (it == rows.end ()) {continue;}
+      ctrl_src.push_back (it->second);
+      ctrl_dst.push_back (i);
+    }
+  }
+  octave_idx_type n = (octave_idx_type) opers.size ();
+  octave_idx_type m = (octave_idx_type) data_src.size ();
+  octave_idx_type k = (octave_idx_type) ctrl_src.size ();
+  uint64NDArray pointer (dim_vector (n, 1));
+  for (octave_idx_type i = 0; i < n; i++) {pointer(i) = (uint64_t) opers[i];}
+  // Rows are returned one based, indices zero based as in a TF_Output
+  NDArray data (dim_vector (m, 4));
+  for (octave_idx_type e = 0; e < m; e++)
+  {
+    data(e, 0) = data_src[e] + 1;
+    data(e, 1) = data_out[e];
+    data(e, 2) = data_dst[e] + 1;
+    data(e, 3) = data_in[e];
+  }
+  NDArray control (dim_vector (k, 2));
+  for (octave_idx_type e = 0; e < k; e++)
+  {
+    control(e, 0) = ctrl_src[e] + 1;
+    control(e, 1) = ctrl_dst[e] + 1;
+  }
+  octave_scalar_map adjacency;
+  adjacency.assign ("Pointer", pointer);
+  adjacency.assign ("Data", data);
+  adjacency.assign ("Control", control);
+  if (sparse)
+  {
+    // Duplicate edges are summed into a count by the sparse constructor
+    Array<octave_idx_type> src (dim_vector (m + k, 1));
+    Array<octave_idx_type> dst (dim_vector (m + k, 1));
+    for (octave_idx_type e = 0; e < m; e++)
+    {
+      src(e) = data_src[e];
+      dst(e) = data_dst[e];
+    }
+    for (octave_idx_type e = 0; e < k; e++)
+    {
+      src(m + e) = ctrl_src[e];
+      dst(m + e) = ctrl_dst[e];
+    }
+    Array<double> ones (dim_vector (m + k, 1), 1.0);
+    SparseMatrix adj (ones, octave::idx_vector (src),
+                      octave::idx_vector (dst), n, n, true);
+    adjacency.assign ("Adjacency", adj);
+  }
+  octave_value plhs = adjacency;
+  return plhs;
+}
+
+// Strip the output index of a 'name:index' tensor name, and the caret of a
+// '^name' control input, leaving the name of the operation
+static string prune_name (const string& name)
+{
+  size_t begin = ! name.empty () && name[0] == '^' ? 1 : 0;
+  size_t colon = name.rfind (':');
+  if (colon != string::npos && colon > begin && colon + 1 < name.size ()
+      && name.find_first_not_of ("0123456789", colon + 1) == string::npos)
+  {
+    return name.substr (begin, colon - begin);
+  }
+  return name.substr (begin);
+}
+
+// Encode a NodeDef of a Placeholder standing in for the fed Operation 'oper',
+// with the data type and, when it is known, the shape of its output
+static string prune_placeholder (TF_Graph* graph, TF_Operation* oper,
+                                 TF_Status* status)
+{
+  TF_Output output = {oper, 0};
+  string dtype;
+  put_field (dtype, 6, (int64_t) TF_OperationOutputType (output));
+  string entry;
+  put_field (entry, 1, string ("dtype"));
+  put_field (entry, 2, dtype);
+  string node;
+  put_field (node, 1, string (TF_OperationName (oper)));
+  put_field (node, 2, string ("Placeholder"));
+  put_field (node, 5, entry);
+  int num_dims = TF_GraphGetTensorNumDims (graph, output, status);
+  if (TF_GetCode (status) == TF_OK && num_dims >= 0)
+  {
+    std::vector<int64_t> dims (num_dims);
+    TF_GraphGetTensorShape (graph, output, dims.data (), num_dims, status);
+    if (TF_GetCode (status) == TF_OK)
+    {
+      // TensorShapeProto: a dim, holding its size, per dimension
+      string shape_proto;
+      for (int k = 0; k < num_dims; k++)
+      {
+        string dim;
+        put_field (dim, 1, dims[k]);
+        put_field (shape_proto, 2, dim);
+      }
+      string shape;
+      put_field (shape, 7, shape_proto);
+      entry.clear ();
+      put_field (entry, 1, string ("shape"));
+      put_field (entry, 2, shape);
+      put_field (node, 5, entry);
+    }
+  }
+  return node;
+}
+
+// uint64 TF_GraphPrune(TF_Graph* graph, cellstr fetches,
+//                      cellstr feeds);   // OCTAVE specific
+//
+// Return a new Graph holding only the Operations the fetches depend on,
+// through their data and control inputs, the walk stopping at the feeds.  The
+// GraphDef of the Graph is exported with TF_GraphToGraphDef, the NodeDefs
+// outside the fan-in of the fetches are dropped from it, along with the
+// inputs of the feeds, each fed Operation being replaced with a Placeholder
+// unless it is one, and the rest is imported into a new Graph with
+// TF_GraphImportGraphDef.  Fields other than the nodes, such as the function
+// library, are kept whole.  The caller owns the new Graph.
+octave_value OCT_TF_GraphPrune (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_GraphPrune' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Graph
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Graph parsed to the 'TF_GraphPrune' OCTAVE function.");
+  }
+  // Check octave_value type for the fetched Operation names
+  if (! (args(2).is_string () && args(2).rows () == 1) && ! args(2).iscellstr ())
+  {
+    error ("tensorflow: 3rd argument must be a character vector or a cellstr "
+           "array of fetched operation names parsed to the 'TF_GraphPrune' "
+           "OCTAVE function.");
+  }
+  // Check octave_value type for the fed Operation names
+  if (nrhs > 3 && ! args(3).iscellstr ())
+  {
+    error ("tensorflow: 4th argument must be a cellstr array of fed "
+           "operation names parsed to the 'TF_GraphPrune' OCTAVE function.");
+  }
+  // Get pointer to Graph
+  TF_Graph* graph = (TF_Graph*) args(1).uint64_value ();
+  Array<string> fetches;
+  if (args(2).is_string ())
+  {
+    fetches = Array<string> (dim_vector (1, 1), args(2).string_value ());
+  }
+  else
+  {
+    fetches = args(2).cellstr_value ();
+  }
+  Array<string> fed_names;
+  if (nrhs > 3) {fed_names = args(3).cellstr_value ();}
+  std::unordered_set<string> feeds;
+  for (octave_idx_type i = 0; i < fed_names.numel (); i++)
+  {
+    feeds.insert (prune_name (fed_names(i)));
+  }
+  // Everything allocated is released with the function, whichever way it is
+  // left
+  unique_ptr<TF_Status, decltype (&TF_DeleteStatus)>
+    status (TF_NewStatus (), &TF_DeleteStatus);
+  unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+    graph_def (TF_NewBuffer (), &TF_DeleteBuffer);
+  TF_GraphToGraphDef (graph, graph_def.get (), status.get ());
+  if (TF_GetCode (status.get ()) != TF_OK)
+  {
+    error ("tensorflow: %s", TF_Message (status.get ()));
+  }
+  // Index the NodeDefs of the GraphDef by name, keeping the rest of it
+  struct node_def
+  {
+    string bytes;
+    string op;
+    std::vector<string> inputs;
+  };
+  std::vector<node_def> nodes;
+  std::unordered_map<string, size_t> by_name;
+  string rest;
+  pb_reader def (graph_def->data, graph_def->length);
+  while (def.next ())
+  {
+    if (def.field != 1 || def.wire != 2)
+    {
+      if (def.wire == 0) {put_field (rest, def.field, (int64_t) def.value);}
+      else if (def.wire == 2) {put_field (rest, def.field, def.str ());}
+      continue;
+    }
+    node_def node;
+    node.bytes = def.str ();
+    string name;
+    pb_reader field = def.message ();
+    while (field.next ())
+    {
+      if (field.wire != 2) {continue;}
+      if (field.field == 1) {name = field.str ();}
+      else if (field.field == 2) {node.op = field.str ();}
+      else if (field.field == 3) {node.inputs.push_back (field.str ());}
+    }
+    by_name.emplace (name, nodes.size ());
+    nodes.push_back (std::move (node));
+  }
+  if (def.malformed)
+  {
+    error ("tensorflow: the GraphDef exported by the Graph parsed to the "
+           "'TF_GraphPrune' OCTAVE function is malformed.");
+  }
+  // Every feed must name an Operation of the Graph, as every fetch must
+  for (octave_idx_type i = 0; i < fed_names.numel (); i++)
+  {
+    string name = prune_name (fed_names(i));
+    if (! by_name.count (name))
+    {
+      error ("tensorflow: the Graph holds no operation named '%s' parsed to "
+             "the 'TF_GraphPrune' OCTAVE function.", name.c_str ());
+    }
+  }
+  // Walk the fan-in of the fetches, stopping at the feeds
+  std::vector<bool> kept (nodes.size (), false);
+  std::deque<string> pending;
+  for (octave_idx_type i = 0; i < fetches.numel (); i++)
+  {
+    pending.push_back (prune_name (fetches(i)));
+  }
+  while (! pending.empty ())
+  {
+    string name = pending.front ();
+    pending.pop_front ();
+    auto it = by_name.find (name);
+    if (it == by_name.end ())
+    {
+      error ("tensorflow: the Graph holds no operation named '%s' parsed to "
+             "the 'TF_GraphPrune' OCTAVE function.", name.c_str ());
+    }
+    if (kept[it->second]) {continue;}
+    kept[it->second] = true;
+    if (feeds.count (name)) {continue;}
+    for (const string& input : nodes[it->second].inputs)
+    {
+      pending.push_back (prune_name (input));
+    }
+  }
+  // Stand a Placeholder in for every fed Operation that is not one
+  for (const auto& entry : by_name)
+  {
+    size_t i = entry.second;
+    if (! kept[i]) {continue;}
+    if (feeds.count (entry.first) && nodes[i].op != "Placeholder")
+    {
+      TF_Operation* oper = TF_GraphOperationByName (graph,
+                                                    entry.first.c_str ());
+      if (TF_OperationNumOutputs (oper) != 1)
+      {
+        error ("tensorflow: fed operation '%s' must have a single output "
+               "to be parsed to the 'TF_GraphPrune' OCTAVE function.",
+               entry.first.c_str ());
+      }
+      nodes[i].bytes = prune_placeholder (graph, oper, status.get ());
+    }
+  }
+  // Encode the GraphDef of the kept NodeDefs, in their original order
+  string pruned;
+  for (size_t i = 0; i < nodes.size (); i++)
+  {
+    if (kept[i]) {put_field (pruned, 1, nodes[i].bytes);}
+  }
+  pruned += rest;
+  // Import the pruned GraphDef into a new Graph
+  unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+    buffer (TF_NewBufferFromString (pruned.data (), pruned.size ()),
+            &TF_DeleteBuffer);
+  unique_ptr<TF_ImportGraphDefOptions,
+             decltype (&TF_DeleteImportGraphDefOptions)>
+    opts (TF_NewImportGraphDefOptions (), &TF_DeleteImportGraphDefOptions);
+  TF_Graph* new_graph = TF_NewGraph ();
+  TF_GraphImportGraphDef (new_graph, buffer.get (), opts.get (),
+                          status.get ());
+  if (TF_GetCode (status.get ()) != TF_OK)
+  {
+    TF_DeleteGraph (new_graph);
+    error ("tensorflow: %s", TF_Message (status.get ()));
+  }
+  graph_changed ();
+  octave_uint64 ptr = (uint64_t) new_graph;
+  octave_value plhs = ptr;
+  return plhs;
+}
+
 // TF_CAPI_EXPORT extern void TF_GraphToGraphDef(TF_Graph* graph,
 //                                               TF_Buffer* output_graph_def,
 //                                               TF_Status* status);
@@ -578,6 +1108,7 @@ octave_value OCT_TF_GraphImportGraphDefWithResults (OCT_ARGS)
   // Get ImportGraphDefResults and return its pointer
   TF_ImportGraphDefResults* graph_def_res = TF_GraphImportGraphDefWithResults (
                                             graph, graph_def, options, status);
+  graph_changed ();
   octave_uint64 gdr_ptr = (uint64_t) graph_def_res;
   octave_value plhs = gdr_ptr;
   return plhs;
@@ -654,6 +1185,7 @@ void OCT_TF_GraphImportGraphDefWithReturnOutputs (OCT_ARGS)
   // Import Graph definition with return Output(s)
   TF_GraphImportGraphDefWithReturnOutputs (graph, graph_def, options, output,
                                            num_return_outputs, status);
+  graph_changed ();
 }
 
 // TF_CAPI_EXPORT extern void TF_GraphImportGraphDef(TF_Graph* graph,
@@ -703,6 +1235,7 @@ void OCT_TF_GraphImportGraphDef (OCT_ARGS)
   TF_Status* status = (TF_Status*) args(4).uint64_value ();
   // Import Graph definitions
   TF_GraphImportGraphDef (graph, graph_def, options, status);
+  graph_changed ();
 }
 
 // TF_CAPI_EXPORT extern void TF_GraphCopyFunction(TF_Graph* g,
@@ -862,6 +1395,7 @@ octave_value OCT_TF_NewWhile (OCT_ARGS)
   TF_Status* status = (TF_Status*) args(4).uint64_value ();
   // Get WhileParams and return its pointer
   TF_WhileParams wp = TF_NewWhile (graph, inputs, ninputs, status);
+  graph_changed ();
   TF_WhileParams* ret_wp = &wp;
   octave_uint64 wp_ptr = (uint64_t) ret_wp;
   octave_value plhs = wp_ptr;
@@ -946,6 +1480,7 @@ void OCT_TF_AddGradients (OCT_ARGS)
   TF_Output* dy = (TF_Output*) args(8).uint64_value ();
   // Add Gradient
   TF_AddGradients (graph, y, ny, x, nx, dx, status, dy);
+  graph_changed ();
 }
 
 // TF_CAPI_EXPORT void TF_AddGradientsWithPrefix(TF_Graph* g, const char* prefix,
@@ -1036,6 +1571,7 @@ void OCT_TF_AddGradientsWithPrefix (OCT_ARGS)
   TF_Output* dy = (TF_Output*) args(9).uint64_value ();
   // Add Gradient
   TF_AddGradientsWithPrefix (graph, prefix.c_str (), y, ny, x, nx, dx, status, dy);
+  graph_changed ();
 }
 
 // TF_CAPI_EXPORT extern TF_Function* TF_GraphToFunction(const TF_Graph* fn_body,
@@ -1094,6 +1094,7 @@ octave_value OCT_TF_FinishOperationLocked (OCT_ARGS)
   TF_Status* status = (TF_Status*) args(2).uint64_value ();
   // Get Operation and return its pointer
   TF_Operation* oper = TF_FinishOperationLocked (desc, status);
+  graph_changed ();
   octave_uint64 ptr = (uint64_t) oper;
   octave_value plhs = ptr;
   return plhs;
@@ -1127,6 +1128,7 @@ octave_value OCT_TF_FinishOperation (OCT_ARGS)
   TF_Status* status = (TF_Status*) args(2).uint64_value ();
   // Get Operation and return its pointer
   TF_Operation* oper = TF_FinishOperation (desc, status);
+  graph_changed ();
   octave_uint64 ptr = (uint64_t) oper;
   octave_value plhs = ptr;
   return plhs;
@@ -17,6 +17,17 @@ You should have received a copy of the GNU General Public License along with
 this program; if not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "tensorflow.h"
@@ -124,6 +135,222 @@ void OCT_TF_DeleteSessionOptions (OCT_ARGS)
   TF_DeleteSessionOptions (options);
 }
 
+// Read an integer field of a ConfigProto between 'lo' and 'hi'
+static int64_t config_int (const octave_value& val, const string& name,
+                           int64_t lo, int64_t hi)
+{
+  double d = val.is_real_scalar () ? val.double_value () : -HUGE_VAL;
+  if (d != std::floor (d) || d < (double) lo || d > (double) hi)
+  {
+    error ("tensorflow: field '%s' of the ConfigProto must be an integer "
+           "between %" PRId64 " and %" PRId64 " parsed to the "
+           "'TF_EncodeConfig' OCTAVE function.", name.c_str (), lo, hi);
+  }
+  return (int64_t) d;
+}
+
+// Read a boolean field of a ConfigProto
+static bool config_bool (const octave_value& val, const string& name)
+{
+  if (! val.is_real_scalar ()
+      || (val.double_value () != 0 && val.double_value () != 1))
+  {
+    error ("tensorflow: field '%s' of the ConfigProto must be a logical "
+           "scalar parsed to the 'TF_EncodeConfig' OCTAVE function.",
+           name.c_str ());
+  }
+  return val.double_value () != 0;
+}
+
+// Read an enum field of a ConfigProto, given either by the name of one of
+// its 'n' values or by the number of one
+static int64_t config_enum (const octave_value& val, const string& name,
+                            const char* const* labels, const int* values,
+                            int n)
+{
+  if (val.is_string ())
+  {
+    string label = val.string_value ();
+    transform (label.begin (), label.end (), label.begin (), ::toupper);
+    for (int i = 0; i < n; i++)
+    {
+      if (label == labels[i]) {return values[i];}
+    }
+  }
+  else if (val.is_real_scalar ())
+  {
+    for (int i = 0; i < n; i++)
+    {
+      if (val.double_value () == values[i]) {return values[i];}
+    }
+  }
+  string valid;
+  for (int i = 0; i < n; i++)
+  {
+    valid += (i == 0 ? "'" : i == n - 1 ? " or '" : ", '");
+    valid += labels[i];
+    valid += "'";
+  }
+  error ("tensorflow: field '%s' of the ConfigProto must be %s parsed to "
+         "the 'TF_EncodeConfig' OCTAVE function.", name.c_str (),
+         valid.c_str ());
+}
+
+// uint8 TF_EncodeConfig(struct config)
+//
+// Serialize the fields of a ConfigProto that govern how a Session uses the
+// machine, given as a scalar struct named after them, for TF_SetConfig.
+// Fields left out keep the defaults of TensorFlow.
+octave_value OCT_TF_EncodeConfig (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_EncodeConfig' OCTAVE function.");
+  }
+  // Check octave_value type for struct of ConfigProto fields
+  if (! args(1).isstruct () || args(1).numel () != 1)
+  {
+    error ("tensorflow: 2nd argument must be a scalar struct defining the "
+           "fields of the ConfigProto parsed to the 'TF_EncodeConfig' OCTAVE "
+           "function.");
+  }
+  octave_scalar_map config = args(1).scalar_map_value ();
+  static const char* const fields[] =
+  {
+    "intra_op_parallelism_threads", "inter_op_parallelism_threads",
+    "use_per_session_threads", "session_inter_op_thread_pool",
+    "allow_soft_placement", "opt_level", "global_jit_level"
+  };
+  string_vector names = config.fieldnames ();
+  for (octave_idx_type i = 0; i < names.numel (); i++)
+  {
+    if (find (begin (fields), end (fields), names(i)) == end (fields))
+    {
+      error ("tensorflow: '%s' is not a field of the ConfigProto known to "
+             "the 'TF_EncodeConfig' OCTAVE function.", names(i).c_str ());
+    }
+  }
+  const int64_t int32_max = numeric_limits<int32_t>::max ();
+  // Encode the fields in the order of their numbers
+  string proto;
+  if (config.isfield ("intra_op_parallelism_threads"))
+  {
+    put_field (proto, 2, config_int (config.contents
+                                     ("intra_op_parallelism_threads"),
+                                     "intra_op_parallelism_threads",
+                                     0, int32_max));
+  }
+  if (config.isfield ("inter_op_parallelism_threads"))
+  {
+    put_field (proto, 5, config_int (config.contents
+                                     ("inter_op_parallelism_threads"),
+                                     "inter_op_parallelism_threads",
+                                     0, int32_max));
+  }
+  if (config.isfield ("allow_soft_placement"))
+  {
+    put_field (proto, 7, config_bool (config.contents
+                                      ("allow_soft_placement"),
+                                      "allow_soft_placement"));
+  }
+  if (config.isfield ("use_per_session_threads"))
+  {
+    put_field (proto, 9, config_bool (config.contents
+                                      ("use_per_session_threads"),
+                                      "use_per_session_threads"));
+  }
+  // GraphOptions, holding the OptimizerOptions and their fields
+  string optimizer;
+  if (config.isfield ("opt_level"))
+  {
+    static const char* const labels[] = {"L1", "L0"};
+    static const int values[] = {0, -1};
+    put_field (optimizer, 3, config_enum (config.contents ("opt_level"),
+                                          "opt_level", labels, values, 2));
+  }
+  if (config.isfield ("global_jit_level"))
+  {
+    static const char* const labels[] = {"DEFAULT", "OFF", "ON_1", "ON_2"};
+    static const int values[] = {0, -1, 1, 2};
+    put_field (optimizer, 5, config_enum (config.contents
+                                          ("global_jit_level"),
+                                          "global_jit_level",
+                                          labels, values, 4));
+  }
+  if (! optimizer.empty ())
+  {
+    string graph;
+    put_field (graph, 3, optimizer);
+    put_field (proto, 10, graph);
+  }
+  // ThreadPoolOptionProto, one per inter-op pool, given as a struct array
+  // or as a vector of thread counts
+  if (config.isfield ("session_inter_op_thread_pool"))
+  {
+    octave_value pools = config.contents ("session_inter_op_thread_pool");
+    const char* name = "session_inter_op_thread_pool";
+    if (pools.isstruct ())
+    {
+      octave_map map = pools.map_value ();
+      for (octave_idx_type i = 0; i < map.numel (); i++)
+      {
+        octave_scalar_map pool = map.checkelem (i);
+        string_vector keys = pool.fieldnames ();
+        for (octave_idx_type k = 0; k < keys.numel (); k++)
+        {
+          if (keys(k) != "num_threads" && keys(k) != "global_name")
+          {
+            error ("tensorflow: '%s' is not a field of the "
+                   "session_inter_op_thread_pool of the ConfigProto known to "
+                   "the 'TF_EncodeConfig' OCTAVE function.",
+                   keys(k).c_str ());
+          }
+        }
+        string option;
+        if (pool.isfield ("num_threads"))
+        {
+          put_field (option, 1, config_int (pool.contents ("num_threads"),
+                                            "num_threads", 0, int32_max));
+        }
+        if (pool.isfield ("global_name"))
+        {
+          octave_value global = pool.contents ("global_name");
+          if (! global.is_string () || global.rows () > 1)
+          {
+            error ("tensorflow: field 'global_name' of the ConfigProto must "
+                   "be a character vector parsed to the 'TF_EncodeConfig' "
+                   "OCTAVE function.");
+          }
+          put_field (option, 2, global.string_value ());
+        }
+        put_field (proto, 12, option);
+      }
+    }
+    else if (pools.isnumeric () && pools.isreal ())
+    {
+      NDArray counts = pools.array_value ();
+      for (octave_idx_type i = 0; i < counts.numel (); i++)
+      {
+        string option;
+        put_field (option, 1, config_int (counts(i), name, 0, int32_max));
+        put_field (proto, 12, option);
+      }
+    }
+    else
+    {
+      error ("tensorflow: field '%s' of the ConfigProto must be a struct "
+             "array or a vector of thread counts parsed to the "
+             "'TF_EncodeConfig' OCTAVE function.", name);
+    }
+  }
+  // Return the serialized ConfigProto
+  uint8NDArray bytes (dim_vector (1, proto.size ()));
+  memcpy (bytes.fortran_vec (), proto.data (), proto.size ());
+  octave_value plhs = bytes;
+  return plhs;
+}
+
 // -----------------------------------------------------------------------------
 // C API functions referenced by the TF_Session classdef
 // -----------------------------------------------------------------------------
@@ -256,11 +483,199 @@ octave_value OCT_TF_LoadSessionFromSavedModel (OCT_ARGS)
                                                       tags.data (), tags_len,
                                                       graph, meta_graph_def,
                                                       status);
+  graph_changed ();
   octave_uint64 ptr = (uint64_t) session;
   octave_value plhs = ptr;
   return plhs;
 }
 
+// Decode a TensorShapeProto into an int64 row vector of dimensions, -1 for a
+// dimension of unknown size, or a 0x0 one for a shape of unknown rank
+static int64NDArray decode_tensor_shape (pb_reader shape)
+{
+  vector<int64_t> dims;
+  bool unknown_rank = false;
+  while (shape.next ())
+  {
+    if (shape.field == 2 && shape.wire == 2)
+    {
+      int64_t size = 0;
+      pb_reader dim = shape.message ();
+      while (dim.next ())
+      {
+        if (dim.field == 1 && dim.wire == 0) {size = (int64_t) dim.value;}
+      }
+      dims.push_back (size);
+    }
+    else if (shape.field == 3 && shape.wire == 0)
+    {
+      unknown_rank = shape.value != 0;
+    }
+  }
+  if (unknown_rank) {return int64NDArray (dim_vector (0, 0));}
+  int64NDArray out (dim_vector (1, dims.size ()));
+  for (size_t i = 0; i < dims.size (); i++) {out(i) = dims[i];}
+  return out;
+}
+
+// Decode the map<string, TensorInfo> of the inputs or the outputs of a
+// SignatureDef into a struct column vector sorted by key
+static octave_map decode_tensor_infos (const vector<pb_reader>& entries)
+{
+  struct tensor_info
+  {
+    string key;
+    string name;
+    uint32_t dtype = 0;
+    int64NDArray shape = int64NDArray (dim_vector (0, 0));
+  };
+  vector<tensor_info> infos;
+  for (pb_reader entry : entries)
+  {
+    tensor_info info;
+    while (entry.next ())
+    {
+      if (entry.wire != 2) {continue;}
+      if (entry.field == 1) {info.key = entry.str ();}
+      if (entry.field != 2) {continue;}
+      pb_reader ti = entry.message ();
+      while (ti.next ())
+      {
+        if (ti.field == 1 && ti.wire == 2) {info.name = ti.str ();}
+        if (ti.field == 2 && ti.wire == 0) {info.dtype = (uint32_t) ti.value;}
+        if (ti.field == 3 && ti.wire == 2)
+        {
+          info.shape = decode_tensor_shape (ti.message ());
+        }
+      }
+    }
+    infos.push_back (info);
+  }
+  sort (infos.begin (), infos.end (),
+        [] (const tensor_info& a, const tensor_info& b)
+        {return a.key < b.key;});
+  octave_idx_type n = (octave_idx_type) infos.size ();
+  Cell key (dim_vector (n, 1));
+  Cell name (dim_vector (n, 1));
+  Cell dtype (dim_vector (n, 1));
+  Cell shape (dim_vector (n, 1));
+  for (octave_idx_type i = 0; i < n; i++)
+  {
+    key(i) = infos[i].key;
+    name(i) = infos[i].name;
+    dtype(i) = octave_uint32 (infos[i].dtype);
+    shape(i) = infos[i].shape;
+  }
+  octave_map out (dim_vector (n, 1));
+  out.assign ("Key", key);
+  out.assign ("Name", name);
+  out.assign ("DataType", dtype);
+  out.assign ("Shape", shape);
+  return out;
+}
+
+// struct TF_SignatureDefs(TF_Buffer* meta_graph_def)
+//
+// Decode the signature_def map of a serialized MetaGraphDef, as returned by
+// TF_LoadSessionFromSavedModel, into a struct column vector with one element
+// per signature, sorted by name, with its Name, its MethodName, and its
+// Inputs and Outputs, each a struct column vector sorted by Key giving the
+// Name of the tensor in the Graph, its DataType and its Shape.  Only the
+// signatures are read; the GraphDef the message also holds is skipped.
+octave_value OCT_TF_SignatureDefs (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_SignatureDefs' OCTAVE function.");
+  }
+  // Check octave_value type for MetaGraphDef, in a Buffer or serialized
+  const void* data;
+  size_t len;
+  if (args(1).is_uint64_type () && args(1).is_scalar_type ())
+  {
+    const TF_Buffer* buffer = (TF_Buffer*) args(1).uint64_value ();
+    if (! buffer)
+    {
+      error ("tensorflow: the MetaGraphDef Buffer parsed to the "
+             "'TF_SignatureDefs' OCTAVE function is a null pointer.");
+    }
+    data = buffer->data;
+    len = buffer->length;
+  }
+  else if (args(1).is_uint8_type () && args(1).rows () <= 1)
+  {
+    data = args(1).mex_get_data ();
+    len = (size_t) args(1).numel ();
+  }
+  else
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to the "
+           "MetaGraphDef Buffer, or a uint8 vector holding a serialized "
+           "MetaGraphDef, parsed to the 'TF_SignatureDefs' OCTAVE function.");
+  }
+  // Gather the map entries of each signature, keyed by name
+  struct signature
+  {
+    string name;
+    string method;
+    vector<pb_reader> inputs;
+    vector<pb_reader> outputs;
+  };
+  vector<signature> sigs;
+  pb_reader meta (data, len);
+  bool malformed = false;
+  while (meta.next ())
+  {
+    if (meta.field != 5 || meta.wire != 2) {continue;}
+    signature sig;
+    pb_reader entry = meta.message ();
+    while (entry.next ())
+    {
+      if (entry.wire != 2) {continue;}
+      if (entry.field == 1) {sig.name = entry.str ();}
+      if (entry.field != 2) {continue;}
+      pb_reader def = entry.message ();
+      while (def.next ())
+      {
+        if (def.wire != 2) {continue;}
+        if (def.field == 1) {sig.inputs.push_back (def.message ());}
+        if (def.field == 2) {sig.outputs.push_back (def.message ());}
+        if (def.field == 3) {sig.method = def.str ();}
+      }
+      malformed |= def.malformed;
+    }
+    malformed |= entry.malformed;
+    sigs.push_back (sig);
+  }
+  if (meta.malformed || malformed)
+  {
+    error ("tensorflow: the MetaGraphDef parsed to the 'TF_SignatureDefs' "
+           "OCTAVE function could not be decoded.");
+  }
+  sort (sigs.begin (), sigs.end (),
+        [] (const signature& a, const signature& b) {return a.name < b.name;});
+  octave_idx_type n = (octave_idx_type) sigs.size ();
+  Cell name (dim_vector (n, 1));
+  Cell method (dim_vector (n, 1));
+  Cell inputs (dim_vector (n, 1));
+  Cell outputs (dim_vector (n, 1));
+  for (octave_idx_type i = 0; i < n; i++)
+  {
+    name(i) = sigs[i].name;
+    method(i) = sigs[i].method;
+    inputs(i) = decode_tensor_infos (sigs[i].inputs);
+    outputs(i) = decode_tensor_infos (sigs[i].outputs);
+  }
+  octave_map out (dim_vector (n, 1));
+  out.assign ("Name", name);
+  out.assign ("MethodName", method);
+  out.assign ("Inputs", inputs);
+  out.assign ("Outputs", outputs);
+  octave_value plhs = out;
+  return plhs;
+}
+
 // TF_CAPI_EXPORT extern void TF_CloseSession(TF_Session*, TF_Status* status);
 void OCT_TF_CloseSession (OCT_ARGS)
 {
@@ -312,9 +727,189 @@ void OCT_TF_DeleteSession (OCT_ARGS)
   TF_Session* session = (TF_Session*) args(1).uint64_value ();
   // Get pointer to Status
   TF_Status* status = (TF_Status*) args(2).uint64_value ();
+  delete_session_pool (session);
   TF_DeleteSession (session, status);
 }
 
+// The execution of one node of a Graph, as recorded in the StepStats of the
+// RunMetadata of a run traced with FULL_TRACE.  The start is the absolute
+// time in microseconds, so that the nodes of several runs can be ordered.
+struct node_stat
+{
+  string name;
+  string op;
+  string device;
+  double start = 0;
+  double wall = 0;
+  int64_t bytes = 0;
+};
+
+// Sum the bytes allocated for the Tensor described by a NodeOutput, falling
+// back to the bytes requested when the allocator did not report them
+static int64_t node_output_bytes (pb_reader output)
+{
+  int64_t bytes = 0;
+  while (output.next ())
+  {
+    if (output.field != 3 || output.wire != 2) {continue;}
+    pb_reader tensor = output.message ();
+    while (tensor.next ())
+    {
+      if (tensor.field != 4 || tensor.wire != 2) {continue;}
+      pb_reader alloc = tensor.message ();
+      int64_t requested = 0;
+      int64_t allocated = 0;
+      while (alloc.next ())
+      {
+        if (alloc.wire != 0) {continue;}
+        if (alloc.field == 1) {requested = (int64_t) alloc.value;}
+        if (alloc.field == 2) {allocated = (int64_t) alloc.value;}
+      }
+      bytes += allocated > 0 ? allocated : requested;
+    }
+  }
+  return bytes;
+}
+
+// Decode a NodeExecStats.  The op type is taken from the timeline label,
+// which reads "name = Op(inputs)", and the times in nanoseconds are preferred
+// to those in microseconds when the runtime recorded them.
+static node_stat decode_node_stats (pb_reader stats, const string& device)
+{
+  node_stat node;
+  node.device = device;
+  int64_t start_us = 0, end_rel_us = 0, start_ns = 0, end_rel_ns = 0;
+  while (stats.next ())
+  {
+    switch (stats.field)
+    {
+      case 1:
+        if (stats.wire == 2) {node.name = stats.str ();}
+        break;
+      case 2:
+        start_us = (int64_t) stats.value;
+        break;
+      case 5:
+        end_rel_us = (int64_t) stats.value;
+        break;
+      case 7:
+        if (stats.wire == 2)
+        {
+          node.bytes += node_output_bytes (stats.message ());
+        }
+        break;
+      case 8:
+        if (stats.wire == 2)
+        {
+          string label = stats.str ();
+          size_t eq = label.find (" = ");
+          size_t paren = label.find ('(', eq);
+          if (eq != string::npos && paren != string::npos)
+          {
+            node.op = label.substr (eq + 3, paren - eq - 3);
+          }
+        }
+        break;
+      case 13:
+        start_ns = (int64_t) stats.value;
+        break;
+      case 16:
+        end_rel_ns = (int64_t) stats.value;
+        break;
+    }
+  }
+  node.start = start_ns ? start_ns / 1e3 : (double) start_us;
+  node.wall = start_ns ? end_rel_ns / 1e3 : (double) end_rel_us;
+  return node;
+}
+
+// Decode the StepStats of a serialized RunMetadata into the nodes executed
+// on every device, ordered by the time they started.  False if the message is
+// malformed.  It raises no error, and may be called from any thread.
+static bool decode_step_stats (const TF_Buffer* metadata,
+                               vector<node_stat>& nodes)
+{
+  pb_reader meta (metadata->data, metadata->length);
+  while (meta.next ())
+  {
+    if (meta.field != 1 || meta.wire != 2) {continue;}
+    pb_reader step = meta.message ();
+    while (step.next ())
+    {
+      if (step.field != 1 || step.wire != 2) {continue;}
+      // Read the name of the device first, whatever the order of the fields
+      string device;
+      pb_reader dev = step.message ();
+      while (dev.next ())
+      {
+        if (dev.field == 1 && dev.wire == 2) {device = dev.str ();}
+      }
+      dev = step.message ();
+      while (dev.next ())
+      {
+        if (dev.field == 2 && dev.wire == 2)
+        {
+          nodes.push_back (decode_node_stats (dev.message (), device));
+        }
+      }
+    }
+  }
+  stable_sort (nodes.begin (), nodes.end (),
+               [] (const node_stat& a, const node_stat& b)
+               {return a.start < b.start;});
+  return ! meta.malformed;
+}
+
+// TF_SessionRun, recorded in the trace while one is being recorded.  A run
+// that passes neither RunOptions nor RunMetadata of its own is then traced in
+// full, and the kernels found in the StepStats of its RunMetadata are
+// recorded along with it.  It may be called from any thread.
+static void session_run (TF_Session* session, const TF_Buffer* run_options,
+                         const TF_Output* inputs,
+                         TF_Tensor* const* input_values, int ninputs,
+                         const TF_Output* outputs, TF_Tensor** output_values,
+                         int noutputs, const TF_Operation* const* targets,
+                         int ntargets, TF_Buffer* run_metadata,
+                         TF_Status* status)
+{
+  if (! trace_on.load (memory_order_relaxed))
+  {
+    TF_SessionRun (session, run_options, inputs, input_values, ninputs,
+                   outputs, output_values, noutputs, targets, ntargets,
+                   run_metadata, status);
+    return;
+  }
+  // RunOptions with field 1, trace_level, set to 3, FULL_TRACE
+  static const uint8_t full_trace[] = {0x08, 0x03};
+  unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+    own_options (nullptr, &TF_DeleteBuffer);
+  unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+    own_metadata (nullptr, &TF_DeleteBuffer);
+  if (! run_options && ! run_metadata)
+  {
+    own_options.reset (TF_NewBufferFromString (full_trace,
+                                               sizeof (full_trace)));
+    own_metadata.reset (TF_NewBuffer ());
+    run_options = own_options.get ();
+    run_metadata = own_metadata.get ();
+  }
+  {
+    trace_scope scope ("TF_SessionRun", "session");
+    TF_SessionRun (session, run_options, inputs, input_values, ninputs,
+                   outputs, output_values, noutputs, targets, ntargets,
+                   run_metadata, status);
+  }
+  vector<node_stat> nodes;
+  if (run_metadata && TF_GetCode (status) == TF_OK)
+  {
+    decode_step_stats (run_metadata, nodes);
+  }
+  for (const node_stat& node : nodes)
+  {
+    trace_kernel (node.name, node.op, node.device, node.start, node.wall);
+  }
+}
+
 // TF_CAPI_EXPORT extern void TF_SessionRun(
 //     TF_Session* session, const TF_Buffer* run_options,
 //     const TF_Output* inputs, TF_Tensor* const* input_values, int ninputs,
@@ -438,11 +1033,11 @@ octave_value OCT_TF_SessionRun (OCT_ARGS)
   // Get pointer to Status
   TF_Status* status = (TF_Status*) args(8).uint64_value ();
   // Run the Session
-  TF_SessionRun (session, run_options,
-                 inputs.data (), input_values.data (), ninputs,
-                 outputs.data (), output_values.data (), noutputs,
-                 target_opers.data (), ntargets,
-                 run_metadata, status);
+  session_run (session, run_options,
+               inputs.data (), input_values.data (), ninputs,
+               outputs.data (), output_values.data (), noutputs,
+               target_opers.data (), ntargets,
+               run_metadata, status);
   // Return the pointers to the output Tensors
   dim_vector oct_dims;
   oct_dims.resize (2);
@@ -457,38 +1052,1875 @@ octave_value OCT_TF_SessionRun (OCT_ARGS)
   return plhs;
 }
 
-// TF_CAPI_EXPORT extern TF_DeviceList* TF_SessionListDevices(
-//     TF_Session* session, TF_Status* status);
-octave_value OCT_TF_SessionListDevices (OCT_ARGS)
+// TF_CAPI_EXPORT extern void TF_SessionPRunSetup(
+//     TF_Session*, const TF_Output* inputs, int ninputs,
+//     const TF_Output* outputs, int noutputs,
+//     const TF_Operation* const* target_opers, int ntargets,
+//     const char** handle, TF_Status*);
+//
+// The number of inputs, outputs and targets is taken from the number of
+// elements of the corresponding vectors of pointers, and the handle is
+// returned as an uint64 pointer instead of being written through 'handle'.
+octave_value OCT_TF_SessionPRunSetup (OCT_ARGS)
 {
-  if (nrhs < 3)
+  if (nrhs < 6)
   {
-    error ("tensorflow: two extra arguments are required "
-           "for the 'TF_SessionListDevices' C API function.");
+    error ("tensorflow: five extra arguments are required "
+           "for the 'TF_SessionPRunSetup' C API function.");
   }
   // Check octave_value type for pointer to Session
   if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
   {
-    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to the "
-           "Session parsed to the 'TF_SessionListDevices' C API function.");
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_SessionPRunSetup' C API function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (! args(2).isempty ()
+      && (! args(2).is_uint64_type () || args(2).rows () != 1))
+  {
+    error ("tensorflow: 3rd argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_SessionPRunSetup' "
+           "C API function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (! args(3).isempty ()
+      && (! args(3).is_uint64_type () || args(3).rows () != 1))
+  {
+    error ("tensorflow: 4th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_SessionPRunSetup' "
+           "C API function.");
+  }
+  // Check octave_value type for pointers to target Operations
+  if (! args(4).isempty ()
+      && (! args(4).is_uint64_type () || args(4).rows () != 1))
+  {
+    error ("tensorflow: 5th argument must be an uint64 vector of pointers to "
+           "the target Operations parsed to the 'TF_SessionPRunSetup' "
+           "C API function.");
   }
   // Check octave_value type for pointer to Status
-  if (! args(2).is_uint64_type () || ! args(2).is_scalar_type ())
+  if (! args(5).is_uint64_type () || ! args(5).is_scalar_type ())
   {
-    error ("tensorflow: 3rd argument must be an uint64 scalar pointer to the "
-           "Status parsed to the 'TF_SessionListDevices' C API function.");
+    error ("tensorflow: 6th argument must be an uint64 scalar pointer to "
+           "the Status parsed to the 'TF_SessionPRunSetup' C API function.");
   }
   // Get pointer to Session
   TF_Session* session = (TF_Session*) args(1).uint64_value ();
+  // Get input Outputs, copied into a contiguous array of structures
+  int ninputs = (int) args(2).numel ();
+  uint64NDArray oct_inputs = args(2).uint64_array_value ();
+  vector<TF_Output> inputs (ninputs);
+  for (int i = 0; i < ninputs; i++)
+  {
+    inputs[i] = *((TF_Output*) (uint64_t) oct_inputs(i));
+  }
+  // Get output Outputs
+  int noutputs = (int) args(3).numel ();
+  uint64NDArray oct_outputs = args(3).uint64_array_value ();
+  vector<TF_Output> outputs (noutputs);
+  for (int i = 0; i < noutputs; i++)
+  {
+    outputs[i] = *((TF_Output*) (uint64_t) oct_outputs(i));
+  }
+  // Get target Operations
+  int ntargets = (int) args(4).numel ();
+  uint64NDArray oct_targets = args(4).uint64_array_value ();
+  vector<const TF_Operation*> target_opers (ntargets);
+  for (int i = 0; i < ntargets; i++)
+  {
+    target_opers[i] = (const TF_Operation*) (uint64_t) oct_targets(i);
+  }
   // Get pointer to Status
-  TF_Status* status = (TF_Status*) args(2).uint64_value ();
-  // Get DeviceList and return its pointer
-  TF_DeviceList* devices = TF_SessionListDevices (session, status);
-  octave_uint64 ptr = (uint64_t) devices;
+  TF_Status* status = (TF_Status*) args(5).uint64_value ();
+  // Set up the partial run and return its handle
+  const char* handle = nullptr;
+  TF_SessionPRunSetup (session, inputs.data (), ninputs,
+                       outputs.data (), noutputs,
+                       target_opers.data (), ntargets, &handle, status);
+  octave_uint64 ptr = (uint64_t) handle;
   octave_value plhs = ptr;
   return plhs;
 }
 
+// TF_CAPI_EXPORT extern void TF_SessionPRun(
+//     TF_Session*, const char* handle,
+//     const TF_Output* inputs, TF_Tensor* const* input_values, int ninputs,
+//     const TF_Output* outputs, TF_Tensor** output_values, int noutputs,
+//     const TF_Operation* const* target_opers, int ntargets, TF_Status*);
+//
+// As for TF_SessionRun, the counts are taken from the vectors of pointers and
+// the output tensors are returned as an uint64 vector of pointers.
+octave_value OCT_TF_SessionPRun (OCT_ARGS)
+{
+  if (nrhs < 8)
+  {
+    error ("tensorflow: seven extra arguments are required "
+           "for the 'TF_SessionPRun' C API function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_SessionPRun' C API function.");
+  }
+  // Check octave_value type for partial run handle
+  if (! args(2).is_uint64_type () || ! args(2).is_scalar_type ())
+  {
+    error ("tensorflow: 3rd argument must be an uint64 scalar pointer to "
+           "the partial run handle parsed to the 'TF_SessionPRun' "
+           "C API function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (! args(3).isempty ()
+      && (! args(3).is_uint64_type () || args(3).rows () != 1))
+  {
+    error ("tensorflow: 4th argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_SessionPRun' C API function.");
+  }
+  // Check octave_value type for pointers to input Tensors
+  if (! args(4).isempty ()
+      && (! args(4).is_uint64_type () || args(4).rows () != 1))
+  {
+    error ("tensorflow: 5th argument must be an uint64 vector of pointers to "
+           "the input Tensors parsed to the 'TF_SessionPRun' C API function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (! args(5).isempty ()
+      && (! args(5).is_uint64_type () || args(5).rows () != 1))
+  {
+    error ("tensorflow: 6th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_SessionPRun' C API function.");
+  }
+  // Check octave_value type for pointers to target Operations
+  if (! args(6).isempty ()
+      && (! args(6).is_uint64_type () || args(6).rows () != 1))
+  {
+    error ("tensorflow: 7th argument must be an uint64 vector of pointers to "
+           "the target Operations parsed to the 'TF_SessionPRun' "
+           "C API function.");
+  }
+  // Check octave_value type for pointer to Status
+  if (! args(7).is_uint64_type () || ! args(7).is_scalar_type ())
+  {
+    error ("tensorflow: 8th argument must be an uint64 scalar pointer to "
+           "the Status parsed to the 'TF_SessionPRun' C API function.");
+  }
+  // Check that each input Output is matched by an input Tensor
+  if (args(3).numel () != args(4).numel ())
+  {
+    error ("tensorflow: the 4th and 5th arguments must have the same number "
+           "of elements parsed to the 'TF_SessionPRun' C API function.");
+  }
+  // Get pointer to Session
+  TF_Session* session = (TF_Session*) args(1).uint64_value ();
+  // Get partial run handle
+  const char* handle = (const char*) args(2).uint64_value ();
+  // Get input Outputs, copied into a contiguous array of structures
+  int ninputs = (int) args(3).numel ();
+  uint64NDArray oct_inputs = args(3).uint64_array_value ();
+  vector<TF_Output> inputs (ninputs);
+  for (int i = 0; i < ninputs; i++)
+  {
+    inputs[i] = *((TF_Output*) (uint64_t) oct_inputs(i));
+  }
+  // Get input Tensors
+  uint64NDArray oct_input_values = args(4).uint64_array_value ();
+  vector<TF_Tensor*> input_values (ninputs);
+  for (int i = 0; i < ninputs; i++)
+  {
+    input_values[i] = (TF_Tensor*) (uint64_t) oct_input_values(i);
+  }
+  // Get output Outputs
+  int noutputs = (int) args(5).numel ();
+  uint64NDArray oct_outputs = args(5).uint64_array_value ();
+  vector<TF_Output> outputs (noutputs);
+  for (int i = 0; i < noutputs; i++)
+  {
+    outputs[i] = *((TF_Output*) (uint64_t) oct_outputs(i));
+  }
+  // Allocate the array receiving the output Tensors
+  vector<TF_Tensor*> output_values (noutputs, nullptr);
+  // Get target Operations
+  int ntargets = (int) args(6).numel ();
+  uint64NDArray oct_targets = args(6).uint64_array_value ();
+  vector<const TF_Operation*> target_opers (ntargets);
+  for (int i = 0; i < ntargets; i++)
+  {
+    target_opers[i] = (const TF_Operation*) (uint64_t) oct_targets(i);
+  }
+  // Get pointer to Status
+  TF_Status* status = (TF_Status*) args(7).uint64_value ();
+  // Continue the partial run
+  TF_SessionPRun (session, handle,
+                  inputs.data (), input_values.data (), ninputs,
+                  outputs.data (), output_values.data (), noutputs,
+                  target_opers.data (), ntargets, status);
+  // Return the pointers to the output Tensors
+  dim_vector oct_dims;
+  oct_dims.resize (2);
+  oct_dims(0) = noutputs > 0 ? 1 : 0;
+  oct_dims(1) = noutputs;
+  uint64NDArray out_values (oct_dims);
+  for (int i = 0; i < noutputs; i++)
+  {
+    out_values(i) = (uint64_t) output_values[i];
+  }
+  octave_value plhs = out_values;
+  return plhs;
+}
+
+// TF_CAPI_EXPORT extern void TF_DeletePRunHandle(const char* handle);
+void OCT_TF_DeletePRunHandle (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_DeletePRunHandle' C API function.");
+  }
+  // Check octave_value type for partial run handle
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to the "
+           "partial run handle parsed to the 'TF_DeletePRunHandle' "
+           "C API function.");
+  }
+  // Get partial run handle
+  const char* handle = (const char*) args(1).uint64_value ();
+  TF_DeletePRunHandle (handle);
+}
+
+// Tensors deleted when the list goes out of scope, so that none is leaked
+// when an error is raised halfway through a run.  An entry handed over to
+// somewhere else is set to null.
+struct tensor_list
+{
+  vector<TF_Tensor*> tensors;
+  tensor_list (size_t n) : tensors (n, nullptr) {}
+  tensor_list (const tensor_list&) = delete;
+  tensor_list& operator = (const tensor_list&) = delete;
+  ~tensor_list ()
+  {
+    for (TF_Tensor* tensor : tensors)
+    {
+      if (tensor) {TF_DeleteTensor (tensor);}
+    }
+  }
+};
+
+// Convert the values to the Tensors fed to a run, each to the data type of
+// the input it is fed to when it is a floating point one.  The values flagged
+// in 'tensors' are pointers to Tensors owned by the caller and are fed as they
+// are, while those built here are recorded in 'owned' to be released with it.
+// Values that are copied are copied into buffers of the pool of the Session.
+static vector<TF_Tensor*> load_values (TF_Session* session,
+                                      const TF_Output* inputs,
+                                      const Cell& values,
+                                      const boolNDArray& tensors,
+                                      size_t ninputs, bool native,
+                                      tensor_list& owned, const char* fname)
+{
+  vector<TF_Tensor*> input_values (ninputs);
+  pool_scope scope (session_pool (session));
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    if (tensors(i))
+    {
+      if (! values(i).is_uint64_type () || ! values(i).is_scalar_type ())
+      {
+        error ("tensorflow: value %d is flagged as a Tensor but is not an "
+               "uint64 scalar pointer, parsed to the '%s' OCTAVE function.",
+               (int) i + 1, fname);
+      }
+      input_values[i] = (TF_Tensor*) values(i).uint64_value ();
+    }
+    else
+    {
+      input_values[i] = load_input (values(i), native,
+                                    TF_OperationOutputType (inputs[i]));
+      owned.tensors[i] = input_values[i];
+    }
+  }
+  return input_values;
+}
+
+// Hand each output Tensor of a run over to the Octave array built from it
+static Cell save_values (tensor_list& output_values, bool native)
+{
+  size_t noutputs = output_values.tensors.size ();
+  Cell out (dim_vector (1, noutputs));
+  for (size_t i = 0; i < noutputs; i++)
+  {
+    TF_Tensor* tensor = output_values.tensors[i];
+    output_values.tensors[i] = nullptr;
+    out(i) = save_tensor (tensor, native, true);
+  }
+  return out;
+}
+
+// Convert the values, run the Session and convert the outputs back, raising
+// an error with the message of the Status if the run fails.  Every Tensor
+// built here is released before returning, however the function is left.
+static Cell run_values (TF_Session* session,
+                        const TF_Output* inputs, const Cell& values,
+                        const boolNDArray& tensors, size_t ninputs,
+                        const TF_Output* outputs, size_t noutputs,
+                        bool native, TF_Status* status, const char* fname)
+{
+  tensor_list owned (ninputs);
+  vector<TF_Tensor*> input_values = load_values (session, inputs, values,
+                                                 tensors, ninputs, native,
+                                                 owned, fname);
+  // Run the Session
+  tensor_list output_values (noutputs);
+  session_run (session, nullptr,
+               inputs, input_values.data (), (int) ninputs,
+               outputs, output_values.tensors.data (), (int) noutputs,
+               nullptr, 0, nullptr, status);
+  if (TF_GetCode (status) != TF_OK)
+  {
+    error ("tensorflow: %s", TF_Message (status));
+  }
+  return save_values (output_values, native);
+}
+
+// Cell TF_SessionRunValues(TF_Session* session, TF_Output* inputs,
+//                          Cell values, TF_Output* outputs, string layout,
+//                          bool tensors)
+//
+// TF_SessionRun taking and returning Octave arrays.  Each value is converted
+// to a Tensor, the Graph is executed and each output Tensor is converted back
+// and released, all in one call, and the message of a failed run is raised as
+// an error.  The elements of 'values' flagged by 'tensors' are uint64 pointers
+// to Tensors owned by the caller, which are fed as they are.
+octave_value OCT_TF_SessionRunValues (OCT_ARGS)
+{
+  if (nrhs < 5)
+  {
+    error ("tensorflow: four extra arguments are required "
+           "for the 'TF_SessionRunValues' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_SessionRunValues' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (! args(2).isempty ()
+      && (! args(2).is_uint64_type () || args(2).rows () != 1))
+  {
+    error ("tensorflow: 3rd argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_SessionRunValues' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for input values
+  if (! args(3).iscell () || args(3).numel () != args(2).numel ())
+  {
+    error ("tensorflow: 4th argument must be a cell array with one value per "
+           "input Output parsed to the 'TF_SessionRunValues' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (! args(4).isempty ()
+      && (! args(4).is_uint64_type () || args(4).rows () != 1))
+  {
+    error ("tensorflow: 5th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_SessionRunValues' OCTAVE "
+           "function.");
+  }
+  bool native = native_layout (args, nrhs, 5, "6th", "TF_SessionRunValues");
+  // Get pointer to Session
+  TF_Session* session = (TF_Session*) args(1).uint64_value ();
+  // Get input Outputs, copied into a contiguous array of structures
+  size_t ninputs = (size_t) args(2).numel ();
+  uint64NDArray oct_inputs = args(2).uint64_array_value ();
+  vector<TF_Output> inputs (ninputs);
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    inputs[i] = *((TF_Output*) (uint64_t) oct_inputs(i));
+  }
+  // Get output Outputs
+  size_t noutputs = (size_t) args(4).numel ();
+  uint64NDArray oct_outputs = args(4).uint64_array_value ();
+  vector<TF_Output> outputs (noutputs);
+  for (size_t i = 0; i < noutputs; i++)
+  {
+    outputs[i] = *((TF_Output*) (uint64_t) oct_outputs(i));
+  }
+  // Check octave_value type for the values given as Tensors
+  boolNDArray tensors (dim_vector (1, ninputs), false);
+  if (nrhs > 6)
+  {
+    if (! args(6).islogical () || (size_t) args(6).numel () != ninputs)
+    {
+      error ("tensorflow: 7th argument must be a logical vector flagging the "
+             "values given as Tensors parsed to the 'TF_SessionRunValues' "
+             "OCTAVE function.");
+    }
+    tensors = args(6).bool_array_value ();
+  }
+  // The Status is released with the function, whichever way it is left
+  unique_ptr<TF_Status, decltype (&TF_DeleteStatus)>
+    status (TF_NewStatus (), &TF_DeleteStatus);
+  Cell out = run_values (session, inputs.data (), args(3).cell_value (),
+                         tensors, ninputs, outputs.data (), noutputs,
+                         native, status.get (), "TF_SessionRunValues");
+  octave_value plhs = out;
+  return plhs;
+}
+
+// Run the Session as run_values does, with a FULL_TRACE of every node, and
+// return the RunMetadata it recorded.  'outputs' receives the outputs
+// converted back to Octave arrays.
+static unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+traced_run (TF_Session* session, const TF_Output* inputs, const Cell& values,
+            const boolNDArray& tensors, size_t ninputs,
+            const TF_Output* outputs, size_t noutputs, bool native,
+            TF_Status* status, Cell& out, const char* fname)
+{
+  static const uint8_t full_trace[] = {0x08, 0x03};
+  unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+    run_options (TF_NewBufferFromString (full_trace, sizeof (full_trace)),
+                 &TF_DeleteBuffer);
+  unique_ptr<TF_Buffer, decltype (&TF_DeleteBuffer)>
+    metadata (TF_NewBuffer (), &TF_DeleteBuffer);
+  tensor_list owned (ninputs);
+  vector<TF_Tensor*> input_values = load_values (session, inputs, values,
+                                                 tensors, ninputs, native,
+                                                 owned, fname);
+  // Run the Session
+  tensor_list output_values (noutputs);
+  session_run (session, run_options.get (),
+               inputs, input_values.data (), (int) ninputs,
+               outputs, output_values.tensors.data (), (int) noutputs,
+               nullptr, 0, metadata.get (), status);
+  if (TF_GetCode (status) != TF_OK)
+  {
+    error ("tensorflow: %s", TF_Message (status));
+  }
+  out = save_values (output_values, native);
+  return metadata;
+}
+
+// struct TF_SessionProfile(TF_Session* session, TF_Output* inputs,
+//                          Cell values, TF_Output* outputs, string layout,
+//                          bool tensors)
+//
+// As TF_SessionRunValues, except that the run is traced in full and the
+// StepStats it recorded are returned along with the outputs, in a struct with
+// an 'outputs' cell array and a 'nodes' struct array, one element per node
+// executed, in the order they started.  Each node has its Name, its Op type,
+// the Device it ran on, its StartMicros since the first node started, its
+// WallMicros and the OutputBytes allocated for its outputs.
+octave_value OCT_TF_SessionProfile (OCT_ARGS)
+{
+  if (nrhs < 5)
+  {
+    error ("tensorflow: four extra arguments are required "
+           "for the 'TF_SessionProfile' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_SessionProfile' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (! args(2).isempty ()
+      && (! args(2).is_uint64_type () || args(2).rows () != 1))
+  {
+    error ("tensorflow: 3rd argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_SessionProfile' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for input values
+  if (! args(3).iscell () || args(3).numel () != args(2).numel ())
+  {
+    error ("tensorflow: 4th argument must be a cell array with one value per "
+           "input Output parsed to the 'TF_SessionProfile' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (! args(4).isempty ()
+      && (! args(4).is_uint64_type () || args(4).rows () != 1))
+  {
+    error ("tensorflow: 5th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_SessionProfile' OCTAVE "
+           "function.");
+  }
+  bool native = native_layout (args, nrhs, 5, "6th", "TF_SessionProfile");
+  // Get pointer to Session
+  TF_Session* session = (TF_Session*) args(1).uint64_value ();
+  // Get input Outputs, copied into a contiguous array of structures
+  size_t ninputs = (size_t) args(2).numel ();
+  uint64NDArray oct_inputs = args(2).uint64_array_value ();
+  vector<TF_Output> inputs (ninputs);
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    inputs[i] = *((TF_Output*) (uint64_t) oct_inputs(i));
+  }
+  // Get output Outputs
+  size_t noutputs = (size_t) args(4).numel ();
+  uint64NDArray oct_outputs = args(4).uint64_array_value ();
+  vector<TF_Output> outputs (noutputs);
+  for (size_t i = 0; i < noutputs; i++)
+  {
+    outputs[i] = *((TF_Output*) (uint64_t) oct_outputs(i));
+  }
+  // Check octave_value type for the values given as Tensors
+  boolNDArray tensors (dim_vector (1, ninputs), false);
+  if (nrhs > 6)
+  {
+    if (! args(6).islogical () || (size_t) args(6).numel () != ninputs)
+    {
+      error ("tensorflow: 7th argument must be a logical vector flagging the "
+             "values given as Tensors parsed to the 'TF_SessionProfile' "
+             "OCTAVE function.");
+    }
+    tensors = args(6).bool_array_value ();
+  }
+  // The Status is released with the function, whichever way it is left
+  unique_ptr<TF_Status, decltype (&TF_DeleteStatus)>
+    status (TF_NewStatus (), &TF_DeleteStatus);
+  Cell out;
+  auto metadata = traced_run (session, inputs.data (), args(3).cell_value (),
+                              tensors, ninputs, outputs.data (), noutputs,
+                              native, status.get (), out,
+                              "TF_SessionProfile");
+  vector<node_stat> stats;
+  if (! decode_step_stats (metadata.get (), stats))
+  {
+    error ("tensorflow: the RunMetadata returned by TF_SessionRun could not "
+           "be decoded.");
+  }
+  // Build the struct array of nodes, timed from the first one to start
+  octave_idx_type n = (octave_idx_type) stats.size ();
+  double origin = stats.empty () ? 0 : stats.front ().start;
+  Cell name (dim_vector (n, 1));
+  Cell op (dim_vector (n, 1));
+  Cell device (dim_vector (n, 1));
+  Cell start (dim_vector (n, 1));
+  Cell wall (dim_vector (n, 1));
+  Cell bytes (dim_vector (n, 1));
+  for (octave_idx_type i = 0; i < n; i++)
+  {
+    name(i) = stats[i].name;
+    op(i) = stats[i].op;
+    device(i) = stats[i].device;
+    start(i) = stats[i].start - origin;
+    wall(i) = stats[i].wall;
+    bytes(i) = (double) stats[i].bytes;
+  }
+  octave_map nodes (dim_vector (n, 1));
+  nodes.assign ("Name", name);
+  nodes.assign ("Op", op);
+  nodes.assign ("Device", device);
+  nodes.assign ("StartMicros", start);
+  nodes.assign ("WallMicros", wall);
+  nodes.assign ("OutputBytes", bytes);
+  octave_scalar_map profile;
+  profile.assign ("outputs", out);
+  profile.assign ("nodes", nodes);
+  octave_value plhs = profile;
+  return plhs;
+}
+
+// TF_CAPI_EXPORT extern TF_DeviceList* TF_SessionListDevices(
+//     TF_Session* session, TF_Status* status);
+octave_value OCT_TF_SessionListDevices (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_SessionListDevices' C API function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to the "
+           "Session parsed to the 'TF_SessionListDevices' C API function.");
+  }
+  // Check octave_value type for pointer to Status
+  if (! args(2).is_uint64_type () || ! args(2).is_scalar_type ())
+  {
+    error ("tensorflow: 3rd argument must be an uint64 scalar pointer to the "
+           "Status parsed to the 'TF_SessionListDevices' C API function.");
+  }
+  // Get pointer to Session
+  TF_Session* session = (TF_Session*) args(1).uint64_value ();
+  // Get pointer to Status
+  TF_Status* status = (TF_Status*) args(2).uint64_value ();
+  // Get DeviceList and return its pointer
+  TF_DeviceList* devices = TF_SessionListDevices (session, status);
+  octave_uint64 ptr = (uint64_t) devices;
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// struct TF_SessionPoolStats(TF_Session* session)
+//
+// The number of Tensors fed to the Session whose buffer was taken from its
+// pool and of those for which one had to be allocated, the fraction of the
+// former, and the bytes of every buffer of the pool and of those idle in it.
+octave_value OCT_TF_SessionPoolStats (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_SessionPoolStats' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_SessionPoolStats' OCTAVE function.");
+  }
+  // Get pointer to Session
+  TF_Session* session = (TF_Session*) args(1).uint64_value ();
+  octave_value plhs = session_pool_stats (session);
+  return plhs;
+}
+
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TF_Runner classdef
+// -----------------------------------------------------------------------------
+
+// A Session with its feeds and fetches resolved once, so that each run only
+// converts the values and executes the Graph.  The Outputs are held in the
+// contiguous arrays TF_SessionRun takes, and the Status is reused by every
+// run.  The Session is not owned by the Runner and must outlive it.
+struct oct_tf_runner
+{
+  TF_Session* session;
+  vector<TF_Output> inputs;
+  vector<TF_Output> outputs;
+  bool native;
+  TF_Status* status;
+};
+
+// TF_Runner* TF_NewRunner(TF_Session* session, TF_Output* inputs,
+//                         TF_Output* outputs, string layout)
+//
+// The Outputs are copied into the Runner, so the caller may delete them as
+// soon as it is created.
+octave_value OCT_TF_NewRunner (OCT_ARGS)
+{
+  if (nrhs < 4)
+  {
+    error ("tensorflow: three extra arguments are required "
+           "for the 'TF_NewRunner' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_NewRunner' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (! args(2).isempty ()
+      && (! args(2).is_uint64_type () || args(2).rows () != 1))
+  {
+    error ("tensorflow: 3rd argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_NewRunner' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (! args(3).isempty ()
+      && (! args(3).is_uint64_type () || args(3).rows () != 1))
+  {
+    error ("tensorflow: 4th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_NewRunner' OCTAVE function.");
+  }
+  bool native = native_layout (args, nrhs, 4, "5th", "TF_NewRunner");
+  oct_tf_runner* runner = new oct_tf_runner;
+  runner->session = (TF_Session*) args(1).uint64_value ();
+  // Copy the input and output Outputs into contiguous arrays
+  uint64NDArray oct_inputs = args(2).uint64_array_value ();
+  for (octave_idx_type i = 0; i < oct_inputs.numel (); i++)
+  {
+    runner->inputs.push_back (*((TF_Output*) (uint64_t) oct_inputs(i)));
+  }
+  uint64NDArray oct_outputs = args(3).uint64_array_value ();
+  for (octave_idx_type i = 0; i < oct_outputs.numel (); i++)
+  {
+    runner->outputs.push_back (*((TF_Output*) (uint64_t) oct_outputs(i)));
+  }
+  runner->native = native;
+  runner->status = TF_NewStatus ();
+  octave_uint64 ptr = (uint64_t) runner;
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// void TF_DeleteRunner(TF_Runner* runner)
+void OCT_TF_DeleteRunner (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_DeleteRunner' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Runner
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Runner parsed to the 'TF_DeleteRunner' OCTAVE function.");
+  }
+  // Get pointer to Runner
+  oct_tf_runner* runner = (oct_tf_runner*) args(1).uint64_value ();
+  TF_DeleteStatus (runner->status);
+  delete runner;
+}
+
+// Cell TF_RunnerRun(TF_Runner* runner, Cell values, bool tensors)
+//
+// Each value is converted to a Tensor, the Graph is executed and each output
+// Tensor is converted back and released, all in one call.  The elements of
+// 'values' flagged by 'tensors' are uint64 pointers to Tensors owned by the
+// caller, which are fed as they are.
+octave_value OCT_TF_RunnerRun (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_RunnerRun' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Runner
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Runner parsed to the 'TF_RunnerRun' OCTAVE function.");
+  }
+  // Get pointer to Runner
+  oct_tf_runner* runner = (oct_tf_runner*) args(1).uint64_value ();
+  size_t ninputs = runner->inputs.size ();
+  size_t noutputs = runner->outputs.size ();
+  // Check octave_value type for input values
+  if (! args(2).iscell () || (size_t) args(2).numel () != ninputs)
+  {
+    error ("tensorflow: 3rd argument must be a cell array with one value per "
+           "input of the Runner parsed to the 'TF_RunnerRun' OCTAVE "
+           "function.");
+  }
+  Cell values = args(2).cell_value ();
+  // Check octave_value type for the values given as Tensors
+  boolNDArray tensors (dim_vector (1, ninputs), false);
+  if (nrhs > 3)
+  {
+    if (! args(3).islogical () || (size_t) args(3).numel () != ninputs)
+    {
+      error ("tensorflow: 4th argument must be a logical vector flagging the "
+             "values given as Tensors parsed to the 'TF_RunnerRun' OCTAVE "
+             "function.");
+    }
+    tensors = args(3).bool_array_value ();
+  }
+  Cell out = run_values (runner->session, runner->inputs.data (), values,
+                         tensors, ninputs, runner->outputs.data (), noutputs,
+                         runner->native, runner->status, "TF_RunnerRun");
+  octave_value plhs = out;
+  return plhs;
+}
+
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TF_AsyncRun classdef
+// -----------------------------------------------------------------------------
+
+// A run of a Session executing on a worker thread.  The values are converted
+// on the calling thread before it starts, since the Octave API must not be
+// used from another one, and the Tensors built from them are held until the
+// run is deleted.  The outputs are converted back when fetched.
+struct oct_tf_async_run
+{
+  TF_Session* session;
+  vector<TF_Output> inputs;
+  vector<TF_Output> outputs;
+  vector<TF_Tensor*> input_values;
+  tensor_list owned;
+  tensor_list output_values;
+  bool native;
+  TF_Status* status;
+  bool done;
+  bool fetched;
+  mutex mtx;
+  condition_variable cv;
+  thread worker;
+  oct_tf_async_run (size_t ninputs, size_t noutputs)
+    : owned (ninputs), output_values (noutputs), native (false),
+      status (TF_NewStatus ()), done (false), fetched (false) {}
+  // The Tensors are only released once the worker is done with them
+  ~oct_tf_async_run ()
+  {
+    if (worker.joinable ()) {worker.join ();}
+    TF_DeleteStatus (status);
+  }
+};
+
+// Wait for the run to complete, for at most 'timeout' seconds unless it is
+// infinite, and return whether it has.  The wait is sliced so that an interrupt
+// from the user is honoured while it lasts.
+static bool wait_async_run (oct_tf_async_run* run, double timeout)
+{
+  bool finite = std::isfinite (timeout) && timeout < 1e9;
+  auto slice = chrono::milliseconds (100);
+  auto until = chrono::steady_clock::now ()
+               + chrono::duration_cast<chrono::steady_clock::duration>
+                   (chrono::duration<double> (finite ? timeout : 0.0));
+  unique_lock<mutex> lock (run->mtx);
+  while (! run->done)
+  {
+    auto next = chrono::steady_clock::now () + slice;
+    if (finite)
+    {
+      if (chrono::steady_clock::now () >= until) {break;}
+      if (next > until) {next = until;}
+    }
+    run->cv.wait_until (lock, next, [run] () {return run->done;});
+    if (! run->done)
+    {
+      lock.unlock ();
+      octave_quit ();
+      lock.lock ();
+    }
+  }
+  return run->done;
+}
+
+// TF_AsyncRun* TF_SessionRunAsync(TF_Session* session, TF_Output* inputs,
+//                                 Cell values, TF_Output* outputs,
+//                                 string layout, bool tensors)
+//
+// As TF_SessionRunValues, except that the Session is run on a worker thread
+// and the call returns as soon as it has started.  The Tensors owned by the
+// caller among the values must be kept until the run is deleted.
+octave_value OCT_TF_SessionRunAsync (OCT_ARGS)
+{
+  if (nrhs < 5)
+  {
+    error ("tensorflow: four extra arguments are required "
+           "for the 'TF_SessionRunAsync' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_SessionRunAsync' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (! args(2).isempty ()
+      && (! args(2).is_uint64_type () || args(2).rows () != 1))
+  {
+    error ("tensorflow: 3rd argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_SessionRunAsync' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for input values
+  if (! args(3).iscell () || args(3).numel () != args(2).numel ())
+  {
+    error ("tensorflow: 4th argument must be a cell array with one value per "
+           "input Output parsed to the 'TF_SessionRunAsync' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (! args(4).isempty ()
+      && (! args(4).is_uint64_type () || args(4).rows () != 1))
+  {
+    error ("tensorflow: 5th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_SessionRunAsync' OCTAVE "
+           "function.");
+  }
+  bool native = native_layout (args, nrhs, 5, "6th", "TF_SessionRunAsync");
+  size_t ninputs = (size_t) args(2).numel ();
+  size_t noutputs = (size_t) args(4).numel ();
+  // Check octave_value type for the values given as Tensors
+  boolNDArray tensors (dim_vector (1, ninputs), false);
+  if (nrhs > 6)
+  {
+    if (! args(6).islogical () || (size_t) args(6).numel () != ninputs)
+    {
+      error ("tensorflow: 7th argument must be a logical vector flagging the "
+             "values given as Tensors parsed to the 'TF_SessionRunAsync' "
+             "OCTAVE function.");
+    }
+    tensors = args(6).bool_array_value ();
+  }
+  // Build the run, which releases what it holds if an error is raised
+  // before the worker starts
+  unique_ptr<oct_tf_async_run> run (new oct_tf_async_run (ninputs, noutputs));
+  run->session = (TF_Session*) args(1).uint64_value ();
+  uint64NDArray oct_inputs = args(2).uint64_array_value ();
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    run->inputs.push_back (*((TF_Output*) (uint64_t) oct_inputs(i)));
+  }
+  uint64NDArray oct_outputs = args(4).uint64_array_value ();
+  for (size_t i = 0; i < noutputs; i++)
+  {
+    run->outputs.push_back (*((TF_Output*) (uint64_t) oct_outputs(i)));
+  }
+  run->native = native;
+  run->input_values = load_values (run->session, run->inputs.data (),
+                                   args(3).cell_value (), tensors, ninputs,
+                                   native, run->owned, "TF_SessionRunAsync");
+  // Start the worker, which only touches the C API
+  oct_tf_async_run* r = run.get ();
+  try
+  {
+    r->worker = thread ([r] ()
+    {
+      session_run (r->session, nullptr,
+                   r->inputs.data (), r->input_values.data (),
+                   (int) r->inputs.size (),
+                   r->outputs.data (), r->output_values.tensors.data (),
+                   (int) r->outputs.size (), nullptr, 0, nullptr,
+                   r->status);
+      {
+        lock_guard<mutex> lock (r->mtx);
+        r->done = true;
+      }
+      r->cv.notify_all ();
+    });
+  }
+  catch (const system_error& e)
+  {
+    error ("tensorflow: the worker thread could not be started (%s) by the "
+           "'TF_SessionRunAsync' OCTAVE function.", e.what ());
+  }
+  octave_uint64 ptr = (uint64_t) run.release ();
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// bool TF_AsyncRunIsDone(TF_AsyncRun* run)
+octave_value OCT_TF_AsyncRunIsDone (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_AsyncRunIsDone' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to AsyncRun
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the AsyncRun parsed to the 'TF_AsyncRunIsDone' OCTAVE function.");
+  }
+  // Get pointer to AsyncRun
+  oct_tf_async_run* run = (oct_tf_async_run*) args(1).uint64_value ();
+  lock_guard<mutex> lock (run->mtx);
+  octave_value plhs = run->done;
+  return plhs;
+}
+
+// bool TF_AsyncRunWait(TF_AsyncRun* run, double timeout)
+//
+// Without a timeout, or with an infinite one, the call returns once the run
+// has completed.
+octave_value OCT_TF_AsyncRunWait (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_AsyncRunWait' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to AsyncRun
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the AsyncRun parsed to the 'TF_AsyncRunWait' OCTAVE function.");
+  }
+  // Check octave_value type for timeout
+  double timeout = numeric_limits<double>::infinity ();
+  if (nrhs > 2)
+  {
+    if (! args(2).is_real_scalar () || args(2).double_value () < 0)
+    {
+      error ("tensorflow: 3rd argument must be a non-negative real scalar "
+             "defining the timeout in seconds parsed to the "
+             "'TF_AsyncRunWait' OCTAVE function.");
+    }
+    timeout = args(2).double_value ();
+  }
+  // Get pointer to AsyncRun
+  oct_tf_async_run* run = (oct_tf_async_run*) args(1).uint64_value ();
+  octave_value plhs = wait_async_run (run, timeout);
+  return plhs;
+}
+
+// Cell TF_AsyncRunFetch(TF_AsyncRun* run)
+//
+// Wait for the run to complete and return its outputs, raising the message of
+// its Status as an error if it failed.  The outputs can be fetched once.
+octave_value OCT_TF_AsyncRunFetch (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_AsyncRunFetch' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to AsyncRun
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the AsyncRun parsed to the 'TF_AsyncRunFetch' OCTAVE function.");
+  }
+  // Get pointer to AsyncRun
+  oct_tf_async_run* run = (oct_tf_async_run*) args(1).uint64_value ();
+  wait_async_run (run, numeric_limits<double>::infinity ());
+  if (run->fetched)
+  {
+    error ("tensorflow: the outputs of the run have already been fetched "
+           "by the 'TF_AsyncRunFetch' OCTAVE function.");
+  }
+  run->fetched = true;
+  if (TF_GetCode (run->status) != TF_OK)
+  {
+    error ("tensorflow: %s", TF_Message (run->status));
+  }
+  Cell out = save_values (run->output_values, run->native);
+  octave_value plhs = out;
+  return plhs;
+}
+
+// void TF_DeleteAsyncRun(TF_AsyncRun* run)
+//
+// A run still executing is waited for, since the Tensors it is fed and those
+// it returns are released along with it.
+void OCT_TF_DeleteAsyncRun (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_DeleteAsyncRun' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to AsyncRun
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the AsyncRun parsed to the 'TF_DeleteAsyncRun' OCTAVE function.");
+  }
+  // Get pointer to AsyncRun
+  oct_tf_async_run* run = (oct_tf_async_run*) args(1).uint64_value ();
+  delete run;
+}
+
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TFModel classdef
+// -----------------------------------------------------------------------------
+
+// A request queued on a Batcher.  Its values are converted to Tensors when it
+// is submitted, and 'dims' holds the shape each is batched with, whose first
+// dimension is the number of rows the request contributes to the batch.  The
+// outputs are the rows of the batch outputs belonging to the request, or the
+// message of the failed run in 'message'.
+struct oct_tf_batch_request
+{
+  tensor_list values;
+  vector<vector<int64_t>> dims;
+  int64_t rows;
+  chrono::steady_clock::time_point arrival;
+  tensor_list outputs;
+  string message;
+  bool done;
+  oct_tf_batch_request (size_t ninputs, size_t noutputs)
+    : values (ninputs), dims (ninputs), rows (0), outputs (noutputs),
+      done (false) {}
+};
+
+// A queue of requests run in batches by a worker thread.  A batch is run once
+// its requests add up to 'max_batch' rows, once the oldest of them has waited
+// 'max_wait', or as soon as the result of one of them is asked for, since no
+// other request can then be submitted before it is returned.  Requests are
+// kept from the time they are submitted until they are collected, which is
+// what their tickets refer to.  The Session is not owned by the Batcher and
+// must outlive it.
+struct oct_tf_batcher
+{
+  TF_Session* session;
+  vector<TF_Output> inputs;
+  vector<TF_Output> outputs;
+  bool native;
+  int64_t max_batch;
+  chrono::steady_clock::duration max_wait;
+  mutex mtx;
+  condition_variable cv;
+  deque<shared_ptr<oct_tf_batch_request>> pending;
+  unordered_map<uint64_t, shared_ptr<oct_tf_batch_request>> requests;
+  int64_t pending_rows;
+  uint64_t next_ticket;
+  const oct_tf_batch_request* flush;
+  bool stop;
+  uint64_t num_requests;
+  uint64_t num_batches;
+  int64_t largest_batch;
+  thread worker;
+  oct_tf_batcher ()
+    : session (nullptr), native (false), max_batch (1),
+      max_wait (chrono::steady_clock::duration::zero ()), pending_rows (0),
+      next_ticket (1), flush (nullptr), stop (false), num_requests (0),
+      num_batches (0), largest_batch (0) {}
+  // Requests still pending are dropped, while a batch being run is waited for
+  ~oct_tf_batcher ()
+  {
+    {
+      lock_guard<mutex> lock (mtx);
+      stop = true;
+    }
+    cv.notify_all ();
+    if (worker.joinable ()) {worker.join ();}
+  }
+};
+
+// Wait on 'cv', with 'lock' held, until 'done' is set by a worker thread.  The
+// wait is sliced so that an interrupt from the user is honoured while it lasts.
+static void wait_until_done (unique_lock<mutex>& lock, condition_variable& cv,
+                             const bool& done)
+{
+  while (! done)
+  {
+    cv.wait_for (lock, chrono::milliseconds (100), [&done] () {return done;});
+    if (! done)
+    {
+      lock.unlock ();
+      octave_quit ();
+      lock.lock ();
+    }
+  }
+}
+
+// Whether two requests can share a batch, that is whether their values agree
+// in type and in every dimension but the first
+static bool same_batch_shape (const oct_tf_batch_request& a,
+                              const oct_tf_batch_request& b)
+{
+  for (size_t i = 0; i < a.dims.size (); i++)
+  {
+    if (TF_TensorType (a.values.tensors[i])
+        != TF_TensorType (b.values.tensors[i])
+        || a.dims[i].size () != b.dims[i].size ()
+        || ! equal (a.dims[i].begin () + 1, a.dims[i].end (),
+                    b.dims[i].begin () + 1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Deallocator of a batch input built over the buffer of a single request,
+// whose Tensor it takes over.  An output forwarding the input, as Identity
+// does, holds on to the buffer past the run and past the request itself, so
+// the Tensor of the request is only released along with the last of them.
+static void release_request_value (void* data, size_t len, void* arg)
+{
+  TF_DeleteTensor (static_cast<TF_Tensor*> (arg));
+}
+
+// Run a batch of requests in one call to TF_SessionRun and hand each request
+// its rows of every output.  Each input is the values of the requests laid
+// one after the other along the first dimension, which in row major storage
+// is their buffers laid end to end.  This runs on the worker thread and only
+// touches the C API.
+static void run_batch (oct_tf_batcher* b,
+                       const vector<shared_ptr<oct_tf_batch_request>>& batch,
+                       int64_t rows, TF_Status* status)
+{
+  size_t ninputs = b->inputs.size ();
+  size_t noutputs = b->outputs.size ();
+  const oct_tf_batch_request& first = *batch.front ();
+  // Concatenate the values of each input
+  tensor_list input_values (ninputs);
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    vector<int64_t> dims = first.dims[i];
+    dims[0] = rows;
+    TF_DataType type = TF_TensorType (first.values.tensors[i]);
+    if (batch.size () == 1)
+    {
+      TF_Tensor* value = first.values.tensors[i];
+      batch.front ()->values.tensors[i] = nullptr;
+      input_values.tensors[i] = TF_NewTensor (type, dims.data (),
+                                              (int) dims.size (),
+                                              TF_TensorData (value),
+                                              TF_TensorByteSize (value),
+                                              &release_request_value, value);
+    }
+    else
+    {
+      size_t len = 0;
+      for (const auto& r : batch)
+      {
+        len += TF_TensorByteSize (r->values.tensors[i]);
+      }
+      input_values.tensors[i] = TF_AllocateTensor (type, dims.data (),
+                                                   (int) dims.size (), len);
+      char* dst = (char*) TF_TensorData (input_values.tensors[i]);
+      for (const auto& r : batch)
+      {
+        size_t n = TF_TensorByteSize (r->values.tensors[i]);
+        memcpy (dst, TF_TensorData (r->values.tensors[i]), n);
+        dst += n;
+      }
+    }
+  }
+  // Run the Session
+  tensor_list output_values (noutputs);
+  session_run (b->session, nullptr,
+               b->inputs.data (), input_values.tensors.data (),
+               (int) ninputs,
+               b->outputs.data (), output_values.tensors.data (),
+               (int) noutputs, nullptr, 0, nullptr, status);
+  if (TF_GetCode (status) != TF_OK)
+  {
+    for (const auto& r : batch) {r->message = TF_Message (status);}
+    return;
+  }
+  // Split each output along its first dimension, handing it over whole to a
+  // batch of a single request
+  for (size_t j = 0; j < noutputs; j++)
+  {
+    TF_Tensor* out = output_values.tensors[j];
+    int num_dims = TF_NumDims (out);
+    if (num_dims < 1 || TF_Dim (out, 0) != rows)
+    {
+      char msg[160];
+      snprintf (msg, sizeof (msg), "output %d of the batch has no first "
+                "dimension of %" PRId64 " rows to be split between the "
+                "requests.", (int) j + 1, rows);
+      for (const auto& r : batch) {r->message = msg;}
+      return;
+    }
+    if (batch.size () == 1)
+    {
+      batch.front ()->outputs.tensors[j] = out;
+      output_values.tensors[j] = nullptr;
+      continue;
+    }
+    TF_DataType type = TF_TensorType (out);
+    vector<int64_t> dims (num_dims);
+    for (int k = 0; k < num_dims; k++) {dims[k] = TF_Dim (out, k);}
+    size_t row_len = TF_TensorByteSize (out) / (size_t) rows;
+    const char* src = (const char*) TF_TensorData (out);
+    for (const auto& r : batch)
+    {
+      dims[0] = r->rows;
+      size_t len = row_len * (size_t) r->rows;
+      TF_Tensor* slice = TF_AllocateTensor (type, dims.data (), num_dims, len);
+      memcpy (TF_TensorData (slice), src, len);
+      r->outputs.tensors[j] = slice;
+      src += len;
+    }
+  }
+}
+
+// Take the batches off the queue and run them until the Batcher is deleted
+static void batcher_loop (oct_tf_batcher* b)
+{
+  TF_Status* status = TF_NewStatus ();
+  unique_lock<mutex> lock (b->mtx);
+  while (true)
+  {
+    b->cv.wait (lock, [b] () {return b->stop || ! b->pending.empty ();});
+    if (b->stop) {break;}
+    // Wait for the batch to fill up, for the oldest request to have waited
+    // long enough, or for a result to be asked for
+    auto deadline = b->pending.front ()->arrival + b->max_wait;
+    b->cv.wait_until (lock, deadline, [b] ()
+    {
+      return b->stop || b->flush != nullptr || b->pending_rows >= b->max_batch;
+    });
+    if (b->stop) {break;}
+    // Take as many requests of the same shape as fit in a batch, and at least
+    // one however many rows it has
+    vector<shared_ptr<oct_tf_batch_request>> batch;
+    int64_t rows = 0;
+    while (! b->pending.empty ())
+    {
+      const shared_ptr<oct_tf_batch_request>& r = b->pending.front ();
+      if (! batch.empty () && (rows + r->rows > b->max_batch
+                               || ! same_batch_shape (*batch.front (), *r)))
+      {
+        break;
+      }
+      // The request asked for is about to run, so the rest may wait again
+      if (r.get () == b->flush) {b->flush = nullptr;}
+      rows += r->rows;
+      b->pending_rows -= r->rows;
+      batch.push_back (r);
+      b->pending.pop_front ();
+    }
+    lock.unlock ();
+    run_batch (b, batch, rows, status);
+    lock.lock ();
+    for (const auto& r : batch) {r->done = true;}
+    b->num_batches++;
+    b->largest_batch = max (b->largest_batch, rows);
+    // Let go of the requests before they can be collected, so that they are
+    // never released on this thread
+    batch.clear ();
+    b->cv.notify_all ();
+  }
+  lock.unlock ();
+  TF_DeleteStatus (status);
+}
+
+// TF_Batcher* TF_NewBatcher(TF_Session* session, TF_Output* inputs,
+//                           TF_Output* outputs, int64_t max_batch,
+//                           double max_wait, string layout)
+//
+// The Outputs are copied into the Batcher, so the caller may delete them as
+// soon as it is created.  The worker thread is started here.
+octave_value OCT_TF_NewBatcher (OCT_ARGS)
+{
+  if (nrhs < 6)
+  {
+    error ("tensorflow: five extra arguments are required "
+           "for the 'TF_NewBatcher' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Session
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Session parsed to the 'TF_NewBatcher' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to input Outputs
+  if (args(2).isempty () || ! args(2).is_uint64_type ()
+      || args(2).rows () != 1)
+  {
+    error ("tensorflow: 3rd argument must be an uint64 vector of pointers to "
+           "the input Outputs parsed to the 'TF_NewBatcher' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to output Outputs
+  if (args(3).isempty () || ! args(3).is_uint64_type ()
+      || args(3).rows () != 1)
+  {
+    error ("tensorflow: 4th argument must be an uint64 vector of pointers to "
+           "the output Outputs parsed to the 'TF_NewBatcher' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for the largest batch
+  if (! args(4).is_real_scalar () || args(4).double_value () < 1
+      || args(4).double_value () != std::floor (args(4).double_value ()))
+  {
+    error ("tensorflow: 5th argument must be a positive integer defining the "
+           "largest batch in rows parsed to the 'TF_NewBatcher' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for the longest wait
+  if (! args(5).is_real_scalar () || ! (args(5).double_value () >= 0)
+      || ! std::isfinite (args(5).double_value ()))
+  {
+    error ("tensorflow: 6th argument must be a non-negative real scalar "
+           "defining the longest wait in seconds parsed to the "
+           "'TF_NewBatcher' OCTAVE function.");
+  }
+  bool native = native_layout (args, nrhs, 6, "7th", "TF_NewBatcher");
+  unique_ptr<oct_tf_batcher> b (new oct_tf_batcher);
+  b->session = (TF_Session*) args(1).uint64_value ();
+  // Copy the input and output Outputs into contiguous arrays
+  uint64NDArray oct_inputs = args(2).uint64_array_value ();
+  for (octave_idx_type i = 0; i < oct_inputs.numel (); i++)
+  {
+    b->inputs.push_back (*((TF_Output*) (uint64_t) oct_inputs(i)));
+  }
+  uint64NDArray oct_outputs = args(3).uint64_array_value ();
+  for (octave_idx_type i = 0; i < oct_outputs.numel (); i++)
+  {
+    b->outputs.push_back (*((TF_Output*) (uint64_t) oct_outputs(i)));
+  }
+  b->native = native;
+  b->max_batch = (int64_t) args(4).double_value ();
+  b->max_wait = chrono::duration_cast<chrono::steady_clock::duration>
+                  (chrono::duration<double> (args(5).double_value ()));
+  // Start the worker, which only touches the C API
+  oct_tf_batcher* bp = b.get ();
+  try
+  {
+    b->worker = thread (batcher_loop, bp);
+  }
+  catch (const system_error& e)
+  {
+    error ("tensorflow: the worker thread could not be started (%s) by the "
+           "'TF_NewBatcher' OCTAVE function.", e.what ());
+  }
+  octave_uint64 ptr = (uint64_t) b.release ();
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// uint64_t TF_BatcherSubmit(TF_Batcher* batcher, Cell values)
+//
+// Convert the values of a request and queue it, returning the ticket its
+// outputs are collected with.  The values are laid along the first dimension
+// of the Octave arrays in row major layout, and along the last one in native
+// layout, and all of them must have as many rows.
+octave_value OCT_TF_BatcherSubmit (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_BatcherSubmit' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Batcher
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Batcher parsed to the 'TF_BatcherSubmit' OCTAVE function.");
+  }
+  // Get pointer to Batcher
+  oct_tf_batcher* b = (oct_tf_batcher*) args(1).uint64_value ();
+  size_t ninputs = b->inputs.size ();
+  // Check octave_value type for input values
+  if (! args(2).iscell () || (size_t) args(2).numel () != ninputs)
+  {
+    error ("tensorflow: 3rd argument must be a cell array with one value per "
+           "input of the Batcher parsed to the 'TF_BatcherSubmit' OCTAVE "
+           "function.");
+  }
+  Cell values = args(2).cell_value ();
+  auto r = make_shared<oct_tf_batch_request> (ninputs, b->outputs.size ());
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    if (values(i).is_string () || values(i).iscellstr ())
+    {
+      error ("tensorflow: value %d is a string, which cannot be batched by "
+             "the 'TF_BatcherSubmit' OCTAVE function.", (int) i + 1);
+    }
+    r->values.tensors[i] = load_input (values(i), b->native,
+                                       TF_OperationOutputType (b->inputs[i]));
+    // Keep every dimension, in the order of the Tensor, so that the rows lie
+    // along the first one
+    dim_vector oct_dims = values(i).dims ();
+    int num_dims = oct_dims.ndims ();
+    r->dims[i].resize (num_dims);
+    for (int k = 0; k < num_dims; k++)
+    {
+      r->dims[i][k] = oct_dims(b->native ? num_dims - 1 - k : k);
+    }
+    if (i == 0)
+    {
+      r->rows = r->dims[0][0];
+    }
+    else if (r->dims[i][0] != r->rows)
+    {
+      error ("tensorflow: value %d has %" PRId64 " rows instead of %" PRId64
+             " parsed to the 'TF_BatcherSubmit' OCTAVE function.",
+             (int) i + 1, r->dims[i][0], r->rows);
+    }
+  }
+  r->arrival = chrono::steady_clock::now ();
+  uint64_t ticket;
+  {
+    lock_guard<mutex> lock (b->mtx);
+    ticket = b->next_ticket++;
+    b->requests[ticket] = r;
+    b->pending.push_back (r);
+    b->pending_rows += r->rows;
+    b->num_requests++;
+  }
+  b->cv.notify_all ();
+  octave_uint64 ptr = ticket;
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// Cell TF_BatcherCollect(TF_Batcher* batcher, uint64_t ticket)
+//
+// Return the outputs of a request, running its batch straight away if it is
+// still queued, and raising the message of the run as an error if it failed.
+// Each ticket is collected once.
+octave_value OCT_TF_BatcherCollect (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_BatcherCollect' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Batcher
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Batcher parsed to the 'TF_BatcherCollect' OCTAVE function.");
+  }
+  // Check octave_value type for ticket
+  if (! args(2).is_uint64_type () || ! args(2).is_scalar_type ())
+  {
+    error ("tensorflow: 3rd argument must be an uint64 scalar ticket of a "
+           "request parsed to the 'TF_BatcherCollect' OCTAVE function.");
+  }
+  // Get pointer to Batcher
+  oct_tf_batcher* b = (oct_tf_batcher*) args(1).uint64_value ();
+  uint64_t ticket = args(2).uint64_value ();
+  shared_ptr<oct_tf_batch_request> r;
+  unique_lock<mutex> lock (b->mtx);
+  auto it = b->requests.find (ticket);
+  if (it == b->requests.end ())
+  {
+    error ("tensorflow: ticket %" PRIu64 " is not a request waiting to be "
+           "collected by the 'TF_BatcherCollect' OCTAVE function.", ticket);
+  }
+  r = it->second;
+  // Nothing more can be submitted until this returns, so run what is queued
+  // up to the request, unless it is already part of the batch being run
+  if (find (b->pending.begin (), b->pending.end (), r) != b->pending.end ())
+  {
+    b->flush = r.get ();
+    b->cv.notify_all ();
+  }
+  wait_until_done (lock, b->cv, r->done);
+  b->requests.erase (ticket);
+  lock.unlock ();
+  if (! r->message.empty ())
+  {
+    error ("tensorflow: %s", r->message.c_str ());
+  }
+  Cell out = save_values (r->outputs, b->native);
+  octave_value plhs = out;
+  return plhs;
+}
+
+// struct TF_BatcherStats(TF_Batcher* batcher)
+//
+// The number of requests submitted, of batches run, of the rows in the
+// largest batch and of the requests still queued.
+octave_value OCT_TF_BatcherStats (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_BatcherStats' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Batcher
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Batcher parsed to the 'TF_BatcherStats' OCTAVE function.");
+  }
+  // Get pointer to Batcher
+  oct_tf_batcher* b = (oct_tf_batcher*) args(1).uint64_value ();
+  octave_scalar_map stats;
+  lock_guard<mutex> lock (b->mtx);
+  stats.assign ("requests", (double) b->num_requests);
+  stats.assign ("batches", (double) b->num_batches);
+  stats.assign ("largest", (double) b->largest_batch);
+  stats.assign ("pending", (double) b->pending.size ());
+  octave_value plhs = stats;
+  return plhs;
+}
+
+// void TF_DeleteBatcher(TF_Batcher* batcher)
+//
+// Requests still queued are dropped and a batch being run is waited for.
+void OCT_TF_DeleteBatcher (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_DeleteBatcher' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to Batcher
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the Batcher parsed to the 'TF_DeleteBatcher' OCTAVE function.");
+  }
+  // Get pointer to Batcher
+  oct_tf_batcher* b = (oct_tf_batcher*) args(1).uint64_value ();
+  delete b;
+}
+
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TFModelPool classdef
+// -----------------------------------------------------------------------------
+
+// A request run by a ModelPool.  Its values are converted to Tensors when it
+// is submitted, and it holds its outputs, or the message of the failed run,
+// until it is collected.
+struct oct_tf_pool_job
+{
+  tensor_list values;
+  tensor_list outputs;
+  string message;
+  bool done;
+  oct_tf_pool_job (size_t ninputs, size_t noutputs)
+    : values (ninputs), outputs (noutputs), done (false) {}
+};
+
+// Runners over as many Sessions of the same model, each driven by a worker
+// thread of its own which runs the next queued request whenever its Session
+// is idle.  A Runner is used by its worker alone, Status included.  The
+// Runners are not owned by the pool and must outlive it.
+struct oct_tf_model_pool
+{
+  vector<oct_tf_runner*> runners;
+  mutex mtx;
+  condition_variable cv;
+  deque<shared_ptr<oct_tf_pool_job>> pending;
+  unordered_map<uint64_t, shared_ptr<oct_tf_pool_job>> jobs;
+  uint64_t next_ticket;
+  bool stop;
+  size_t busy;
+  uint64_t num_requests;
+  vector<uint64_t> runs;
+  vector<thread> workers;
+  oct_tf_model_pool ()
+    : next_ticket (1), stop (false), busy (0), num_requests (0) {}
+  // Requests still queued are dropped, while those being run are waited for
+  ~oct_tf_model_pool ()
+  {
+    {
+      lock_guard<mutex> lock (mtx);
+      stop = true;
+    }
+    cv.notify_all ();
+    for (thread& worker : workers)
+    {
+      if (worker.joinable ()) {worker.join ();}
+    }
+  }
+};
+
+// Run the queued requests on Runner 'k' until the pool is deleted
+static void model_pool_loop (oct_tf_model_pool* p, size_t k)
+{
+  oct_tf_runner* runner = p->runners[k];
+  unique_lock<mutex> lock (p->mtx);
+  while (true)
+  {
+    p->cv.wait (lock, [p] () {return p->stop || ! p->pending.empty ();});
+    if (p->stop) {break;}
+    shared_ptr<oct_tf_pool_job> job = p->pending.front ();
+    p->pending.pop_front ();
+    p->busy++;
+    lock.unlock ();
+    session_run (runner->session, nullptr,
+                 runner->inputs.data (), job->values.tensors.data (),
+                 (int) runner->inputs.size (),
+                 runner->outputs.data (), job->outputs.tensors.data (),
+                 (int) runner->outputs.size (), nullptr, 0, nullptr,
+                 runner->status);
+    string message;
+    if (TF_GetCode (runner->status) != TF_OK)
+    {
+      message = TF_Message (runner->status);
+    }
+    lock.lock ();
+    job->message = message;
+    job->done = true;
+    p->busy--;
+    p->runs[k]++;
+    // Let go of the request before it can be collected, so that it is never
+    // released on this thread
+    job.reset ();
+    p->cv.notify_all ();
+  }
+}
+
+// TF_ModelPool* TF_NewModelPool(TF_Runner** runners)
+//
+// The Runners must share their inputs, outputs and layout, over Sessions of
+// the same model.  One worker thread is started for each.
+octave_value OCT_TF_NewModelPool (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_NewModelPool' OCTAVE function.");
+  }
+  // Check octave_value type for pointers to Runners
+  if (args(1).isempty () || ! args(1).is_uint64_type ()
+      || args(1).rows () != 1)
+  {
+    error ("tensorflow: 2nd argument must be an uint64 vector of pointers to "
+           "the Runners parsed to the 'TF_NewModelPool' OCTAVE function.");
+  }
+  unique_ptr<oct_tf_model_pool> p (new oct_tf_model_pool);
+  uint64NDArray oct_runners = args(1).uint64_array_value ();
+  for (octave_idx_type i = 0; i < oct_runners.numel (); i++)
+  {
+    oct_tf_runner* runner = (oct_tf_runner*) (uint64_t) oct_runners(i);
+    const oct_tf_runner* first = i > 0 ? p->runners[0] : runner;
+    if (runner->inputs.size () != first->inputs.size ()
+        || runner->outputs.size () != first->outputs.size ()
+        || runner->native != first->native)
+    {
+      error ("tensorflow: Runner %d differs from the first in its inputs, "
+             "outputs or layout, parsed to the 'TF_NewModelPool' OCTAVE "
+             "function.", (int) i + 1);
+    }
+    p->runners.push_back (runner);
+  }
+  p->runs.assign (p->runners.size (), 0);
+  // Start the workers, which only touch the C API
+  try
+  {
+    for (size_t k = 0; k < p->runners.size (); k++)
+    {
+      p->workers.emplace_back (model_pool_loop, p.get (), k);
+    }
+  }
+  catch (const system_error& e)
+  {
+    error ("tensorflow: the worker threads could not be started (%s) by the "
+           "'TF_NewModelPool' OCTAVE function.", e.what ());
+  }
+  octave_uint64 ptr = (uint64_t) p.release ();
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// uint64_t TF_ModelPoolSubmit(TF_ModelPool* pool, Cell values)
+//
+// Convert the values of a request and queue it for the next idle Session,
+// returning the ticket its outputs are collected with
+octave_value OCT_TF_ModelPoolSubmit (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_ModelPoolSubmit' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to ModelPool
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the ModelPool parsed to the 'TF_ModelPoolSubmit' OCTAVE "
+           "function.");
+  }
+  // Get pointer to ModelPool
+  oct_tf_model_pool* p = (oct_tf_model_pool*) args(1).uint64_value ();
+  const oct_tf_runner* runner = p->runners[0];
+  size_t ninputs = runner->inputs.size ();
+  // Check octave_value type for input values
+  if (! args(2).iscell () || (size_t) args(2).numel () != ninputs)
+  {
+    error ("tensorflow: 3rd argument must be a cell array with one value per "
+           "input of the ModelPool parsed to the 'TF_ModelPoolSubmit' OCTAVE "
+           "function.");
+  }
+  Cell values = args(2).cell_value ();
+  auto job = make_shared<oct_tf_pool_job> (ninputs, runner->outputs.size ());
+  for (size_t i = 0; i < ninputs; i++)
+  {
+    job->values.tensors[i] =
+      load_input (values(i), runner->native,
+                  TF_OperationOutputType (runner->inputs[i]));
+  }
+  uint64_t ticket;
+  {
+    lock_guard<mutex> lock (p->mtx);
+    ticket = p->next_ticket++;
+    p->jobs[ticket] = job;
+    p->pending.push_back (job);
+    p->num_requests++;
+  }
+  p->cv.notify_one ();
+  octave_uint64 ptr = ticket;
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// Cell TF_ModelPoolCollect(TF_ModelPool* pool, uint64_t ticket)
+//
+// Wait for a request to be run and return its outputs, raising the message
+// of the run as an error if it failed.  Each ticket is collected once.
+octave_value OCT_TF_ModelPoolCollect (OCT_ARGS)
+{
+  if (nrhs < 3)
+  {
+    error ("tensorflow: two extra arguments are required "
+           "for the 'TF_ModelPoolCollect' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to ModelPool
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the ModelPool parsed to the 'TF_ModelPoolCollect' OCTAVE "
+           "function.");
+  }
+  // Check octave_value type for ticket
+  if (! args(2).is_uint64_type () || ! args(2).is_scalar_type ())
+  {
+    error ("tensorflow: 3rd argument must be an uint64 scalar ticket of a "
+           "request parsed to the 'TF_ModelPoolCollect' OCTAVE function.");
+  }
+  // Get pointer to ModelPool
+  oct_tf_model_pool* p = (oct_tf_model_pool*) args(1).uint64_value ();
+  uint64_t ticket = args(2).uint64_value ();
+  unique_lock<mutex> lock (p->mtx);
+  auto it = p->jobs.find (ticket);
+  if (it == p->jobs.end ())
+  {
+    error ("tensorflow: ticket %" PRIu64 " is not a request waiting to be "
+           "collected by the 'TF_ModelPoolCollect' OCTAVE function.", ticket);
+  }
+  shared_ptr<oct_tf_pool_job> job = it->second;
+  wait_until_done (lock, p->cv, job->done);
+  p->jobs.erase (ticket);
+  lock.unlock ();
+  if (! job->message.empty ())
+  {
+    error ("tensorflow: %s", job->message.c_str ());
+  }
+  Cell out = save_values (job->outputs, p->runners[0]->native);
+  octave_value plhs = out;
+  return plhs;
+}
+
+// struct TF_ModelPoolStats(TF_ModelPool* pool)
+//
+// The number of Sessions, of requests submitted, of requests queued and of
+// Sessions busy, and the number of runs made by each Session.
+octave_value OCT_TF_ModelPoolStats (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_ModelPoolStats' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to ModelPool
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the ModelPool parsed to the 'TF_ModelPoolStats' OCTAVE "
+           "function.");
+  }
+  // Get pointer to ModelPool
+  oct_tf_model_pool* p = (oct_tf_model_pool*) args(1).uint64_value ();
+  octave_scalar_map stats;
+  lock_guard<mutex> lock (p->mtx);
+  size_t n = p->runners.size ();
+  NDArray runs (dim_vector (1, n));
+  for (size_t k = 0; k < n; k++) {runs(k) = (double) p->runs[k];}
+  stats.assign ("sessions", (double) n);
+  stats.assign ("requests", (double) p->num_requests);
+  stats.assign ("pending", (double) p->pending.size ());
+  stats.assign ("busy", (double) p->busy);
+  stats.assign ("runs", runs);
+  octave_value plhs = stats;
+  return plhs;
+}
+
+// void TF_DeleteModelPool(TF_ModelPool* pool)
+//
+// Requests still queued are dropped and those being run are waited for.
+void OCT_TF_DeleteModelPool (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_DeleteModelPool' OCTAVE function.");
+  }
+  // Check octave_value type for pointer to ModelPool
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer to "
+           "the ModelPool parsed to the 'TF_DeleteModelPool' OCTAVE "
+           "function.");
+  }
+  // Get pointer to ModelPool
+  oct_tf_model_pool* p = (oct_tf_model_pool*) args(1).uint64_value ();
+  delete p;
+}
+
 // -----------------------------------------------------------------------------
 // C API functions referenced by the TF_DeviceList classdef
 // -----------------------------------------------------------------------------
@@ -17,85 +17,1344 @@ You should have received a copy of the GNU General Public License along with
 this program; if not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#if defined (__x86_64__) || defined (__i386__)
+#include <immintrin.h>
+#define OCT_TF_X86 1
+#endif
+
 #include "tensorflow.h"
 
 void NoOpDeallocator (void* data, size_t a, void* b) {}
 
+// Elements of 16 bytes, the complex types of double precision, are moved as a
+// pair of 8 byte words
+struct layout_elem16
+{
+  uint64_t lo;
+  uint64_t hi;
+};
+
+// Edge, in elements, of the square tiles the two innermost dimensions are
+// transposed in.  A tile of the source and one of the destination fit in the
+// L1 data cache for every element size.
+static const octave_idx_type layout_tile = 32;
+
+// Number of threads the layout conversion is split across.  It is read from
+// the OCT_TF_CONVERSION_THREADS environment variable on first use, unless set
+// before with TF_SetConversionThreads, and defaults to one.
+static std::atomic<int> layout_threads (-1);
+
+// Fewest bytes worth handing to a thread of its own.  Smaller arrays are
+// converted faster than threads are started, so they stay serial.
+static const size_t layout_thread_bytes = 1 << 20;
+
+static int conversion_threads (void)
+{
+  int n = layout_threads.load ();
+  if (n < 0)
+  {
+    n = 1;
+    const char* env = getenv ("OCT_TF_CONVERSION_THREADS");
+    if (env && atoi (env) > 0) {n = atoi (env);}
+    layout_threads.store (n);
+  }
+  return n;
+}
+
+// Element conversions applied while the elements are repositioned.  Each one
+// converts 'n' contiguous elements with run (dst, src, n), and layout_copy,
+// which copies them as they are, marks the plain repositioning.  They are
+// passed as objects, so that a conversion may carry parameters.
+struct layout_copy
+{
+  template <typename T>
+  static void run (T* dst, const T* src, size_t n)
+  {
+    memcpy (dst, src, n * sizeof (T));
+  }
+};
+
+static inline uint32_t float_bits (float f)
+{
+  uint32_t w;
+  memcpy (&w, &f, sizeof (w));
+  return w;
+}
+
+static inline float bits_float (uint32_t w)
+{
+  float f;
+  memcpy (&f, &w, sizeof (f));
+  return f;
+}
+
+// IEEE half precision from single precision, rounded to nearest even.  The
+// magnitude is scaled so that the float addition does the rounding, whether
+// the result is normal or subnormal, and overflows to infinity.
+static inline uint16_t half_from_float (float f)
+{
+  float base = (fabsf (f) * 0x1.0p+112f) * 0x1.0p-110f;
+  uint32_t w = float_bits (f);
+  uint32_t shl1_w = w + w;
+  uint32_t sign = w & 0x80000000u;
+  uint32_t bias = shl1_w & 0xff000000u;
+  if (bias < 0x71000000u) {bias = 0x71000000u;}
+  base = bits_float ((bias >> 1) + 0x07800000u) + base;
+  uint32_t bits = float_bits (base);
+  uint32_t nonsign = ((bits >> 13) & 0x7c00u) + (bits & 0x0fffu);
+  return (uint16_t) ((sign >> 16) | (shl1_w > 0xff000000u ? 0x7e00u : nonsign));
+}
+
+// Single precision from IEEE half precision, exactly
+static inline float half_to_float (uint16_t h)
+{
+  uint32_t w = (uint32_t) h << 16;
+  uint32_t sign = w & 0x80000000u;
+  uint32_t two_w = w + w;
+  float normalized = bits_float ((two_w >> 4) + (0xe0u << 23)) * 0x1.0p-112f;
+  float denormalized = bits_float ((two_w >> 17) | (126u << 23)) - 0.5f;
+  uint32_t result = sign | (two_w < (1u << 27) ? float_bits (denormalized)
+                                               : float_bits (normalized));
+  return bits_float (result);
+}
+
+// bfloat16 from single precision, rounded to nearest even, keeping NaN quiet
+static inline uint16_t bfloat16_from_float (float f)
+{
+  uint32_t w = float_bits (f);
+  if ((w & 0x7fffffffu) > 0x7f800000u) {return (uint16_t) ((w >> 16) | 0x40);}
+  return (uint16_t) ((w + 0x7fffu + ((w >> 16) & 1)) >> 16);
+}
+
+static inline float bfloat16_to_float (uint16_t b)
+{
+  return bits_float ((uint32_t) b << 16);
+}
+
+static void half_pack_scalar (uint16_t* dst, const float* src, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {dst[i] = half_from_float (src[i]);}
+}
+
+static void half_unpack_scalar (float* dst, const uint16_t* src, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {dst[i] = half_to_float (src[i]);}
+}
+
+#if defined (OCT_TF_X86)
+// Half precision conversions in hardware, eight elements at a time with F16C
+// and sixteen with AVX-512.  They are compiled for these extensions whatever
+// the target of the package, and only called once the processor is found to
+// support them.
+__attribute__ ((target ("avx,f16c")))
+static void half_pack_f16c (uint16_t* dst, const float* src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i h = _mm256_cvtps_ph (_mm256_loadu_ps (src + i),
+                                 _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128 ((__m128i*) (dst + i), h);
+  }
+  for (; i < n; i++) {dst[i] = _cvtss_sh (src[i], _MM_FROUND_TO_NEAREST_INT);}
+}
+
+__attribute__ ((target ("avx,f16c")))
+static void half_unpack_f16c (float* dst, const uint16_t* src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i h = _mm_loadu_si128 ((const __m128i*) (src + i));
+    _mm256_storeu_ps (dst + i, _mm256_cvtph_ps (h));
+  }
+  for (; i < n; i++) {dst[i] = _cvtsh_ss (src[i]);}
+}
+
+__attribute__ ((target ("avx512f")))
+static void half_pack_avx512 (uint16_t* dst, const float* src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    __m256i h = _mm512_cvtps_ph (_mm512_loadu_ps (src + i),
+                                 _MM_FROUND_TO_NEAREST_INT);
+    _mm256_storeu_si256 ((__m256i*) (dst + i), h);
+  }
+  half_pack_f16c (dst + i, src + i, n - i);
+}
+
+__attribute__ ((target ("avx512f")))
+static void half_unpack_avx512 (float* dst, const uint16_t* src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    __m256i h = _mm256_loadu_si256 ((const __m256i*) (src + i));
+    _mm512_storeu_ps (dst + i, _mm512_cvtph_ps (h));
+  }
+  half_unpack_f16c (dst + i, src + i, n - i);
+}
+#endif
+
+// Half precision conversions chosen once for the processor running Octave,
+// falling back to the portable ones
+typedef void (*half_pack_fn) (uint16_t*, const float*, size_t);
+typedef void (*half_unpack_fn) (float*, const uint16_t*, size_t);
+
+static half_pack_fn half_pack_select (void)
+{
+#if defined (OCT_TF_X86)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f")) {return half_pack_avx512;}
+  if (__builtin_cpu_supports ("avx") && __builtin_cpu_supports ("f16c"))
+  {
+    return half_pack_f16c;
+  }
+#endif
+  return half_pack_scalar;
+}
+
+static half_unpack_fn half_unpack_select (void)
+{
+#if defined (OCT_TF_X86)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f")) {return half_unpack_avx512;}
+  if (__builtin_cpu_supports ("avx") && __builtin_cpu_supports ("f16c"))
+  {
+    return half_unpack_f16c;
+  }
+#endif
+  return half_unpack_scalar;
+}
+
+// Elements of double precision are narrowed to single precision through a
+// buffer of this many elements, which stays in the L1 data cache
+static const size_t narrow_chunk = 256;
+
+// Double to single precision, rounding to nearest even as a cast does, four
+// elements at a time with AVX and eight with AVX-512 when the processor has
+// them
+static void narrow_scalar (float* dst, const double* src, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {dst[i] = (float) src[i];}
+}
+
+#if defined (OCT_TF_X86)
+__attribute__ ((target ("avx")))
+static void narrow_avx (float* dst, const double* src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    _mm_storeu_ps (dst + i, _mm256_cvtpd_ps (_mm256_loadu_pd (src + i)));
+    _mm_storeu_ps (dst + i + 4,
+                   _mm256_cvtpd_ps (_mm256_loadu_pd (src + i + 4)));
+  }
+  for (; i < n; i++) {dst[i] = (float) src[i];}
+}
+
+__attribute__ ((target ("avx512f")))
+static void narrow_avx512 (float* dst, const double* src, size_t n)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_ps (dst + i, _mm512_cvtpd_ps (_mm512_loadu_pd (src + i)));
+  }
+  narrow_avx (dst + i, src + i, n - i);
+}
+#endif
+
+typedef void (*narrow_fn) (float*, const double*, size_t);
+
+static narrow_fn narrow_select (void)
+{
+#if defined (OCT_TF_X86)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f")) {return narrow_avx512;}
+  if (__builtin_cpu_supports ("avx")) {return narrow_avx;}
+#endif
+  return narrow_scalar;
+}
+
+struct to_single
+{
+  static void run (float* dst, const double* src, size_t n)
+  {
+    static const narrow_fn narrow = narrow_select ();
+    narrow (dst, src, n);
+  }
+};
+
+struct to_double
+{
+  static void run (double* dst, const float* src, size_t n)
+  {
+    for (size_t i = 0; i < n; i++) {dst[i] = src[i];}
+  }
+};
+
+struct to_half
+{
+  static void run (uint16_t* dst, const float* src, size_t n)
+  {
+    static const half_pack_fn pack = half_pack_select ();
+    pack (dst, src, n);
+  }
+  static void run (uint16_t* dst, const double* src, size_t n)
+  {
+    float buf[narrow_chunk];
+    for (size_t i = 0; i < n; i += narrow_chunk)
+    {
+      size_t m = std::min (narrow_chunk, n - i);
+      to_single::run (buf, src + i, m);
+      run (dst + i, buf, m);
+    }
+  }
+};
+
+struct from_half
+{
+  static void run (float* dst, const uint16_t* src, size_t n)
+  {
+    static const half_unpack_fn unpack = half_unpack_select ();
+    unpack (dst, src, n);
+  }
+};
+
+// The bfloat16 conversions are a shift and a rounding of the bits of each
+// element, which the compiler vectorizes on its own
+struct to_bfloat16
+{
+  static void run (uint16_t* dst, const float* src, size_t n)
+  {
+    for (size_t i = 0; i < n; i++) {dst[i] = bfloat16_from_float (src[i]);}
+  }
+  static void run (uint16_t* dst, const double* src, size_t n)
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      dst[i] = bfloat16_from_float ((float) src[i]);
+    }
+  }
+};
+
+struct from_bfloat16
+{
+  static void run (float* dst, const uint16_t* src, size_t n)
+  {
+    for (size_t i = 0; i < n; i++) {dst[i] = bfloat16_to_float (src[i]);}
+  }
+};
+
+// 8 bit floating point with 'E' exponent and 'M' mantissa bits, either
+// E5M2, laid out as IEEE half precision cut to its upper byte, with infinity
+// and NaN, or E4M3FN, which has no infinity and a single NaN, S.1111.111,
+// and reaches 448 instead.  Both are rounded to nearest even from the bits of
+// single precision directly, so that no rounding is done twice.  As in
+// TensorFlow, magnitudes beyond the largest finite value become infinity in
+// E5M2 and NaN in E4M3FN.
+template <int E, int M, bool FN>
+struct float8_format
+{
+  static const int bias = (1 << (E - 1)) - 1;
+  static const uint8_t nan = FN ? 0x7f : 0x7e;
+  static const uint8_t overflow = FN ? 0x7f : 0x7c;
+  static const uint8_t max_finite = FN ? 0x7e : 0x7b;
+
+  static uint8_t from_float (float f)
+  {
+    uint32_t w = float_bits (f);
+    uint8_t sign = (uint8_t) ((w >> 24) & 0x80);
+    w &= 0x7fffffffu;
+    if (w > 0x7f800000u) {return sign | nan;}
+    int exp32 = (int) (w >> 23);
+    uint32_t man32 = w & 0x7fffffu;
+    int e = exp32 - 127 + bias;
+    if (e >= (1 << E)) {return sign | overflow;}
+    uint32_t code;
+    int shift;
+    if (e >= 1)
+    {
+      // Normal in the target format
+      shift = 23 - M;
+      code = ((uint32_t) e << M) | (man32 >> shift);
+    }
+    else
+    {
+      // Subnormal in the target format, or rounded to zero
+      if (exp32 == 0) {return sign;}
+      shift = 23 - M + 1 - e;
+      if (shift > 25) {return sign;}
+      man32 |= 0x800000u;
+      code = man32 >> shift;
+    }
+    uint32_t rem = man32 & ((1u << shift) - 1);
+    uint32_t half = 1u << (shift - 1);
+    if (rem > half || (rem == half && (code & 1))) {code++;}
+    if (code > max_finite) {return sign | overflow;}
+    return sign | (uint8_t) code;
+  }
+
+  static float to_float (uint8_t b)
+  {
+    float sign = (b & 0x80) ? -1.0f : 1.0f;
+    int exp = (b & 0x7f) >> M;
+    int man = b & ((1 << M) - 1);
+    if (FN && (b & 0x7f) == 0x7f) {return NAN;}
+    if (! FN && exp == (1 << E) - 1)
+    {
+      return man ? NAN : sign * INFINITY;
+    }
+    if (exp == 0) {return sign * ldexpf ((float) man, 1 - bias - M);}
+    return sign * ldexpf ((float) (man | (1 << M)), exp - bias - M);
+  }
+
+  // Every value of the format in single precision, for unpacking by lookup
+  static const float* table (void)
+  {
+    static const std::vector<float> values = []
+    {
+      std::vector<float> v (256);
+      for (int b = 0; b < 256; b++) {v[b] = to_float ((uint8_t) b);}
+      return v;
+    } ();
+    return values.data ();
+  }
+};
+
+typedef float8_format<5, 2, false> float8_e5m2;
+typedef float8_format<4, 3, true> float8_e4m3fn;
+
+template <typename F>
+struct to_float8
+{
+  static void run (uint8_t* dst, const float* src, size_t n)
+  {
+    for (size_t i = 0; i < n; i++) {dst[i] = F::from_float (src[i]);}
+  }
+  static void run (uint8_t* dst, const double* src, size_t n)
+  {
+    for (size_t i = 0; i < n; i++) {dst[i] = F::from_float ((float) src[i]);}
+  }
+};
+
+template <typename F>
+struct from_float8
+{
+  static void run (float* dst, const uint8_t* src, size_t n)
+  {
+    const float* table = F::table ();
+    for (size_t i = 0; i < n; i++) {dst[i] = table[src[i]];}
+  }
+};
+
+// TensorFlow holds a 4 bit integer in a byte of its own, sign extended for
+// TF_INT4.  Packing saturates the values of an int8 or uint8 array to the
+// range of 4 bits, as Octave does on integer conversion, and unpacking reads
+// the low 4 bits alone.
+struct to_int4
+{
+  static void run (int8_t* dst, const octave_int8* src, size_t n)
+  {
+    const int8_t* s = reinterpret_cast<const int8_t*> (src);
+    for (size_t i = 0; i < n; i++)
+    {
+      dst[i] = std::min<int8_t> (std::max<int8_t> (s[i], -8), 7);
+    }
+  }
+};
+
+struct from_int4
+{
+  static void run (octave_int8* dst, const int8_t* src, size_t n)
+  {
+    int8_t* d = reinterpret_cast<int8_t*> (dst);
+    for (size_t i = 0; i < n; i++)
+    {
+      d[i] = (int8_t) ((uint8_t) src[i] << 4) >> 4;
+    }
+  }
+};
+
+struct to_uint4
+{
+  static void run (uint8_t* dst, const octave_uint8* src, size_t n)
+  {
+    const uint8_t* s = reinterpret_cast<const uint8_t*> (src);
+    for (size_t i = 0; i < n; i++) {dst[i] = std::min<uint8_t> (s[i], 15);}
+  }
+};
+
+struct from_uint4
+{
+  static void run (octave_uint8* dst, const uint8_t* src, size_t n)
+  {
+    uint8_t* d = reinterpret_cast<uint8_t*> (dst);
+    for (size_t i = 0; i < n; i++) {d[i] = src[i] & 0x0f;}
+  }
+};
+
+// Quantized integers of type 'S' to single precision, as the difference from
+// the zero point times the scale
+template <typename S>
+struct dequantize
+{
+  float scale;
+  float zero_point;
+  void run (float* dst, const S* src, size_t n) const
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      dst[i] = ((float) src[i] - zero_point) * scale;
+    }
+  }
+};
+
+// Transpose between column major and row major storage, for elements of type
+// 'T' and at least two dimensions of length greater than one.  The first and
+// the last dimension are the innermost of either layout, so they are copied in
+// tiles, one contiguous in the source and the other in the destination, while
+// the dimensions in between are walked with both offsets updated
+// incrementally rather than recomputed for every element.  Only positions
+// 'lo' to 'hi' along the outermost dimension of the destination are copied,
+// which splits the destination into disjoint slabs.  Elements of type 'S' are
+// converted to type 'D' by 'conv' on the way, a segment of the destination
+// at a time, unless it is a layout_copy.
+template <typename D, typename S, typename C = layout_copy>
+static void transpose_layout (D* dst, const S* src,
+                              const vector<octave_idx_type>& dims,
+                              bool to_row_major,
+                              octave_idx_type lo, octave_idx_type hi,
+                              const C& conv = C ())
+{
+  const bool copy = std::is_same<C, layout_copy>::value;
+  S buf[layout_tile];
+  int nd = dims.size ();
+  // Distance between consecutive elements along each dimension in column
+  // major and in row major storage
+  vector<octave_idx_type> cstride (nd);
+  vector<octave_idx_type> rstride (nd);
+  octave_idx_type stride = 1;
+  for (int k = 0; k < nd; k++)
+  {
+    cstride[k] = stride;
+    stride *= dims[k];
+  }
+  stride = 1;
+  for (int k = nd - 1; k >= 0; k--)
+  {
+    rstride[k] = stride;
+    stride *= dims[k];
+  }
+  const vector<octave_idx_type>& sstride = to_row_major ? cstride : rstride;
+  const vector<octave_idx_type>& dstride = to_row_major ? rstride : cstride;
+  // The first dimension is outermost in row major storage, the last one in
+  // column major storage
+  octave_idx_type a_lo = to_row_major ? lo : 0;
+  octave_idx_type a_hi = to_row_major ? hi : dims[0];
+  octave_idx_type b_lo = to_row_major ? 0 : lo;
+  octave_idx_type b_hi = to_row_major ? dims[nd-1] : hi;
+  octave_idx_type sa = sstride[0];
+  octave_idx_type sb = sstride[nd-1];
+  octave_idx_type da = dstride[0];
+  octave_idx_type db = dstride[nd-1];
+  // Number of positions along the dimensions in between
+  octave_idx_type nmid = 1;
+  for (int k = 1; k < nd - 1; k++) {nmid *= dims[k];}
+  vector<octave_idx_type> index (nd, 0);
+  octave_idx_type soff = 0;
+  octave_idx_type doff = 0;
+  for (octave_idx_type m = 0; m < nmid; m++)
+  {
+    const S* s = src + soff;
+    D* d = dst + doff;
+    for (octave_idx_type a0 = a_lo; a0 < a_hi; a0 += layout_tile)
+    {
+      octave_idx_type a1 = std::min (a0 + layout_tile, a_hi);
+      for (octave_idx_type b0 = b_lo; b0 < b_hi; b0 += layout_tile)
+      {
+        octave_idx_type b1 = std::min (b0 + layout_tile, b_hi);
+        if (to_row_major)
+        {
+          // Destination contiguous along the last dimension
+          for (octave_idx_type a = a0; a < a1; a++)
+          {
+            D* drow = d + a * da;
+            const S* scol = s + a;
+            if (copy)
+            {
+              for (octave_idx_type b = b0; b < b1; b++)
+              {
+                drow[b] = scol[b * sb];
+              }
+            }
+            else
+            {
+              for (octave_idx_type b = b0; b < b1; b++)
+              {
+                buf[b - b0] = scol[b * sb];
+              }
+              conv.run (drow + b0, buf, b1 - b0);
+            }
+          }
+        }
+        else
+        {
+          // Destination contiguous along the first dimension
+          for (octave_idx_type b = b0; b < b1; b++)
+          {
+            D* dcol = d + b * db;
+            const S* srow = s + b;
+            if (copy)
+            {
+              for (octave_idx_type a = a0; a < a1; a++)
+              {
+                dcol[a] = srow[a * sa];
+              }
+            }
+            else
+            {
+              for (octave_idx_type a = a0; a < a1; a++)
+              {
+                buf[a - a0] = srow[a * sa];
+              }
+              conv.run (dcol + a0, buf, a1 - a0);
+            }
+          }
+        }
+      }
+    }
+    // Advance the index of the dimensions in between, in the order the
+    // destination is laid out so that it is written front to back
+    for (int i = 1; i < nd - 1; i++)
+    {
+      int k = to_row_major ? nd - 1 - i : i;
+      soff += sstride[k];
+      doff += dstride[k];
+      if (++index[k] < dims[k]) {break;}
+      soff -= sstride[k] * dims[k];
+      doff -= dstride[k] * dims[k];
+      index[k] = 0;
+    }
+  }
+}
+
+// Split the transpose across the conversion threads, each one writing its own
+// slab of the destination, or run it on the calling thread when the array is
+// too small or the outermost dimension too short to share.
+template <typename D, typename S, typename C = layout_copy>
+static void split_layout (D* dst, const S* src,
+                          const vector<octave_idx_type>& dims,
+                          bool to_row_major, size_t nbytes,
+                          const C& conv = C ())
+{
+  octave_idx_type outer = to_row_major ? dims.front () : dims.back ();
+  octave_idx_type nthreads = conversion_threads ();
+  nthreads = std::min (nthreads, (octave_idx_type) (nbytes / layout_thread_bytes));
+  nthreads = std::min (nthreads, outer);
+  if (nthreads < 2)
+  {
+    transpose_layout (dst, src, dims, to_row_major, 0, outer, conv);
+    return;
+  }
+  vector<std::thread> workers;
+  octave_idx_type lo = 0;
+  for (octave_idx_type t = 0; t < nthreads; t++)
+  {
+    octave_idx_type hi = outer * (t + 1) / nthreads;
+    // The last slab is left to the calling thread
+    if (t == nthreads - 1)
+    {
+      transpose_layout (dst, src, dims, to_row_major, lo, hi, conv);
+    }
+    else
+    {
+      workers.emplace_back (transpose_layout<D, S, C>, dst, src,
+                            std::cref (dims), to_row_major, lo, hi,
+                            std::cref (conv));
+    }
+    lo = hi;
+  }
+  for (auto& w : workers) {w.join ();}
+}
+
 // Copy the elements of an array between Octave's column major storage and
 // TensorFlow's row major storage.  Both layouts describe the same array of
 // 'num_dims' dimensions given by 'dims', so only the position of each element
-// within the buffer changes, not the shape.  With fewer than two dimensions
-// the two layouts coincide and the data is copied as it is.
+// within the buffer changes, not the shape.  Dimensions of length one do not
+// affect the position of any element and are dropped, and with fewer than two
+// remaining the two layouts coincide and the data is copied as it is.
 static void copy_layout (char* dst, const char* src,
                          const octave_idx_type* dims, int num_dims,
                          size_t esize, octave_idx_type nelem,
                          bool to_row_major)
 {
-  if (num_dims < 2)
+  trace_scope scope ("copy_layout", "convert");
+  vector<octave_idx_type> sz;
+  for (int k = 0; k < num_dims; k++)
+  {
+    if (dims[k] != 1) {sz.push_back (dims[k]);}
+  }
+  size_t nbytes = esize * (size_t) nelem;
+  if (sz.size () < 2 || nelem == 0)
+  {
+    memcpy (dst, src, nbytes);
+    return;
+  }
+  switch (esize)
+  {
+    case 1:
+      split_layout ((uint8_t*) dst, (const uint8_t*) src, sz, to_row_major,
+                    nbytes);
+      break;
+    case 2:
+      split_layout ((uint16_t*) dst, (const uint16_t*) src, sz, to_row_major,
+                    nbytes);
+      break;
+    case 4:
+      split_layout ((uint32_t*) dst, (const uint32_t*) src, sz, to_row_major,
+                    nbytes);
+      break;
+    case 8:
+      split_layout ((uint64_t*) dst, (const uint64_t*) src, sz, to_row_major,
+                    nbytes);
+      break;
+    case 16:
+      split_layout ((layout_elem16*) dst, (const layout_elem16*) src, sz,
+                    to_row_major, nbytes);
+      break;
+  }
+}
+
+// Copy the elements of an array between the two storage orders as
+// copy_layout does, converting them from type 'S' to type 'D' with 'conv' in
+// the same pass, so that the source is read only once.
+template <typename C, typename D, typename S>
+static void convert_layout (D* dst, const S* src,
+                            const octave_idx_type* dims, int num_dims,
+                            octave_idx_type nelem, bool to_row_major,
+                            const C& conv = C ())
+{
+  trace_scope scope ("convert_layout", "convert");
+  vector<octave_idx_type> sz;
+  for (int k = 0; k < num_dims; k++)
+  {
+    if (dims[k] != 1) {sz.push_back (dims[k]);}
+  }
+  if (sz.size () < 2 || nelem == 0)
   {
-    memcpy (dst, src, esize * (size_t) nelem);
+    conv.run (dst, src, (size_t) nelem);
     return;
   }
-  // Distance between consecutive elements along each dimension in column
-  // major storage
-  vector<octave_idx_type> cstride (num_dims);
-  octave_idx_type stride = 1;
+  split_layout (dst, src, sz, to_row_major, sizeof (D) * (size_t) nelem,
+                conv);
+}
+
+// True when column major and row major storage of an array of 'num_dims'
+// dimensions given by 'dims' coincide, that is when at most one dimension is
+// of length greater than one.
+static bool same_layout (const octave_idx_type* dims, int num_dims)
+{
+  int n = 0;
   for (int k = 0; k < num_dims; k++)
   {
-    cstride[k] = stride;
-    stride *= dims[k];
+    if (dims[k] != 1) {n++;}
   }
-  // Walk the array in row major order, so that the row major offset is the
-  // counter itself, and accumulate the column major offset from the index
-  vector<octave_idx_type> index (num_dims, 0);
-  for (octave_idx_type r = 0; r < nelem; r++)
+  return n < 2;
+}
+
+// Buffers of Octave arrays currently borrowed by a Tensor.  Octave writes to
+// an array in place when nothing else refers to it, so these must never become
+// the storage of an array built over the buffer of a Tensor.  Deallocators may
+// run on TensorFlow's threads, hence the lock.
+static std::mutex borrowed_mutex;
+static std::unordered_multiset<const void*> borrowed_buffers;
+
+static bool is_borrowed (const void* data)
+{
+  std::lock_guard<std::mutex> lock (borrowed_mutex);
+  return borrowed_buffers.count (data) > 0;
+}
+
+// Deallocator of a Tensor borrowing the buffer of an Octave array, dropping
+// the reference to the array held on its behalf
+template <typename A>
+static void release_array (void* data, size_t len, void* arg)
+{
+  {
+    std::lock_guard<std::mutex> lock (borrowed_mutex);
+    auto it = borrowed_buffers.find (data);
+    if (it != borrowed_buffers.end ()) {borrowed_buffers.erase (it);}
+  }
+  delete static_cast<A*> (arg);
+}
+
+// Buffers of the Tensors fed to a Session, kept once the Tensors are released
+// so that the next run feeding a Tensor of the same data type and shape takes
+// one instead of allocating it.  Each buffer is lent to one Tensor at a time,
+// whose deallocator, which may run on TensorFlow's threads, gives it back.
+// The pool of a deleted Session frees its idle buffers at once and lent ones
+// as they come back, the pool itself going with the last of them.
+
+// Alignment of the buffers, that of TensorFlow's own allocations, below which
+// TF_NewTensor would copy the buffer
+static const size_t pool_alignment = 64;
+
+// Most bytes a pool keeps idle.  A buffer given back beyond it is freed.
+static const size_t pool_idle_limit = (size_t) 256 << 20;
+
+struct tensor_pool;
+
+// A buffer of a pool along with the data type and dimensions it is kept for.
+// The record stays with the buffer, so that lending it allocates nothing.
+struct pool_buffer
+{
+  tensor_pool* pool;
+  std::vector<int64_t> key;
+  void* data;
+  size_t bytes;
+};
+
+struct tensor_pool
+{
+  std::mutex mtx;
+  std::map<std::vector<int64_t>, std::vector<pool_buffer*>> idle;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  size_t bytes_held = 0;
+  size_t bytes_idle = 0;
+  size_t lent = 0;
+  bool closed = false;
+};
+
+static void free_pool_buffer (pool_buffer* buf)
+{
+  free (buf->data);
+  delete buf;
+}
+
+// Deallocator of a Tensor over a pooled buffer, giving the buffer back
+static void pool_release (void* data, size_t len, void* arg)
+{
+  pool_buffer* buf = static_cast<pool_buffer*> (arg);
+  tensor_pool* pool = buf->pool;
+  bool last;
   {
-    octave_idx_type c = 0;
-    for (int k = 0; k < num_dims; k++) {c += index[k] * cstride[k];}
-    if (to_row_major)
+    std::lock_guard<std::mutex> lock (pool->mtx);
+    pool->lent--;
+    if (! pool->closed && pool->bytes_idle + buf->bytes <= pool_idle_limit)
     {
-      memcpy (dst + r * esize, src + c * esize, esize);
+      pool->idle[buf->key].push_back (buf);
+      pool->bytes_idle += buf->bytes;
+      buf = nullptr;
     }
     else
     {
-      memcpy (dst + c * esize, src + r * esize, esize);
+      pool->bytes_held -= buf->bytes;
     }
-    // Advance the index, last dimension varying fastest
-    for (int k = num_dims - 1; k >= 0; k--)
+    last = pool->closed && pool->lent == 0;
+  }
+  if (buf) {free_pool_buffer (buf);}
+  if (last) {delete pool;}
+}
+
+// Build a Tensor over a buffer of the pool, idle or newly allocated
+static TF_Tensor* pool_tensor (tensor_pool* pool, TF_DataType type,
+                               const octave_idx_type* tf_dims, int num_dims,
+                               size_t len)
+{
+  std::vector<int64_t> key (1, (int64_t) type);
+  key.insert (key.end (), tf_dims, tf_dims + num_dims);
+  pool_buffer* buf = nullptr;
+  {
+    std::lock_guard<std::mutex> lock (pool->mtx);
+    auto it = pool->idle.find (key);
+    if (it != pool->idle.end () && ! it->second.empty ())
     {
-      if (++index[k] < dims[k]) {break;}
-      index[k] = 0;
+      buf = it->second.back ();
+      it->second.pop_back ();
+      pool->bytes_idle -= buf->bytes;
+      pool->hits++;
+      pool->lent++;
+    }
+  }
+  if (! buf)
+  {
+    size_t bytes = std::max (len, (size_t) 1);
+    bytes = (bytes + pool_alignment - 1) / pool_alignment * pool_alignment;
+    void* data = aligned_alloc (pool_alignment, bytes);
+    if (! data) {return TF_AllocateTensor (type, tf_dims, num_dims, len);}
+    buf = new pool_buffer {pool, std::move (key), data, bytes};
+    std::lock_guard<std::mutex> lock (pool->mtx);
+    pool->misses++;
+    pool->lent++;
+    pool->bytes_held += bytes;
+  }
+  return TF_NewTensor (type, tf_dims, num_dims, buf->data, len,
+                       &pool_release, buf);
+}
+
+// The pool of each Session that was fed pooled Tensors, created on first use
+static std::mutex session_pools_mutex;
+static std::unordered_map<TF_Session*, tensor_pool*> session_pools;
+
+tensor_pool* session_pool (TF_Session* session)
+{
+  std::lock_guard<std::mutex> lock (session_pools_mutex);
+  tensor_pool*& pool = session_pools[session];
+  if (! pool) {pool = new tensor_pool;}
+  return pool;
+}
+
+void delete_session_pool (TF_Session* session)
+{
+  tensor_pool* pool;
+  {
+    std::lock_guard<std::mutex> lock (session_pools_mutex);
+    auto it = session_pools.find (session);
+    if (it == session_pools.end ()) {return;}
+    pool = it->second;
+    session_pools.erase (it);
+  }
+  std::vector<pool_buffer*> idle;
+  bool last;
+  {
+    std::lock_guard<std::mutex> lock (pool->mtx);
+    for (auto& entry : pool->idle)
+    {
+      idle.insert (idle.end (), entry.second.begin (), entry.second.end ());
+    }
+    pool->idle.clear ();
+    pool->bytes_held -= pool->bytes_idle;
+    pool->bytes_idle = 0;
+    pool->closed = true;
+    last = pool->lent == 0;
+  }
+  for (pool_buffer* buf : idle) {free_pool_buffer (buf);}
+  if (last) {delete pool;}
+}
+
+octave_scalar_map session_pool_stats (TF_Session* session)
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  size_t held = 0;
+  size_t idle = 0;
+  {
+    std::lock_guard<std::mutex> lock (session_pools_mutex);
+    auto it = session_pools.find (session);
+    if (it != session_pools.end ())
+    {
+      tensor_pool* pool = it->second;
+      std::lock_guard<std::mutex> pool_lock (pool->mtx);
+      hits = pool->hits;
+      misses = pool->misses;
+      held = pool->bytes_held;
+      idle = pool->bytes_idle;
+    }
+  }
+  octave_scalar_map stats;
+  stats.assign ("hits", (double) hits);
+  stats.assign ("misses", (double) misses);
+  stats.assign ("rate", hits + misses ? (double) hits / (hits + misses) : 0.0);
+  stats.assign ("held", (double) held);
+  stats.assign ("idle", (double) idle);
+  return stats;
+}
+
+// Pool the Tensors of the enclosing pool_scope on this thread take their
+// buffer from, if any
+static thread_local tensor_pool* active_pool = nullptr;
+
+pool_scope::pool_scope (tensor_pool* pool) : prev (active_pool)
+{
+  active_pool = pool;
+}
+
+pool_scope::~pool_scope ()
+{
+  active_pool = prev;
+}
+
+// Allocate a Tensor whose buffer the caller fills, from the pool of the
+// enclosing pool_scope when there is one
+static TF_Tensor* allocate_tensor (TF_DataType type,
+                                   const octave_idx_type* tf_dims,
+                                   int num_dims, size_t len)
+{
+  trace_scope scope ("TF_AllocateTensor", "allocate");
+  if (active_pool)
+  {
+    return pool_tensor (active_pool, type, tf_dims, num_dims, len);
+  }
+  return TF_AllocateTensor (type, tf_dims, num_dims, len);
+}
+
+// Build a Tensor of type 'type' holding the elements of an Octave array, of
+// 'num_dims' dimensions given by 'tf_dims', repositioning them over 'copy_dims'
+// dimensions, which are none in native layout.  When the two storage orders
+// coincide the Tensor borrows the buffer of the array instead of copying it,
+// holding a reference to the array that its deallocator drops.  Octave's copy
+// on write then keeps the buffer alive and unchanged for as long as the Tensor
+// lives, since any later change to the array is made to a copy of its own.
+// TensorFlow itself copies a borrowed buffer that is not aligned as it needs,
+// releasing the reference straight away.
+template <typename A>
+static TF_Tensor* load_array (TF_DataType type, const A& oct_data,
+                              const octave_idx_type* tf_dims, int num_dims,
+                              int copy_dims)
+{
+  size_t len = TF_DataTypeSize (type) * (size_t) oct_data.numel ();
+  if (same_layout (tf_dims, copy_dims))
+  {
+    A* ref = new A (oct_data);
+    {
+      std::lock_guard<std::mutex> lock (borrowed_mutex);
+      borrowed_buffers.insert (ref->data ());
+    }
+    return TF_NewTensor (type, tf_dims, num_dims, (void*) ref->data (), len,
+                         &release_array<A>, ref);
+  }
+  TF_Tensor* tensor = allocate_tensor (type, tf_dims, num_dims, len);
+  copy_layout ((char*) TF_TensorData (tensor), (const char*) oct_data.data (),
+               tf_dims, copy_dims, TF_DataTypeSize (type), oct_data.numel (),
+               true);
+  return tensor;
+}
+
+// Build a Tensor of type 'type', whose elements are of type 'D', from an
+// Octave array of another type, converting the elements with 'C' as they are
+// repositioned over 'copy_dims' dimensions
+template <typename D, typename C, typename A>
+static TF_Tensor* load_converted (TF_DataType type, const A& oct_data,
+                                  const octave_idx_type* tf_dims, int num_dims,
+                                  int copy_dims)
+{
+  octave_idx_type nelem = oct_data.numel ();
+  size_t len = sizeof (D) * (size_t) nelem;
+  TF_Tensor* tensor = allocate_tensor (type, tf_dims, num_dims, len);
+  convert_layout<C> ((D*) TF_TensorData (tensor), oct_data.data (), tf_dims,
+                     copy_dims, nelem, true);
+  return tensor;
+}
+
+#if defined (OCTAVE_HAVE_STD_PMR_POLYMORPHIC_ALLOCATOR)
+// Memory resource of an Octave array whose storage is the buffer of a Tensor,
+// one per Tensor.  It never allocates, and releasing the buffer, which Octave
+// does once no value refers to the array any more, deletes the Tensor along
+// with the resource itself.  Any copy Octave makes of the array, such as on
+// writing to a shared one, is allocated by the default resource instead.
+class tensor_memory_resource : public std::pmr::memory_resource
+{
+public:
+  tensor_memory_resource (TF_Tensor* tensor) : m_tensor (tensor) { }
+
+private:
+  void* do_allocate (size_t bytes, size_t alignment)
+  {
+    throw std::bad_alloc ();
+  }
+  void do_deallocate (void* ptr, size_t bytes, size_t alignment)
+  {
+    TF_DeleteTensor (m_tensor);
+    delete this;
+  }
+  bool do_is_equal (const std::pmr::memory_resource& other) const noexcept
+  {
+    return this == &other;
+  }
+
+  TF_Tensor* m_tensor;
+};
+#endif
+
+// Build an Octave array of type 'A' and dimensions 'oct_dims' holding the
+// elements of a Tensor of dimensions 'tf_dims', repositioning them over
+// 'copy_dims' dimensions, which are none in native layout.  With 'release' the
+// Tensor is handed over and deleted here.  When the two storage orders then
+// coincide, and neither TensorFlow nor an Octave array holds another reference
+// to the buffer, the array is built over the buffer of the Tensor instead of a
+// copy of it, and the Tensor is deleted along with the array.
+template <typename A>
+static octave_value save_array (TF_Tensor* tensor, const dim_vector& oct_dims,
+                                const vector<octave_idx_type>& tf_dims,
+                                int copy_dims, bool release)
+{
+  typedef typename A::element_type T;
+  octave_idx_type nelem = (octave_idx_type) TF_TensorElementCount (tensor);
+#if defined (OCTAVE_HAVE_STD_PMR_POLYMORPHIC_ALLOCATOR)
+  if (release && nelem > 0 && same_layout (tf_dims.data (), copy_dims))
+  {
+    // The Tensor handed back takes the place of the one moved, which is only
+    // left untouched when its buffer cannot be moved
+    TF_Tensor* moved = TF_TensorMaybeMove (tensor);
+    if (moved)
+    {
+      tensor = moved;
+      if (! is_borrowed (TF_TensorData (tensor)))
+      {
+        std::pmr::memory_resource* mr = new tensor_memory_resource (tensor);
+        return A ((T*) TF_TensorData (tensor), oct_dims, mr);
+      }
     }
   }
+#endif
+  A oct_data(oct_dims);
+  copy_layout ((char*) oct_data.fortran_vec (),
+               (const char*) TF_TensorData (tensor), tf_dims.data (),
+               copy_dims, sizeof (T), nelem, false);
+  if (release) {TF_DeleteTensor (tensor);}
+  return oct_data;
+}
+
+// Build an Octave array of type 'A' from a Tensor whose elements are of type
+// 'S', converting them with 'conv' as they are repositioned over 'copy_dims'
+// dimensions.  With 'release' the Tensor is handed over and deleted here.
+template <typename A, typename C, typename S>
+static octave_value save_converted (TF_Tensor* tensor,
+                                    const dim_vector& oct_dims,
+                                    const vector<octave_idx_type>& tf_dims,
+                                    int copy_dims, bool release,
+                                    const C& conv = C ())
+{
+  octave_idx_type nelem = (octave_idx_type) TF_TensorElementCount (tensor);
+  A oct_data(oct_dims);
+  convert_layout (oct_data.fortran_vec (), (const S*) TF_TensorData (tensor),
+                  tf_dims.data (), copy_dims, nelem, false, conv);
+  if (release) {TF_DeleteTensor (tensor);}
+  return oct_data;
+}
+
+// Build a single precision array from a quantized Tensor whose elements are
+// of type 'S', dequantized with the scale and the zero point in 'dequant'
+template <typename S>
+static octave_value save_dequantized (TF_Tensor* tensor,
+                                      const dim_vector& oct_dims,
+                                      const vector<octave_idx_type>& tf_dims,
+                                      int copy_dims, bool release,
+                                      const double* dequant)
+{
+  dequantize<S> conv = {(float) dequant[0], (float) dequant[1]};
+  return save_converted<FloatNDArray, dequantize<S>, S>
+           (tensor, oct_dims, tf_dims, copy_dims, release, conv);
+}
+
+// Build a Tensor of data type 'dtype' from an Octave array of a type that
+// must be converted to it, or return nullptr when the array is not of a type
+// converted to 'dtype', leaving it to be loaded as it is.
+static TF_Tensor* load_cast (const octave_value& data, TF_DataType dtype,
+                             const octave_idx_type* tf_dims, int num_dims,
+                             int copy_dims)
+{
+  bool single = data.is_single_type () && ! data.iscomplex ();
+  bool dble = data.is_double_type () && ! data.iscomplex ();
+  switch (dtype)
+  {
+    // TF_FLOAT
+    case TF_FLOAT:
+      if (dble)
+      {
+        return load_converted<float, to_single> (dtype, data.array_value (),
+                                                 tf_dims, num_dims, copy_dims);
+      }
+      break;
+    // TF_DOUBLE
+    case TF_DOUBLE:
+      if (single)
+      {
+        return load_converted<double, to_double> (dtype,
+                                                  data.float_array_value (),
+                                                  tf_dims, num_dims,
+                                                  copy_dims);
+      }
+      break;
+    // TF_HALF
+    case TF_HALF:
+      if (single)
+      {
+        return load_converted<uint16_t, to_half> (dtype,
+                                                  data.float_array_value (),
+                                                  tf_dims, num_dims, copy_dims);
+      }
+      if (dble)
+      {
+        return load_converted<uint16_t, to_half> (dtype, data.array_value (),
+                                                  tf_dims, num_dims, copy_dims);
+      }
+      break;
+    // TF_BFLOAT16
+    case TF_BFLOAT16:
+      if (single)
+      {
+        return load_converted<uint16_t, to_bfloat16> (dtype,
+                                                      data.float_array_value (),
+                                                      tf_dims, num_dims,
+                                                      copy_dims);
+      }
+      if (dble)
+      {
+        return load_converted<uint16_t, to_bfloat16> (dtype,
+                                                      data.array_value (),
+                                                      tf_dims, num_dims,
+                                                      copy_dims);
+      }
+      break;
+    // TF_FLOAT8_E5M2
+    case TF_FLOAT8_E5M2:
+      if (single)
+      {
+        return load_converted<uint8_t, to_float8<float8_e5m2>>
+                 (dtype, data.float_array_value (), tf_dims, num_dims,
+                  copy_dims);
+      }
+      if (dble)
+      {
+        return load_converted<uint8_t, to_float8<float8_e5m2>>
+                 (dtype, data.array_value (), tf_dims, num_dims, copy_dims);
+      }
+      break;
+    // TF_FLOAT8_E4M3FN
+    case TF_FLOAT8_E4M3FN:
+      if (single)
+      {
+        return load_converted<uint8_t, to_float8<float8_e4m3fn>>
+                 (dtype, data.float_array_value (), tf_dims, num_dims,
+                  copy_dims);
+      }
+      if (dble)
+      {
+        return load_converted<uint8_t, to_float8<float8_e4m3fn>>
+                 (dtype, data.array_value (), tf_dims, num_dims, copy_dims);
+      }
+      break;
+    // TF_INT4
+    case TF_INT4:
+      if (data.is_int8_type ())
+      {
+        return load_converted<int8_t, to_int4> (dtype,
+                                                data.int8_array_value (),
+                                                tf_dims, num_dims, copy_dims);
+      }
+      break;
+    // TF_UINT4
+    case TF_UINT4:
+      if (data.is_uint8_type ())
+      {
+        return load_converted<uint8_t, to_uint4> (dtype,
+                                                  data.uint8_array_value (),
+                                                  tf_dims, num_dims,
+                                                  copy_dims);
+      }
+      break;
+    // Quantized types, held in the integers of the same width, whose buffer
+    // is loaded as it is
+    case TF_QINT8:
+      if (data.is_int8_type ())
+      {
+        return load_array (dtype, data.int8_array_value (), tf_dims, num_dims,
+                           copy_dims);
+      }
+      break;
+    case TF_QUINT8:
+      if (data.is_uint8_type ())
+      {
+        return load_array (dtype, data.uint8_array_value (), tf_dims,
+                           num_dims, copy_dims);
+      }
+      break;
+    case TF_QINT16:
+      if (data.is_int16_type ())
+      {
+        return load_array (dtype, data.int16_array_value (), tf_dims,
+                           num_dims, copy_dims);
+      }
+      break;
+    case TF_QUINT16:
+      if (data.is_uint16_type ())
+      {
+        return load_array (dtype, data.uint16_array_value (), tf_dims,
+                           num_dims, copy_dims);
+      }
+      break;
+    case TF_QINT32:
+      if (data.is_int32_type ())
+      {
+        return load_array (dtype, data.int32_array_value (), tf_dims,
+                           num_dims, copy_dims);
+      }
+      break;
+    default:
+      break;
+  }
+  return nullptr;
 }
 
 // -----------------------------------------------------------------------------
 // OCTAVE specific functions referenced by the TF_Tensor classdef
 // -----------------------------------------------------------------------------
 
-// TF_Tensor* TF_LoadTensor(octave_value data)
-octave_value OCT_TF_LoadTensor (OCT_ARGS)
+// Read the optional layout argument at position 'pos', which is either
+// 'rowmajor', the default, or 'native'.  In native layout the Tensor takes the
+// dimensions of the Octave array in reverse order, so that the column major
+// buffer of the one is already the row major buffer of the other and is
+// copied as it is.
+bool native_layout (const octave_value_list& args, int nrhs, int pos,
+                    const char* ordinal, const char* fname)
 {
-  if (nrhs < 2)
+  if (nrhs <= pos)
   {
-    error ("tensorflow: one extra argument is required "
-           "for the 'TF_LoadTensor' OCTAVE function.");
+    return false;
   }
-  if (args(1).isempty ())
+  string layout;
+  if (args(pos).is_string () && args(pos).rows () == 1)
   {
-    error ("tensorflow: 2nd argument cannot be empty, it must contain non-"
-           "empty data to be parsed to the 'TF_LoadTensor' OCTAVE function.");
+    layout = args(pos).string_value ();
+  }
+  if (layout != "rowmajor" && layout != "native")
+  {
+    error ("tensorflow: %s argument must be either 'rowmajor' or 'native' "
+           "defining the layout of the Tensor parsed to the '%s' OCTAVE "
+           "function.", ordinal, fname);
+  }
+  return layout == "native";
+}
+
+// Build a Tensor from an Octave array, in row major or native layout.  Unless
+// 'dtype' is 0, the Tensor must be of that data type, the elements being
+// converted to it when they are not already.  The caller owns the returned
+// Tensor.
+TF_Tensor* load_tensor (const octave_value& data, bool native,
+                        TF_DataType dtype)
+{
+  trace_scope scope ("load_tensor", "convert");
+  if (data.isempty ())
+  {
+    error ("tensorflow: an empty array cannot be loaded into Tensor.");
   }
   // Get number of elements
-  octave_idx_type nelem = args(1).numel ();
+  octave_idx_type nelem = data.numel ();
   // Check for row vector
   bool rowvec = false;
-  if (args(1).rows () == 1) {rowvec = true;}
+  if (data.rows () == 1) {rowvec = true;}
   // Get size and number of dimensions
-  dim_vector oct_dims = args(1).dims ();
-  int num_dims = args(1).ndims ();
+  dim_vector oct_dims = data.dims ();
+  int num_dims = data.ndims ();
   const octave_idx_type *tf_dims = &oct_dims.elem (0);
   // Handle 0-dimensional scalar values and 1-dimensional row vectors
   if (nelem == 1)
@@ -108,149 +1367,115 @@ octave_value OCT_TF_LoadTensor (OCT_ARGS)
     num_dims = 1;
     tf_dims = &oct_dims(1);
   }
+  // Reverse the dimensions in native layout, leaving the data to be copied
+  // as it is
+  vector<octave_idx_type> rev_dims (tf_dims, tf_dims + num_dims);
+  if (native)
+  {
+    std::reverse (rev_dims.begin (), rev_dims.end ());
+    tf_dims = rev_dims.data ();
+  }
+  int copy_dims = native ? 0 : num_dims;
   // Create new Tensor according to data type
   // Copy data from Octave to Tensor and return its pointer
-  TF_Tensor* newTensor;
+  TF_Tensor* newTensor = nullptr;
+  // Convert the elements to the requested data type
+  if (dtype)
+  {
+    newTensor = load_cast (data, dtype, tf_dims, num_dims, copy_dims);
+  }
+  if (newTensor)
+  {
+    return newTensor;
+  }
   // TF_DOUBLE
-  if (args(1).is_double_type () && ! args(1).iscomplex ())
+  else if (data.is_double_type () && ! data.iscomplex ())
   {
-    NDArray oct_data = args(1).array_value ();
-    size_t len = TF_DataTypeSize (TF_DOUBLE) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_DOUBLE, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_DOUBLE), nelem, true);
+    newTensor = load_array (TF_DOUBLE, data.array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_COMPLEX128
-  else if (args(1).is_double_type () && args(1).iscomplex ())
+  else if (data.is_double_type () && data.iscomplex ())
   {
-    ComplexNDArray oct_data = args(1).complex_array_value ();
-    size_t len = TF_DataTypeSize (TF_COMPLEX128) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_COMPLEX128, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_COMPLEX128), nelem, true);
+    newTensor = load_array (TF_COMPLEX128, data.complex_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_FLOAT
-  else if (args(1).is_single_type () && ! args(1).iscomplex ())
+  else if (data.is_single_type () && ! data.iscomplex ())
   {
-    FloatNDArray oct_data = args(1).float_array_value ();
-    size_t len = TF_DataTypeSize (TF_FLOAT) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_FLOAT, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_FLOAT), nelem, true);
+    newTensor = load_array (TF_FLOAT, data.float_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_COMPLEX64
-  else if (args(1).is_single_type () && args(1).iscomplex ())
+  else if (data.is_single_type () && data.iscomplex ())
   {
-    FloatComplexNDArray oct_data = args(1).float_complex_array_value ();
-    size_t len = TF_DataTypeSize (TF_COMPLEX64) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_COMPLEX64, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_COMPLEX64), nelem, true);
+    newTensor = load_array (TF_COMPLEX64, data.float_complex_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_INT64
-  else if (args(1).is_int64_type ())
+  else if (data.is_int64_type ())
   {
-    int64NDArray oct_data = args(1).int64_array_value ();
-    size_t len = TF_DataTypeSize (TF_INT64) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_INT64, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_INT64), nelem, true);
+    newTensor = load_array (TF_INT64, data.int64_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_UINT64
-  else if (args(1).is_uint64_type ())
+  else if (data.is_uint64_type ())
   {
-    uint64NDArray oct_data = args(1).uint64_array_value ();
-    size_t len = TF_DataTypeSize (TF_UINT64) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_UINT64, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_UINT64), nelem, true);
+    newTensor = load_array (TF_UINT64, data.uint64_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_INT32
-  else if (args(1).is_int32_type ())
+  else if (data.is_int32_type ())
   {
-    int32NDArray oct_data = args(1).int32_array_value ();
-    size_t len = TF_DataTypeSize (TF_INT32) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_INT32, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_INT32), nelem, true);
+    newTensor = load_array (TF_INT32, data.int32_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_UINT32
-  else if (args(1).is_uint32_type ())
+  else if (data.is_uint32_type ())
   {
-    uint32NDArray oct_data = args(1).uint32_array_value ();
-    size_t len = TF_DataTypeSize (TF_UINT32) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_UINT32, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_UINT32), nelem, true);
+    newTensor = load_array (TF_UINT32, data.uint32_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_INT16
-  else if (args(1).is_int16_type ())
+  else if (data.is_int16_type ())
   {
-    int16NDArray oct_data = args(1).int16_array_value ();
-    size_t len = TF_DataTypeSize (TF_INT16) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_INT16, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_INT16), nelem, true);
+    newTensor = load_array (TF_INT16, data.int16_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_UINT16
-  else if (args(1).is_uint16_type ())
+  else if (data.is_uint16_type ())
   {
-    uint16NDArray oct_data = args(1).uint16_array_value ();
-    size_t len = TF_DataTypeSize (TF_UINT16) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_UINT16, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_UINT16), nelem, true);
+    newTensor = load_array (TF_UINT16, data.uint16_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_INT8
-  else if (args(1).is_int8_type ())
+  else if (data.is_int8_type ())
   {
-    int8NDArray oct_data = args(1).int8_array_value ();
-    size_t len = TF_DataTypeSize (TF_INT8) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_INT8, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_INT8), nelem, true);
+    newTensor = load_array (TF_INT8, data.int8_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_UINT8
-  else if (args(1).is_uint8_type ())
+  else if (data.is_uint8_type ())
   {
-    uint8NDArray oct_data = args(1).uint8_array_value ();
-    size_t len = TF_DataTypeSize (TF_UINT8) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_UINT8, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_UINT8), nelem, true);
+    newTensor = load_array (TF_UINT8, data.uint8_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_BOOL
-  else if (args(1).islogical ())
+  else if (data.islogical ())
   {
-    boolNDArray oct_data = args(1).bool_array_value ();
-    size_t len = TF_DataTypeSize (TF_BOOL) * (int) nelem;
-    newTensor = TF_AllocateTensor (TF_BOOL, tf_dims, num_dims, len);
-    copy_layout ((char*) TF_TensorData (newTensor),
-                 (const char*) oct_data.data (), tf_dims, num_dims,
-                 TF_DataTypeSize (TF_BOOL), nelem, true);
+    newTensor = load_array (TF_BOOL, data.bool_array_value (),
+                            tf_dims, num_dims, copy_dims);
   }
   // TF_STRING
-  else if (args(1).is_char_matrix ())
+  else if (data.is_char_matrix ())
   {
     if (! rowvec)
     {
       error ("tensorflow: only a character vector can be loaded into Tensor. "
              "For multiple rows of characters use a cellstr array.");
     }
-    string oct_data = args(1).string_value ();
-    size_t str_len = (size_t) args(1).numel ();
+    string oct_data = data.string_value ();
+    size_t str_len = (size_t) data.numel ();
     TF_TString* tstring = reinterpret_cast<TF_TString*> (malloc (sizeof (TF_TString)));
     TF_StringInit (tstring);
     TF_StringCopy (tstring, oct_data.c_str (), str_len);
@@ -259,9 +1484,9 @@ octave_value OCT_TF_LoadTensor (OCT_ARGS)
     newTensor = TF_NewTensor (TF_STRING, dims, ndims, tstring,
                               sizeof (TF_TString), &NoOpDeallocator, 0);
   }
-  else if (args(1).iscellstr ())
+  else if (data.iscellstr ())
   {
-    Array<string> oct_data = args(1).cellstr_value ();
+    Array<string> oct_data = data.cellstr_value ();
     if (nelem == 1)
     {
       size_t str_len = (size_t) oct_data(0).length ();
@@ -290,29 +1515,87 @@ octave_value OCT_TF_LoadTensor (OCT_ARGS)
   }
   else
   {
-    const char* oct_type = args(1).type_name ().c_str ();
-    error ("tensorflow: '%s' type cannot be loaded into Tensor.", oct_type);
+    string oct_type = data.type_name ();
+    error ("tensorflow: '%s' type cannot be loaded into Tensor.",
+           oct_type.c_str ());
   }
-  octave_uint64 ptr = (uint64_t) newTensor;
-  octave_value plhs = ptr;
-  return plhs;
+  if (dtype && TF_TensorType (newTensor) != dtype)
+  {
+    TF_DeleteTensor (newTensor);
+    string oct_type = data.type_name ();
+    string tf_type = data_type_name (dtype);
+    error ("tensorflow: '%s' type cannot be loaded into a Tensor of '%s' "
+           "data type.", oct_type.c_str (), tf_type.c_str ());
+  }
+  return newTensor;
 }
 
-// octave_value TF_SaveTensor(TF_Tensor* tensor)
-octave_value OCT_TF_SaveTensor (OCT_ARGS)
+// Build the Tensor fed to an input of data type 'dtype'.  A real single or
+// double array fed to a TF_FLOAT or TF_DOUBLE input is converted to the type
+// of the input in the pass that repositions it, so that a double array needs
+// no call to single first.  The narrower floating point types lose too much
+// to be converted to silently, so any other array is loaded as it is, leaving
+// a mismatch to be reported by the run.
+TF_Tensor* load_input (const octave_value& data, bool native,
+                       TF_DataType dtype)
+{
+  bool real = (data.is_double_type () || data.is_single_type ())
+              && ! data.iscomplex ();
+  switch (dtype)
+  {
+    case TF_FLOAT:
+    case TF_DOUBLE:
+      if (real) {return load_tensor (data, native, dtype);}
+      break;
+    default:
+      break;
+  }
+  return load_tensor (data, native);
+}
+
+// TF_Tensor* TF_LoadTensor(octave_value data, string layout,
+//                          TF_DataType dtype)
+octave_value OCT_TF_LoadTensor (OCT_ARGS)
 {
   if (nrhs < 2)
   {
     error ("tensorflow: one extra argument is required "
-           "for the 'TF_SaveTensor' OCTAVE function.");
+           "for the 'TF_LoadTensor' OCTAVE function.");
   }
-  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  if (args(1).isempty ())
   {
-    error ("tensorflow: 2nd argument must be an uint64 scalar pointer "
-           "to the Tensor parsed to the 'TF_SaveTensor' OCTAVE function.");
+    error ("tensorflow: 2nd argument cannot be empty, it must contain non-"
+           "empty data to be parsed to the 'TF_LoadTensor' OCTAVE function.");
   }
-  // Get pointer to Tensor
-  TF_Tensor* tensor = (TF_Tensor*) args(1).uint64_value ();
+  bool native = native_layout (args, nrhs, 2, "3rd", "TF_LoadTensor");
+  // Check octave_value type for DataType
+  TF_DataType dtype = (TF_DataType) 0;
+  if (nrhs > 3)
+  {
+    if (! args(3).is_uint32_type () || ! args(3).is_scalar_type ())
+    {
+      error ("tensorflow: 4th argument must be an uint32 scalar indexing the "
+             "TF_DataType of the Tensor parsed to the 'TF_LoadTensor' OCTAVE "
+             "function.");
+    }
+    dtype = (TF_DataType) args(3).uint_value ();
+  }
+  TF_Tensor* newTensor = load_tensor (args(1), native, dtype);
+  octave_uint64 ptr = (uint64_t) newTensor;
+  octave_value plhs = ptr;
+  return plhs;
+}
+
+// Build an Octave array from a Tensor, in row major or native layout.  When
+// RELEASE is true the Tensor is handed over and released along with the
+// array, or straight away if its data had to be copied.  A quantized Tensor
+// is returned as an array of integers of the same width, or, when 'dequant'
+// points to a scale and a zero point, dequantized to single precision in the
+// same pass that repositions it.
+octave_value save_tensor (TF_Tensor* tensor, bool native, bool release,
+                          const double* dequant)
+{
+  trace_scope scope ("save_tensor", "convert");
   // Get data type of Tensor
   TF_DataType tf_type = TF_TensorType (tensor);
   // Get size and number of dimensions of Tensor
@@ -336,143 +1619,165 @@ octave_value OCT_TF_SaveTensor (OCT_ARGS)
     oct_dims.resize (num_dims);
     for (int i = 0; i < num_dims; i++) {oct_dims(i) = TF_Dim (tensor, i);}
   }
+  // Reverse the dimensions in native layout, leaving the data to be copied
+  // as it is
+  if (native && num_dims > 1)
+  {
+    for (int i = 0; i < num_dims; i++)
+    {
+      oct_dims(i) = TF_Dim (tensor, num_dims - 1 - i);
+    }
+  }
+  int copy_dims = native ? 0 : num_dims;
   // Get the dimensions and the number of elements of the Tensor, needed to
   // restore the elements to Octave's column major storage
   vector<octave_idx_type> tf_dims (num_dims > 0 ? num_dims : 1, 1);
   for (int i = 0; i < num_dims; i++) {tf_dims[i] = TF_Dim (tensor, i);}
-  octave_idx_type nelem = (octave_idx_type) TF_TensorElementCount (tensor);
   // Create new octave value according to data type
   // Copy data from Tensor to Octave value and return it.
   octave_value plhs;
+  // Dequantize a quantized Tensor
+  if (dequant)
+  {
+    switch (tf_type)
+    {
+      case TF_QINT8:
+        return save_dequantized<int8_t> (tensor, oct_dims, tf_dims, copy_dims,
+                                         release, dequant);
+      case TF_QUINT8:
+        return save_dequantized<uint8_t> (tensor, oct_dims, tf_dims,
+                                          copy_dims, release, dequant);
+      case TF_QINT16:
+        return save_dequantized<int16_t> (tensor, oct_dims, tf_dims,
+                                          copy_dims, release, dequant);
+      case TF_QUINT16:
+        return save_dequantized<uint16_t> (tensor, oct_dims, tf_dims,
+                                           copy_dims, release, dequant);
+      case TF_QINT32:
+        return save_dequantized<int32_t> (tensor, oct_dims, tf_dims,
+                                          copy_dims, release, dequant);
+      default:
+      {
+        if (release) {TF_DeleteTensor (tensor);}
+        string tf_name = data_type_name (tf_type);
+        error ("tensorflow: only a quantized Tensor can be dequantized, not "
+               "one of '%s' data type.", tf_name.c_str ());
+      }
+    }
+  }
   // TF_DOUBLE
   if (tf_type == TF_DOUBLE)
   {
-    NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                release);
   }
   // TF_COMPLEX128
   else if (tf_type == TF_COMPLEX128)
   {
-    ComplexNDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<ComplexNDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                       release);
   }
   // TF_FLOAT
   else if (tf_type == TF_FLOAT)
   {
-    FloatNDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<FloatNDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                     release);
   }
   // TF_COMPLEX64
   else if (tf_type == TF_COMPLEX64)
   {
-    FloatComplexNDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<FloatComplexNDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                            release);
   }
   // TF_INT64
   else if (tf_type == TF_INT64)
   {
-    int64NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<int64NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                     release);
   }
   // TF_UINT64
   else if (tf_type == TF_UINT64)
   {
-    uint64NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<uint64NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                      release);
   }
-  // TF_INT32
-  else if (tf_type == TF_INT32)
+  // TF_INT32 and TF_QINT32
+  else if (tf_type == TF_INT32 || tf_type == TF_QINT32)
   {
-    int32NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<int32NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                     release);
   }
   // TF_UINT32
   else if (tf_type == TF_UINT32)
   {
-    uint32NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<uint32NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                      release);
   }
-  // TF_INT16
-  else if (tf_type == TF_INT16)
+  // TF_INT16 and TF_QINT16
+  else if (tf_type == TF_INT16 || tf_type == TF_QINT16)
   {
-    int16NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<int16NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                     release);
   }
-  // TF_UINT16
-  else if (tf_type == TF_UINT16)
+  // TF_UINT16 and TF_QUINT16
+  else if (tf_type == TF_UINT16 || tf_type == TF_QUINT16)
   {
-    uint16NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<uint16NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                      release);
   }
-  // TF_INT8
-  else if (tf_type == TF_INT8)
+  // TF_INT8 and TF_QINT8
+  else if (tf_type == TF_INT8 || tf_type == TF_QINT8)
   {
-    int8NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<int8NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                    release);
   }
-  // TF_UINT8
-  else if (tf_type == TF_UINT8)
+  // TF_UINT8 and TF_QUINT8
+  else if (tf_type == TF_UINT8 || tf_type == TF_QUINT8)
   {
-    uint8NDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<uint8NDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                     release);
   }
   // TF_BOOL
   else if (tf_type == TF_BOOL)
   {
-    boolNDArray oct_data(oct_dims);
-    copy_layout ((char*) oct_data.fortran_vec (),
-                 (const char*) TF_TensorData (tensor),
-                 tf_dims.data (), num_dims,
-                 TF_DataTypeSize (tf_type), nelem, false);
-    plhs = oct_data;
+    plhs = save_array<boolNDArray> (tensor, oct_dims, tf_dims, copy_dims,
+                                    release);
+  }
+  // TF_HALF
+  else if (tf_type == TF_HALF)
+  {
+    plhs = save_converted<FloatNDArray, from_half, uint16_t>
+             (tensor, oct_dims, tf_dims, copy_dims, release);
+  }
+  // TF_BFLOAT16
+  else if (tf_type == TF_BFLOAT16)
+  {
+    plhs = save_converted<FloatNDArray, from_bfloat16, uint16_t>
+             (tensor, oct_dims, tf_dims, copy_dims, release);
+  }
+  // TF_FLOAT8_E5M2
+  else if (tf_type == TF_FLOAT8_E5M2)
+  {
+    plhs = save_converted<FloatNDArray, from_float8<float8_e5m2>, uint8_t>
+             (tensor, oct_dims, tf_dims, copy_dims, release);
+  }
+  // TF_FLOAT8_E4M3FN
+  else if (tf_type == TF_FLOAT8_E4M3FN)
+  {
+    plhs = save_converted<FloatNDArray, from_float8<float8_e4m3fn>, uint8_t>
+             (tensor, oct_dims, tf_dims, copy_dims, release);
+  }
+  // TF_INT4
+  else if (tf_type == TF_INT4)
+  {
+    plhs = save_converted<int8NDArray, from_int4, int8_t>
+             (tensor, oct_dims, tf_dims, copy_dims, release);
+  }
+  // TF_UINT4
+  else if (tf_type == TF_UINT4)
+  {
+    plhs = save_converted<uint8NDArray, from_uint4, uint8_t>
+             (tensor, oct_dims, tf_dims, copy_dims, release);
   }
   // TF_STRING
   else if (tf_type == TF_STRING)
@@ -524,30 +1829,96 @@ octave_value OCT_TF_SaveTensor (OCT_ARGS)
       }
       plhs = oct_data;
     }
+    if (release) {TF_DeleteTensor (tensor);}
   }
   else
   {
     // Find Tensor data type
-    string missing_type;
-    if (tf_type == 11) {missing_type = "TF_QINT8";}
-    else if (tf_type == 12) {missing_type = "TF_QUINT8";}
-    else if (tf_type == 13) {missing_type = "TF_QINT32";}
-    else if (tf_type == 14) {missing_type = "TF_BFLOAT16";}
-    else if (tf_type == 15) {missing_type = "TF_QINT16";}
-    else if (tf_type == 16) {missing_type = "TF_QUINT16";}
-    else if (tf_type == 19) {missing_type = "TF_HALF";}
-    else if (tf_type == 20) {missing_type = "TF_RESOURCE";}
-    else if (tf_type == 21) {missing_type = "TF_VARIANT";}
-    else if (tf_type == 24) {missing_type = "TF_FLOAT8_E5M2";}
-    else if (tf_type == 25) {missing_type = "TF_FLOAT8_E4M3FN";}
-    else if (tf_type == 29) {missing_type = "TF_INT4";}
-    else if (tf_type == 30) {missing_type = "TF_UINT4";}
+    string missing_type = data_type_name (tf_type);
+    if (release) {TF_DeleteTensor (tensor);}
     error ("tensorflow: '%s' data type in Tensor is not supported by Octave.",
            missing_type.c_str ());
   }
   return plhs;
 }
 
+// octave_value TF_SaveTensor(TF_Tensor* tensor, string layout, bool release,
+//                            double dequant[2])
+octave_value OCT_TF_SaveTensor (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_SaveTensor' OCTAVE function.");
+  }
+  if (! args(1).is_uint64_type () || ! args(1).is_scalar_type ())
+  {
+    error ("tensorflow: 2nd argument must be an uint64 scalar pointer "
+           "to the Tensor parsed to the 'TF_SaveTensor' OCTAVE function.");
+  }
+  // Get pointer to Tensor
+  TF_Tensor* tensor = (TF_Tensor*) args(1).uint64_value ();
+  bool native = native_layout (args, nrhs, 2, "3rd", "TF_SaveTensor");
+  // Check octave_value type for releasing the Tensor
+  bool release = false;
+  if (nrhs > 3)
+  {
+    if (! args(3).is_bool_scalar ())
+    {
+      error ("tensorflow: 4th argument must be a logical scalar defining "
+             "whether the Tensor is released, parsed to the 'TF_SaveTensor' "
+             "OCTAVE function.");
+    }
+    release = args(3).bool_value ();
+  }
+  // Check octave_value type for the scale and the zero point
+  double dequant[2];
+  if (nrhs > 4)
+  {
+    if (! args(4).isnumeric () || ! args(4).isreal ()
+        || args(4).numel () != 2)
+    {
+      error ("tensorflow: 5th argument must be a two element vector of the "
+             "scale and the zero point dequantizing the Tensor parsed to the "
+             "'TF_SaveTensor' OCTAVE function.");
+    }
+    NDArray params = args(4).array_value ();
+    dequant[0] = params(0);
+    dequant[1] = params(1);
+  }
+  return save_tensor (tensor, native, release, nrhs > 4 ? dequant : nullptr);
+}
+
+// int TF_SetConversionThreads(int num_threads)
+octave_value OCT_TF_SetConversionThreads (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_SetConversionThreads' OCTAVE function.");
+  }
+  // Check octave_value type for number of threads
+  if (! args(1).isnumeric () || ! args(1).is_scalar_type ()
+      || args(1).iscomplex () || args(1).double_value () < 0
+      || args(1).double_value () != round (args(1).double_value ()))
+  {
+    error ("tensorflow: 2nd argument must be a non-negative integer scalar "
+           "defining the number of threads parsed to the "
+           "'TF_SetConversionThreads' OCTAVE function.");
+  }
+  // Zero selects one thread per processor
+  int num_threads = args(1).int_value ();
+  if (num_threads == 0)
+  {
+    num_threads = std::max ((int) std::thread::hardware_concurrency (), 1);
+  }
+  // Return the number of threads used so far
+  octave_int32 prev_threads = conversion_threads ();
+  layout_threads.store (num_threads);
+  octave_value plhs = prev_threads;
+  return plhs;
+}
+
 // -----------------------------------------------------------------------------
 // C API functions referenced by the TF_Tensor classdef
 // -----------------------------------------------------------------------------
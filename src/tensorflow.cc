@@ -17,10 +17,485 @@ You should have received a copy of the GNU General Public License along with
 this program; if not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "tensorflow.h"
 
 using namespace std;
 
+// Handler of a C API or OCTAVE function, adapted to a common signature
+typedef octave_value (*oct_handler) (OCT_ARGS);
+
+// Entries of the dispatch table, adapting handlers that return a value, that
+// return nothing, and that take no arguments
+#define OCT_FCN(name) \
+  {#name, [] (OCT_ARGS) -> octave_value {return OCT_##name (nrhs, args);}}
+#define OCT_VOID(name) \
+  {#name, [] (OCT_ARGS) -> octave_value {OCT_##name (nrhs, args); \
+                                         return octave_value ();}}
+#define OCT_NOARGS(name) \
+  {#name, [] (OCT_ARGS) -> octave_value {return OCT_##name ();}}
+
+struct oct_entry
+{
+  const char* name;
+  oct_handler fcn;
+};
+
+static octave_value OCT_TF_Version (void)
+{
+  const char* out = TF_Version ();
+  return octave_value (out);
+}
+
+static octave_value OCT_TF_Opcode (OCT_ARGS);
+static void OCT_TF_TraceStart (OCT_ARGS);
+static octave_value OCT_TF_TraceStop (OCT_ARGS);
+
+// Every function the 'tensorflow' function dispatches to.  The position of an
+// entry is its opcode, which is therefore only valid for the build of the
+// package it was obtained from, and must be resolved with 'TF_Opcode' rather
+// than hard coded.
+static const oct_entry oct_handlers[] =
+{
+  OCT_NOARGS (TF_Version),
+  OCT_FCN (TF_Opcode),                            // OCTAVE specific
+  OCT_VOID (TF_TraceStart),                       // OCTAVE specific
+  OCT_FCN (TF_TraceStop),                         // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Buffer classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewBuffer),
+  OCT_VOID (TF_DeleteBuffer),
+  OCT_FCN (TF_NewBufferFromString),
+  OCT_FCN (TF_GetBuffer),
+  OCT_FCN (TF_GetBufferToString),                 // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_DataType classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_DataTypeName),                      // OCTAVE specific
+  OCT_FCN (TF_DataTypeSize),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_DeviceList classdef
+  // ---------------------------------------------------------------------------
+  OCT_VOID (TF_DeleteDeviceList),
+  OCT_FCN (TF_DeviceListCount),
+  OCT_FCN (TF_DeviceListName),
+  OCT_FCN (TF_DeviceListType),
+  OCT_FCN (TF_DeviceListMemoryBytes),
+  OCT_FCN (TF_DeviceListIncarnation),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Graph classdef
+  // ---------------------------------------------------------------------------
+  OCT_NOARGS (TF_NewGraph),
+  OCT_VOID (TF_DeleteGraph),
+  OCT_VOID (TF_GraphSetTensorShape),
+  OCT_FCN (TF_GraphGetTensorNumDims),
+  OCT_FCN (TF_GraphGetTensorShape),
+  OCT_FCN (TF_NewOperationLocked),
+  OCT_FCN (TF_NewOperation),
+  OCT_FCN (TF_GraphOperationByName),
+  OCT_FCN (TF_GraphOperationsByName),             // OCTAVE specific
+  OCT_FCN (TF_GraphNextOperation),
+  OCT_FCN (TF_GraphOperations),                   // OCTAVE specific
+  OCT_FCN (TF_GraphOperationTable),               // OCTAVE specific
+  OCT_FCN (TF_GraphAdjacency),                    // OCTAVE specific
+  OCT_FCN (TF_GraphPrune),                        // OCTAVE specific
+  OCT_VOID (TF_GraphToGraphDef),
+  OCT_VOID (TF_GraphGetOpDef),
+  OCT_VOID (TF_GraphVersions),
+  OCT_FCN (TF_GraphImportGraphDefWithResults),
+  OCT_VOID (TF_GraphImportGraphDefWithReturnOutputs),
+  OCT_VOID (TF_GraphImportGraphDef),
+  OCT_VOID (TF_GraphCopyFunction),
+  OCT_FCN (TF_GraphNumFunctions),
+  OCT_FCN (TF_GraphGetFunctions),
+  OCT_FCN (TF_NewWhile),
+  OCT_VOID (TF_AddGradients),
+  OCT_VOID (TF_AddGradientsWithPrefix),
+  OCT_FCN (TF_GraphToFunction),
+  OCT_FCN (TF_GraphToFunctionWithControlOutputs),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Input classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewInput),                          // OCTAVE specific
+  OCT_VOID (TF_DeleteInput),                      // OCTAVE specific
+  OCT_FCN (TF_OperationInputType),
+  OCT_FCN (TF_OperationInput),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Operation classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_OperationName),
+  OCT_FCN (TF_OperationOpType),
+  OCT_FCN (TF_OperationDevice),
+  OCT_FCN (TF_OperationNumOutputs),
+  OCT_FCN (TF_OperationOutputListLength),
+  OCT_FCN (TF_OperationNumInputs),
+  OCT_FCN (TF_OperationInputListLength),
+  OCT_FCN (TF_OperationAllInputs),
+  OCT_FCN (TF_OperationNumControlInputs),
+  OCT_FCN (TF_OperationGetControlInputs),
+  OCT_FCN (TF_OperationNumControlOutputs),
+  OCT_FCN (TF_OperationGetControlOutputs),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_OperationDescription classdef
+  // ---------------------------------------------------------------------------
+  OCT_VOID (TF_SetDevice),
+  OCT_VOID (TF_AddInput),
+  OCT_VOID (TF_AddInputList),
+  OCT_VOID (TF_AddControlInput),
+  OCT_VOID (TF_SetAttrString),
+  OCT_VOID (TF_SetAttrStringList),
+  OCT_VOID (TF_SetAttrInt),
+  OCT_VOID (TF_SetAttrIntList),
+  OCT_VOID (TF_SetAttrFloat),
+  OCT_VOID (TF_SetAttrFloatList),
+  OCT_VOID (TF_SetAttrBool),
+  OCT_VOID (TF_SetAttrBoolList),
+  OCT_VOID (TF_SetAttrType),
+  OCT_VOID (TF_SetAttrTypeList),
+  OCT_VOID (TF_SetAttrPlaceholder),
+  OCT_VOID (TF_SetAttrFuncName),
+  OCT_VOID (TF_SetAttrShape),
+  OCT_VOID (TF_SetAttrShapeList),
+  OCT_VOID (TF_SetAttrTensorShapeProto),
+  OCT_VOID (TF_SetAttrTensorShapeProtoList),
+  OCT_VOID (TF_SetAttrTensor),
+  OCT_VOID (TF_SetAttrTensorList),
+  OCT_VOID (TF_SetAttrValueProto),
+  OCT_FCN (TF_FinishOperationLocked),
+  OCT_FCN (TF_FinishOperation),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Output classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewOutput),                         // OCTAVE specific
+  OCT_VOID (TF_DeleteOutput),                     // OCTAVE specific
+  OCT_FCN (TF_OperationOutputType),
+  OCT_FCN (TF_OperationOutputNumConsumers),
+  OCT_FCN (TF_OperationOutputConsumers),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Session classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewSession),
+  OCT_FCN (TF_LoadSessionFromSavedModel),
+  OCT_FCN (TF_SignatureDefs),                     // OCTAVE specific
+  OCT_VOID (TF_CloseSession),
+  OCT_VOID (TF_DeleteSession),
+  OCT_FCN (TF_SessionRun),
+  OCT_FCN (TF_SessionPRunSetup),
+  OCT_FCN (TF_SessionPRun),
+  OCT_VOID (TF_DeletePRunHandle),
+  OCT_FCN (TF_SessionRunValues),                  // OCTAVE specific
+  OCT_FCN (TF_SessionProfile),                    // OCTAVE specific
+  OCT_FCN (TF_SessionListDevices),
+  OCT_FCN (TF_SessionPoolStats),                  // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // OCTAVE specific functions referenced by the TF_Runner classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewRunner),                         // OCTAVE specific
+  OCT_VOID (TF_DeleteRunner),                     // OCTAVE specific
+  OCT_FCN (TF_RunnerRun),                         // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // OCTAVE specific functions referenced by the TF_AsyncRun classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_SessionRunAsync),                   // OCTAVE specific
+  OCT_FCN (TF_AsyncRunIsDone),                    // OCTAVE specific
+  OCT_FCN (TF_AsyncRunWait),                      // OCTAVE specific
+  OCT_FCN (TF_AsyncRunFetch),                     // OCTAVE specific
+  OCT_VOID (TF_DeleteAsyncRun),                   // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // OCTAVE specific functions referenced by the TFModel classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewBatcher),                        // OCTAVE specific
+  OCT_FCN (TF_BatcherSubmit),                     // OCTAVE specific
+  OCT_FCN (TF_BatcherCollect),                    // OCTAVE specific
+  OCT_FCN (TF_BatcherStats),                      // OCTAVE specific
+  OCT_VOID (TF_DeleteBatcher),                    // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // OCTAVE specific functions referenced by the TFModelPool classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_NewModelPool),                      // OCTAVE specific
+  OCT_FCN (TF_ModelPoolSubmit),                   // OCTAVE specific
+  OCT_FCN (TF_ModelPoolCollect),                  // OCTAVE specific
+  OCT_FCN (TF_ModelPoolStats),                    // OCTAVE specific
+  OCT_VOID (TF_DeleteModelPool),                  // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_SessionOptions classdef
+  // ---------------------------------------------------------------------------
+  OCT_NOARGS (TF_NewSessionOptions),
+  OCT_VOID (TF_SetTarget),
+  OCT_VOID (TF_SetConfig),
+  OCT_VOID (TF_DeleteSessionOptions),
+  OCT_FCN (TF_EncodeConfig),                      // OCTAVE specific
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Status classdef
+  // ---------------------------------------------------------------------------
+  OCT_NOARGS (TF_NewStatus),
+  OCT_VOID (TF_DeleteStatus),
+  OCT_VOID (TF_SetStatus),
+  OCT_VOID (TF_SetPayload),
+  OCT_VOID (TF_ForEachPayload),
+  OCT_VOID (TF_SetStatusFromIOError),
+  OCT_FCN (TF_GetCode),
+  OCT_FCN (TF_Message),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_String classdef
+  // ---------------------------------------------------------------------------
+  OCT_NOARGS (TF_NewTString),                     // OCTAVE specific
+  OCT_FCN (TF_LoadTString),                       // OCTAVE specific
+  OCT_FCN (TF_SaveTString),                       // OCTAVE specific
+  OCT_VOID (TF_StringInit),
+  OCT_VOID (TF_StringCopy),
+  OCT_VOID (TF_StringAssignView),
+  OCT_FCN (TF_StringGetDataPointer),
+  OCT_FCN (TF_StringGetType),
+  OCT_FCN (TF_StringGetSize),
+  OCT_FCN (TF_StringGetCapacity),
+  OCT_VOID (TF_StringDealloc),
+  // ---------------------------------------------------------------------------
+  // C API functions referenced by the TF_Tensor classdef
+  // ---------------------------------------------------------------------------
+  OCT_FCN (TF_LoadTensor),                        // OCTAVE specific
+  OCT_FCN (TF_SaveTensor),                        // OCTAVE specific
+  OCT_FCN (TF_SetConversionThreads),              // OCTAVE specific
+  OCT_FCN (TF_NewTensor),
+  OCT_FCN (TF_AllocateTensor),
+  OCT_FCN (TF_TensorMaybeMove),
+  OCT_VOID (TF_DeleteTensor),
+  OCT_FCN (TF_TensorType),
+  OCT_VOID (TF_SetShape),
+  OCT_FCN (TF_NumDims),
+  OCT_FCN (TF_Dim),
+  OCT_FCN (TF_TensorByteSize),
+  OCT_FCN (TF_TensorData),
+  OCT_VOID (TF_TensorFromProto),
+  OCT_FCN (TF_TensorElementCount),
+  OCT_VOID (TF_TensorBitcastFrom),
+  OCT_FCN (TF_TensorIsAligned),
+};
+
+static const int oct_num_handlers = sizeof (oct_handlers) / sizeof (oct_entry);
+
+// Return the opcode of a function name, or -1 if there is no such function.
+// The index is built on first use.
+static int oct_opcode (const string& name)
+{
+  static const unordered_map<string, int> index = [] ()
+  {
+    unordered_map<string, int> map (2 * oct_num_handlers);
+    for (int i = 0; i < oct_num_handlers; i++) {map[oct_handlers[i].name] = i;}
+    return map;
+  } ();
+  auto it = index.find (name);
+  return it == index.end () ? -1 : it->second;
+}
+
+// int32 TF_Opcode(string name)
+static octave_value OCT_TF_Opcode (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_Opcode' OCTAVE function.");
+  }
+  // Check octave_value type for function names
+  if (! (args(1).is_string () && args(1).rows () == 1) && ! args(1).iscellstr ())
+  {
+    error ("tensorflow: 2nd argument must be a character vector or a cellstr "
+           "array of function names parsed to the 'TF_Opcode' OCTAVE "
+           "function.");
+  }
+  Array<string> names;
+  if (args(1).is_string ())
+  {
+    names = Array<string> (dim_vector (1, 1), args(1).string_value ());
+  }
+  else
+  {
+    names = args(1).cellstr_value ();
+  }
+  int32NDArray opcodes (names.dims ());
+  for (octave_idx_type i = 0; i < names.numel (); i++)
+  {
+    int opcode = oct_opcode (names(i));
+    if (opcode < 0)
+    {
+      error ("tensorflow: unrecognized reference to C API function '%s' "
+             "parsed to the 'TF_Opcode' OCTAVE function.", names(i).c_str ());
+    }
+    opcodes(i) = opcode;
+  }
+  octave_value plhs = opcodes;
+  return plhs;
+}
+
+// -----------------------------------------------------------------------------
+// Tracing the package
+// -----------------------------------------------------------------------------
+
+atomic<bool> trace_on (false);
+
+// A span recorded while tracing, either of the package on one of the threads
+// it runs on, or of a kernel on one of the devices of a Session
+struct trace_record
+{
+  string name;
+  const char* cat;
+  double start;
+  double wall;
+  int pid;
+  int tid;
+  string op;
+};
+
+static mutex trace_mutex;
+static vector<trace_record> trace_records;
+static unordered_map<thread::id, int> trace_threads;
+static unordered_map<string, int> trace_devices;
+
+double trace_clock (void)
+{
+  auto now = chrono::system_clock::now ().time_since_epoch ();
+  return chrono::duration<double, micro> (now).count ();
+}
+
+void trace_host (const char* name, const char* cat, double start, double end)
+{
+  lock_guard<mutex> lock (trace_mutex);
+  if (! trace_on.load (memory_order_relaxed)) {return;}
+  auto it = trace_threads.emplace (this_thread::get_id (),
+                                   (int) trace_threads.size ()).first;
+  trace_records.push_back ({name, cat, start, end - start, 0, it->second, ""});
+}
+
+void trace_kernel (const string& name, const string& op, const string& device,
+                   double start, double wall)
+{
+  lock_guard<mutex> lock (trace_mutex);
+  if (! trace_on.load (memory_order_relaxed)) {return;}
+  auto it = trace_devices.emplace (device, (int) trace_devices.size ()).first;
+  trace_records.push_back ({name, "kernel", start, wall, 1, it->second, op});
+}
+
+// Write 'str' to 'fid' as a JSON string
+static void json_string (FILE* fid, const string& str)
+{
+  fputc ('"', fid);
+  for (unsigned char c : str)
+  {
+    if (c == '"' || c == '\\') {fprintf (fid, "\\%c", c);}
+    else if (c < 0x20) {fprintf (fid, "\\u%04x", c);}
+    else {fputc (c, fid);}
+  }
+  fputc ('"', fid);
+}
+
+// Write the metadata event naming process 'pid', or thread 'tid' of it
+static void json_name (FILE* fid, const char* what, int pid, int tid,
+                       const string& name)
+{
+  fprintf (fid, ",\n{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+           "\"args\":{\"name\":", what, pid, tid);
+  json_string (fid, name);
+  fputs ("}}", fid);
+}
+
+// void TF_TraceStart()
+//
+// Discard any trace recorded so far and start recording the time spent in
+// the functions of the package, on every thread, along with the kernels
+// executed by every Session run that passes no RunOptions of its own.
+static void OCT_TF_TraceStart (OCT_ARGS)
+{
+  lock_guard<mutex> lock (trace_mutex);
+  trace_records.clear ();
+  trace_threads.clear ();
+  trace_devices.clear ();
+  // The thread starting the trace is the one Octave runs on
+  trace_threads.emplace (this_thread::get_id (), 0);
+  trace_on = true;
+}
+
+// double TF_TraceStop(string file)
+//
+// Stop recording and write the trace to 'file' as Chrome trace event JSON,
+// with the package and the kernels of TensorFlow in two processes on a common
+// timeline, and return the number of spans written.
+static octave_value OCT_TF_TraceStop (OCT_ARGS)
+{
+  if (nrhs < 2)
+  {
+    error ("tensorflow: one extra argument is required "
+           "for the 'TF_TraceStop' OCTAVE function.");
+  }
+  // Check octave_value type for file name
+  if (! args(1).is_string () || args(1).rows () != 1)
+  {
+    error ("tensorflow: 2nd argument must be a character vector defining the "
+           "file name parsed to the 'TF_TraceStop' OCTAVE function.");
+  }
+  string file = args(1).string_value ();
+  vector<trace_record> records;
+  unordered_map<thread::id, int> threads;
+  unordered_map<string, int> devices;
+  {
+    lock_guard<mutex> lock (trace_mutex);
+    trace_on = false;
+    records.swap (trace_records);
+    threads.swap (trace_threads);
+    devices.swap (trace_devices);
+  }
+  FILE* fid = fopen (file.c_str (), "w");
+  if (! fid)
+  {
+    error ("tensorflow: unable to open '%s' for writing, parsed to the "
+           "'TF_TraceStop' OCTAVE function.", file.c_str ());
+  }
+  // Time the spans from the first one to start
+  double origin = records.empty () ? 0 : records.front ().start;
+  for (const trace_record& r : records) {origin = min (origin, r.start);}
+  fputs ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fid);
+  fputs ("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,"
+         "\"args\":{\"name\":\"tensorflow package\"}}", fid);
+  json_name (fid, "process_name", 1, 0, "TensorFlow kernels");
+  for (size_t t = 0; t < threads.size (); t++)
+  {
+    json_name (fid, "thread_name", 0, (int) t,
+               t == 0 ? "Octave" : "worker " + to_string (t));
+  }
+  for (const auto& d : devices)
+  {
+    json_name (fid, "thread_name", 1, d.second, d.first);
+  }
+  for (const trace_record& r : records)
+  {
+    fputs (",\n{\"name\":", fid);
+    json_string (fid, r.name);
+    fprintf (fid, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+             "\"pid\":%d,\"tid\":%d", r.cat, r.start - origin, r.wall,
+             r.pid, r.tid);
+    if (! r.op.empty ())
+    {
+      fputs (",\"args\":{\"op\":", fid);
+      json_string (fid, r.op);
+      fputc ('}', fid);
+    }
+    fputc ('}', fid);
+  }
+  fputs ("\n]}\n", fid);
+  if (fclose (fid) != 0)
+  {
+    error ("tensorflow: unable to write the trace to '%s', parsed to the "
+           "'TF_TraceStop' OCTAVE function.", file.c_str ());
+  }
+  octave_value plhs = (double) records.size ();
+  return plhs;
+}
+
 DEFUN_DLD (tensorflow, args, nargout,
           "-*- texinfo -*-\n\
  @deftypefn  {tensorflow} {@var{ref} =} tensorflow (@var{TF_name}, @dots{})\n\
@@ -71,6 +546,31 @@ Extra input arguments are identified as @var{in2}, @var{in3}, @var{in3}, etc. \
 @itemize \n\
 @item @var{out} : @code{char} vector containing tensorflow C API version. \n\
 @end itemize \n\
+@item @qcode{'TF_Opcode'} \n\
+@itemize \n\
+@item @var{out} : @code{int32} array of opcodes, one per function name, \n\
+which may be passed to @code{tensorflow} in place of @var{TF_name} to skip \n\
+looking the name up on every call.  Opcodes are only valid for the build of \n\
+the package they were obtained from. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : character vector or cellstr array of function names. \n\
+@end itemize \n\
+@item @qcode{'TF_TraceStart'} \n\
+Discards any trace recorded so far and starts recording the time spent in \n\
+each call to @code{tensorflow}, in the conversion of arrays to and from \n\
+Tensors and in each Session run, on every thread of the package.  The \n\
+kernels executed by each run are recorded along with them, from the \n\
+StepStats of a full trace, unless the run passes RunOptions of its own. \n\
+@item @qcode{'TF_TraceStop'} \n\
+@itemize \n\
+@item @var{out} : @code{double} scalar number of spans written. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : @code{char} vector defining the name of the file the \n\
+trace is written to, as Chrome trace event JSON, which @code{chrome://tracing} \n\
+or Perfetto display as a timeline of the package and of the kernels. \n\
+@end itemize \n\
 @end itemize \n\
 \n\
 @subheading C API functions relared to the TF_Buffer classdef \n\
@@ -196,6 +696,20 @@ Extra input arguments are identified as @var{in2}, @var{in3}, @var{in3}, etc. \
 @item @var{in3} : vector @code{char} name of Operation in Graph. \n\
 @end itemize \n\
 \n\
+@item @qcode{'TF_GraphOperationsByName'} \n\
+@itemize \n\
+@item @var{out} : @code{uint64} array of pointers to Operations, of the same \n\
+size as @var{in3}, holding 0 for each name not found in the Graph.  The \n\
+names are looked up in a hash index of the Graph, built on the first call \n\
+and rebuilt only after an operation is added to any Graph through the \n\
+package. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Graph. \n\
+@item @var{in3} : vector @code{char} name of Operation, or @code{cellstr} \n\
+array of names of Operations in Graph. \n\
+@end itemize \n\
+\n\
 @item @qcode{'TF_GraphNextOperation'} \n\
 @itemize \n\
 @item @var{out} : two element @code{uint64} vector, the pointer to the \n\
@@ -217,6 +731,65 @@ Graph. \n\
 @item @var{in2} : scalar @code{uint64} pointer to Graph. \n\
 @end itemize \n\
 \n\
+@item @qcode{'TF_GraphOperationTable'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{struct} of column vectors with one row per \n\
+Operation in the Graph, in the order of @qcode{'TF_GraphOperations'}: the \n\
+@code{uint64} @qcode{Pointer}, the @code{cellstr} @qcode{Name}, \n\
+@qcode{OpType} and @qcode{Device}, the @code{int32} @qcode{NumInputs} and \n\
+@qcode{NumOutputs}, and @qcode{OutputTypes}, a @code{cell} of @code{uint32} \n\
+row vectors holding the data type of each output. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Graph. \n\
+@end itemize \n\
+Describes the whole Graph in a single call, in place of one call per \n\
+Operation and per field. \n\
+\n\
+@item @qcode{'TF_GraphAdjacency'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{struct} of the edges of the Graph, holding \n\
+the @code{uint64} column @qcode{Pointer} to every Operation, in the order of \n\
+@qcode{'TF_GraphOperations'}, the @math{m}-by-4 @code{double} matrix \n\
+@qcode{Data} of the data edges and the @math{k}-by-2 @code{double} matrix \n\
+@qcode{Control} of the control edges.  Operations are referred to by their \n\
+row in @qcode{Pointer}.  Each row of @qcode{Data} holds the source row, the \n\
+index of its output, the target row and the index of its input, the indices \n\
+being zero based as in a TF_Output; each row of @qcode{Control} holds the \n\
+source and the target row.  When @var{in3} is true, the @var{n}-by-@var{n} \n\
+sparse matrix @qcode{Adjacency} is added, counting the edges of both kinds \n\
+from the Operation of each row to the Operation of each column. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Graph. \n\
+@item @var{in3} : scalar @code{logical}, optional, true to return the \n\
+sparse matrix as well.  Defaults to false. \n\
+@end itemize \n\
+Walks the whole Graph natively in a single call, in place of a call to \n\
+@qcode{'TF_OperationAllInputs'} and to @qcode{'TF_OperationGetControlInputs'} \n\
+per Operation. \n\
+\n\
+@item @qcode{'TF_GraphPrune'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to a new Graph holding only \n\
+the Operations the fetches depend on through their data and control inputs, \n\
+the walk stopping at the feeds, each fed Operation being replaced with a \n\
+@qcode{Placeholder} of the same data type and shape unless it is one.  The \n\
+new Graph is owned by the caller and must be released with \n\
+@qcode{'TF_DeleteGraph'}. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Graph. \n\
+@item @var{in3} : vector @code{char} name of the fetched Operation, or \n\
+@code{cellstr} array of names of the fetched Operations, each optionally \n\
+followed by @qcode{:index}. \n\
+@item @var{in4} : @code{cellstr} array of names of the fed Operations, \n\
+optional.  A fed Operation must have a single output. \n\
+@end itemize \n\
+The GraphDef of the Graph is exported with @qcode{'TF_GraphToGraphDef'}, \n\
+reduced natively and imported with @qcode{'TF_GraphImportGraphDef'}.  Its \n\
+function library is kept whole. \n\
+\n\
 @item @qcode{'TF_GraphToGraphDef'} \n\
 @itemize \n\
 @item @var{in2} : scalar @code{uint64} pointer to Graph. \n\
@@ -733,6 +1306,27 @@ entry, or a comma separated list of entries. \n\
 @itemize \n\
 @item @var{in2} : scalar @code{uint64} pointer to SessionOptions. \n\
 @end itemize \n\
+\n\
+@item @qcode{'TF_EncodeConfig'} \n\
+@itemize \n\
+@item @var{out} : @code{uint8} row vector holding the serialized \n\
+ConfigProto, for @qcode{'TF_SetConfig'}. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{struct} whose fields are named after those \n\
+of the ConfigProto, any of @qcode{intra_op_parallelism_threads}, \n\
+@qcode{inter_op_parallelism_threads}, @qcode{use_per_session_threads}, \n\
+@qcode{session_inter_op_thread_pool}, @qcode{allow_soft_placement}, and \n\
+@qcode{opt_level} and @qcode{global_jit_level}, which belong to the \n\
+OptimizerOptions of its GraphOptions. \n\
+@end itemize \n\
+Thread counts are non-negative integers, 0 letting TensorFlow choose. \n\
+@qcode{session_inter_op_thread_pool} is a struct array with the fields \n\
+@qcode{num_threads} and @qcode{global_name}, or a vector of thread counts. \n\
+@qcode{opt_level} is @qcode{'L1'} or @qcode{'L0'}, and \n\
+@qcode{global_jit_level} is @qcode{'DEFAULT'}, @qcode{'OFF'}, \n\
+@qcode{'ON_1'} or @qcode{'ON_2'}, or the number of either.  Fields left out \n\
+keep the defaults of TensorFlow. \n\
 @end itemize \n\
 \n\
 @subheading C API functions relared to the TF_Session classdef \n\
@@ -767,6 +1361,25 @@ for none. \n\
 @item @var{in8} : scalar @code{uint64} pointer to Status. \n\
 @end itemize \n\
 \n\
+@item @qcode{'TF_SignatureDefs'} \n\
+@itemize \n\
+@item @var{out} : @code{struct} column vector with one element per \n\
+signature, sorted by name, and the fields @qcode{Name}, @qcode{MethodName}, \n\
+@qcode{Inputs} and @qcode{Outputs}.  @qcode{Inputs} and @qcode{Outputs} are \n\
+@code{struct} column vectors sorted by @qcode{Key}, the name the signature \n\
+gives the tensor, with its @qcode{Name} in the Graph, as \n\
+@qcode{'name:index'}, its @code{uint32} @qcode{DataType} and its @code{int64} \n\
+@qcode{Shape}, where a dimension of unknown size is -1 and a shape of \n\
+unknown rank is empty. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to the MetaGraphDef Buffer \n\
+filled by @qcode{'TF_LoadSessionFromSavedModel'}, or a @code{uint8} vector \n\
+holding a serialized MetaGraphDef. \n\
+@end itemize \n\
+Only the @qcode{signature_def} field of the MetaGraphDef is decoded, the \n\
+GraphDef it also holds being skipped over. \n\
+\n\
 @item @qcode{'TF_SessionRun'} \n\
 @itemize \n\
 @item @var{out} : vector @code{uint64} pointers to the output Tensors, one \n\
@@ -790,6 +1403,94 @@ The number of inputs, outputs and targets is taken from the number of \n\
 elements of the corresponding vectors, hence the 'ninputs', 'noutputs' and \n\
 'ntargets' arguments of the C API function are omitted. \n\
 \n\
+@item @qcode{'TF_SessionPRunSetup'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to the handle of the \n\
+partial run, which the caller must delete with \n\
+@qcode{'TF_DeletePRunHandle'}, and 0 on failure. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Session. \n\
+@item @var{in3} : vector @code{uint64} pointers to the Outputs fed over \n\
+the partial run. \n\
+@item @var{in4} : vector @code{uint64} pointers to the Outputs fetched \n\
+over the partial run. \n\
+@item @var{in5} : vector @code{uint64} pointers to the target Operations, \n\
+which may be empty. \n\
+@item @var{in6} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SessionPRun'} \n\
+@itemize \n\
+@item @var{out} : vector @code{uint64} pointers to the output Tensors, one \n\
+per requested output, which the caller must delete. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Session. \n\
+@item @var{in3} : scalar @code{uint64} pointer to the partial run handle. \n\
+@item @var{in4} : vector @code{uint64} pointers to the input Outputs, a \n\
+subset of those the partial run was set up with. \n\
+@item @var{in5} : vector @code{uint64} pointers to the input Tensors, which \n\
+must have as many elements as @var{in4}. \n\
+@item @var{in6} : vector @code{uint64} pointers to the output Outputs, a \n\
+subset of those the partial run was set up with. \n\
+@item @var{in7} : vector @code{uint64} pointers to the target Operations, \n\
+which may be empty. \n\
+@item @var{in8} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+Each input may be fed and each output fetched once over the partial run, \n\
+and the state computed in between stays inside TensorFlow. \n\
+\n\
+@item @qcode{'TF_DeletePRunHandle'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to the partial run handle. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SessionRunValues'} \n\
+@itemize \n\
+@item @var{out} : @code{cell} row vector of Octave arrays, one per output \n\
+Output. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Session. \n\
+@item @var{in3} : vector @code{uint64} pointers to the input Outputs. \n\
+@item @var{in4} : @code{cell} array of values, one per input Output. \n\
+@item @var{in5} : vector @code{uint64} pointers to the output Outputs. \n\
+@item @var{in6} : (optional) @code{char} vector defining the layout of \n\
+the values, as for @qcode{'TF_LoadTensor'}. \n\
+@item @var{in7} : (optional) @code{logical} vector flagging the elements \n\
+of @var{in4} which are @code{uint64} pointers to Tensors owned by the \n\
+caller, fed as they are. \n\
+@end itemize \n\
+Equivalent to loading each value with @qcode{'TF_LoadTensor'}, running \n\
+@qcode{'TF_SessionRun'} and saving each output with @qcode{'TF_SaveTensor'}, \n\
+in a single call which releases every Tensor it builds before returning, \n\
+including when an error is raised.  A failed run raises the message of its \n\
+Status as an error.  A @code{double} or @code{single} value fed to a \n\
+@qcode{TF_FLOAT} or @qcode{TF_DOUBLE} input is loaded as the data type of \n\
+the input, read with @qcode{'TF_OperationOutputType'}, in the pass that \n\
+repositions it. \n\
+\n\
+@item @qcode{'TF_SessionProfile'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{struct} with an @qcode{outputs} field, as \n\
+returned by @qcode{'TF_SessionRunValues'}, and a @qcode{nodes} field, a \n\
+@code{struct} column vector with one element per node executed, in the \n\
+order they started, and the fields @qcode{Name}, @qcode{Op}, \n\
+@qcode{Device}, @qcode{StartMicros}, @qcode{WallMicros} and \n\
+@qcode{OutputBytes}. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} to @var{in7} : as for @qcode{'TF_SessionRunValues'}. \n\
+@end itemize \n\
+Runs the Session as @qcode{'TF_SessionRunValues'} does, with the \n\
+@qcode{trace_level} of its RunOptions set to @qcode{FULL_TRACE}, and decodes \n\
+the StepStats of the RunMetadata it records.  @qcode{StartMicros} is the time \n\
+the node started since the first node started, @qcode{WallMicros} the time it \n\
+took, both in microseconds, and @qcode{OutputBytes} the bytes allocated for \n\
+its output Tensors.  @qcode{Op} is empty for the nodes whose type the \n\
+runtime does not record. \n\
+\n\
 @item @qcode{'TF_SessionListDevices'} \n\
 @itemize \n\
 @item @var{out} : scalar @code{uint64} pointer to DeviceList, which the \n\
@@ -800,6 +1501,25 @@ caller must delete. \n\
 @item @var{in3} : scalar @code{uint64} pointer to Status. \n\
 @end itemize \n\
 \n\
+@item @qcode{'TF_SessionPoolStats'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{struct} with the fields @qcode{hits}, \n\
+@qcode{misses}, @qcode{rate}, @qcode{held} and @qcode{idle}: the number of \n\
+Tensors fed to the Session over a buffer taken from its pool and over one \n\
+allocated for them, the fraction of the former, and the bytes of every \n\
+buffer of the pool and of those idle in it. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Session. \n\
+@end itemize \n\
+The values @qcode{'TF_SessionRunValues'}, @qcode{'TF_RunnerRun'}, \n\
+@qcode{'TF_SessionProfile'} and @qcode{'TF_SessionRunAsync'} copy into a \n\
+Tensor are copied into 64 byte aligned buffers kept by the Session, one \n\
+pool of them for each data type and shape.  A buffer goes back to the pool \n\
+when its Tensor is released, to be reused by the next run, and the pool \n\
+is freed by @qcode{'TF_DeleteSession'}.  Values a Tensor borrows the \n\
+buffer of take nothing from the pool. \n\
+ \n\
 @item @qcode{'TF_CloseSession'} \n\
 @itemize \n\
 @item @var{in2} : scalar @code{uint64} pointer to Session. \n\
@@ -813,100 +1533,317 @@ caller must delete. \n\
 @end itemize \n\
 @end itemize \n\
 \n\
-@subheading C API functions relared to the TF_DeviceList classdef \n\
+@subheading OCTAVE specific functions relared to the TF_Runner classdef \n\
 @itemize \n\
-@item @qcode{'TF_DeviceListCount'} \n\
+@item @qcode{'TF_NewRunner'} \n\
 @itemize \n\
-@item @var{out} : scalar number of devices in DeviceList. \n\
+@item @var{out} : scalar @code{uint64} pointer to new Runner, which holds \n\
+the Session together with its inputs and outputs and a Status reused by \n\
+every run. \n\
 @end itemize \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@item @var{in2} : scalar @code{uint64} pointer to Session, which must \n\
+outlive the Runner. \n\
+@item @var{in3} : vector @code{uint64} pointers to the input Outputs. \n\
+@item @var{in4} : vector @code{uint64} pointers to the output Outputs. \n\
+@item @var{in5} : (optional) @code{char} vector defining the layout of \n\
+the values, as for @qcode{'TF_LoadTensor'}. \n\
 @end itemize \n\
+The Outputs are copied into the Runner and may be deleted once it is \n\
+created. \n\
 \n\
-@item @qcode{'TF_DeviceListName'} \n\
-@itemize \n\
-@item @var{out} : vector @code{char} full name of the device, which is empty \n\
-if the index is out of bounds. \n\
-@end itemize \n\
+@item @qcode{'TF_DeleteRunner'} \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
-@item @var{in3} : scalar @code{int32} zero based device index. \n\
-@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in2} : scalar @code{uint64} pointer to Runner. \n\
 @end itemize \n\
 \n\
-@item @qcode{'TF_DeviceListType'} \n\
+@item @qcode{'TF_RunnerRun'} \n\
 @itemize \n\
-@item @var{out} : vector @code{char} type of the device, which is empty if \n\
-the index is out of bounds. \n\
+@item @var{out} : @code{cell} row vector of Octave arrays, one per output \n\
+of the Runner. \n\
 @end itemize \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
-@item @var{in3} : scalar @code{int32} zero based device index. \n\
-@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in2} : scalar @code{uint64} pointer to Runner. \n\
+@item @var{in3} : @code{cell} array of values, one per input of the \n\
+Runner. \n\
+@item @var{in4} : (optional) @code{logical} vector flagging the elements \n\
+of @var{in3} which are @code{uint64} pointers to Tensors owned by the \n\
+caller, fed as they are.  The rest are Octave arrays converted as by \n\
+@qcode{'TF_SessionRunValues'} converts them. \n\
+@end itemize \n\
+The values are converted, the Graph is executed and the outputs are \n\
+converted back in a single call, and every Tensor built along the way is \n\
+released before returning, including when an error is raised. \n\
 @end itemize \n\
 \n\
-@item @qcode{'TF_DeviceListMemoryBytes'} \n\
+@subheading OCTAVE specific functions relared to the TF_AsyncRun classdef \n\
 @itemize \n\
-@item @var{out} : scalar @code{int64} memory of the device, which is -1 if \n\
-the index is out of bounds. \n\
+@item @qcode{'TF_SessionRunAsync'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to new AsyncRun, which the \n\
+caller must delete with @qcode{'TF_DeleteAsyncRun'}. \n\
 @end itemize \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
-@item @var{in3} : scalar @code{int32} zero based device index. \n\
-@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in2} to @var{in7} : as for @qcode{'TF_SessionRunValues'}. \n\
 @end itemize \n\
+The values are converted to Tensors before returning, and the Session is \n\
+run on a worker thread meanwhile.  Tensors owned by the caller among the \n\
+values must be kept until the AsyncRun is deleted. \n\
 \n\
-@item @qcode{'TF_DeviceListIncarnation'} \n\
+@item @qcode{'TF_AsyncRunIsDone'} \n\
 @itemize \n\
-@item @var{out} : scalar @code{uint64} incarnation number of the device, \n\
-which is 0 if the index is out of bounds. \n\
+@item @var{out} : logical scalar, true once the run has completed. \n\
 @end itemize \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
-@item @var{in3} : scalar @code{int32} zero based device index. \n\
-@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in2} : scalar @code{uint64} pointer to AsyncRun. \n\
 @end itemize \n\
 \n\
-@item @qcode{'TF_DeleteDeviceList'} \n\
+@item @qcode{'TF_AsyncRunWait'} \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@item @var{out} : logical scalar, true if the run completed in time. \n\
 @end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to AsyncRun. \n\
+@item @var{in3} : (optional) non-negative scalar timeout in seconds, which \n\
+defaults to @code{Inf}. \n\
 @end itemize \n\
 \n\
-@subheading C API functions relared to the TF_Status classdef \n\
+@item @qcode{'TF_AsyncRunFetch'} \n\
 @itemize \n\
-@item @qcode{'TF_NewStatus'} \n\
+@item @var{out} : @code{cell} row vector of Octave arrays, one per output \n\
+Output. \n\
+@end itemize \n\
 @itemize \n\
-@item @var{out} : scalar @code{uint64} pointer to new Status. \n\
+@item @var{in2} : scalar @code{uint64} pointer to AsyncRun. \n\
 @end itemize \n\
+Waits for the run to complete.  A failed run raises the message of its \n\
+Status as an error, and the outputs can only be fetched once. \n\
 \n\
-@item @qcode{'TF_DeleteStatus'} \n\
+@item @qcode{'TF_DeleteAsyncRun'} \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in2} : scalar @code{uint64} pointer to AsyncRun. \n\
+@end itemize \n\
+Waits for a run still executing, and releases every Tensor it holds. \n\
 @end itemize \n\
 \n\
-@item @qcode{'TF_SetStatus'} \n\
+@subheading OCTAVE specific functions relared to the TFModel classdef \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
-@item @var{in3} : scalar @code{uint32} Code to Status. \n\
-@item @var{in4} : vector @code{char} message to Status. \n\
+@item @qcode{'TF_NewBatcher'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to new Batcher, a queue of \n\
+requests run in batches on a worker thread. \n\
 @end itemize \n\
-\n\
-@item @qcode{'TF_SetPayload'} \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
-@item @var{in3} : vector @code{char} 'key' as payload to Status. \n\
-@item @var{in4} : vector @code{char} 'value' as payload to Status. \n\
+@item @var{in2} : scalar @code{uint64} pointer to Session, which must \n\
+outlive the Batcher. \n\
+@item @var{in3} : vector @code{uint64} pointers to the input Outputs. \n\
+@item @var{in4} : vector @code{uint64} pointers to the output Outputs. \n\
+@item @var{in5} : positive integer scalar, the most rows a batch gathers. \n\
+@item @var{in6} : non-negative scalar, the longest time in seconds a \n\
+request waits for others to join its batch. \n\
+@item @var{in7} : (optional) @code{char} vector defining the layout of \n\
+the values, as for @qcode{'TF_LoadTensor'}. \n\
 @end itemize \n\
+The Outputs are copied into the Batcher and may be deleted once it is \n\
+created. \n\
 \n\
-@item @qcode{'TF_SetStatus'} \n\
+@item @qcode{'TF_BatcherSubmit'} \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
-@item @var{in3} : scalar @code{int32} I/O error code. \n\
-@item @var{in4} : vector @code{char} message for I/O error code. \n\
+@item @var{out} : scalar @code{uint64} ticket of the request. \n\
 @end itemize \n\
-\n\
-@item @qcode{'TF_GetCode'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Batcher. \n\
+@item @var{in3} : @code{cell} array of Octave arrays, one per input of the \n\
+Batcher, all with as many rows. \n\
+@end itemize \n\
+The values are converted and the request is queued.  The requests of a \n\
+batch are concatenated along the first dimension of the arrays, or the last \n\
+one in native layout, and each gets its own rows of the outputs back.  A \n\
+batch is run once it holds @var{in5} rows or its oldest request has waited \n\
+@var{in6} seconds, and only gathers requests whose values agree in type and \n\
+in every other dimension. \n\
+\n\
+@item @qcode{'TF_BatcherCollect'} \n\
+@itemize \n\
+@item @var{out} : @code{cell} row vector of Octave arrays, one per output \n\
+of the Batcher. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Batcher. \n\
+@item @var{in3} : scalar @code{uint64} ticket of a request. \n\
+@end itemize \n\
+A request still queued is run straight away along with those queued before \n\
+it.  A failed run raises the message of its Status as an error, and each \n\
+ticket is collected once. \n\
+\n\
+@item @qcode{'TF_BatcherStats'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{struct} with the fields @qcode{requests}, \n\
+@qcode{batches}, @qcode{largest} and @qcode{pending}: the number of \n\
+requests submitted, of batches run, of rows in the largest batch and of \n\
+requests still queued. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Batcher. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeleteBatcher'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Batcher. \n\
+@end itemize \n\
+Drops the requests still queued and waits for a batch being run. \n\
+@end itemize \n\
+\n\
+@subheading OCTAVE specific functions relared to the TFModelPool classdef \n\
+@itemize \n\
+@item @qcode{'TF_NewModelPool'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to new ModelPool, which \n\
+runs requests on whichever of the Runners is idle. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : vector @code{uint64} pointers to Runners over Sessions \n\
+of the same model, sharing their inputs, outputs and layout, which must \n\
+outlive the ModelPool. \n\
+@end itemize \n\
+A worker thread is started for each Runner, which it uses alone. \n\
+\n\
+@item @qcode{'TF_ModelPoolSubmit'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} ticket of the request. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to ModelPool. \n\
+@item @var{in3} : @code{cell} array of Octave arrays, one per input of the \n\
+Runners. \n\
+@end itemize \n\
+The values are converted and the request is queued for the next idle \n\
+Session. \n\
+\n\
+@item @qcode{'TF_ModelPoolCollect'} \n\
+@itemize \n\
+@item @var{out} : @code{cell} row vector of Octave arrays, one per output \n\
+of the Runners. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to ModelPool. \n\
+@item @var{in3} : scalar @code{uint64} ticket of a request. \n\
+@end itemize \n\
+Waits for the request to be run.  A failed run raises the message of its \n\
+Status as an error, and each ticket is collected once. \n\
+\n\
+@item @qcode{'TF_ModelPoolStats'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{struct} with the fields @qcode{sessions}, \n\
+@qcode{requests}, @qcode{pending} and @qcode{busy}, counting the Sessions, \n\
+the requests submitted, those still queued and the Sessions running one, \n\
+and @qcode{runs}, a row vector of the number of runs made by each Session. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to ModelPool. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeleteModelPool'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to ModelPool. \n\
+@end itemize \n\
+Drops the requests still queued and waits for those being run. \n\
+@end itemize \n\
+\n\
+@subheading C API functions relared to the TF_DeviceList classdef \n\
+@itemize \n\
+@item @qcode{'TF_DeviceListCount'} \n\
+@itemize \n\
+@item @var{out} : scalar number of devices in DeviceList. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeviceListName'} \n\
+@itemize \n\
+@item @var{out} : vector @code{char} full name of the device, which is empty \n\
+if the index is out of bounds. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@item @var{in3} : scalar @code{int32} zero based device index. \n\
+@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeviceListType'} \n\
+@itemize \n\
+@item @var{out} : vector @code{char} type of the device, which is empty if \n\
+the index is out of bounds. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@item @var{in3} : scalar @code{int32} zero based device index. \n\
+@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeviceListMemoryBytes'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{int64} memory of the device, which is -1 if \n\
+the index is out of bounds. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@item @var{in3} : scalar @code{int32} zero based device index. \n\
+@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeviceListIncarnation'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} incarnation number of the device, \n\
+which is 0 if the index is out of bounds. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@item @var{in3} : scalar @code{int32} zero based device index. \n\
+@item @var{in4} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeleteDeviceList'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to DeviceList. \n\
+@end itemize \n\
+@end itemize \n\
+\n\
+@subheading C API functions relared to the TF_Status classdef \n\
+@itemize \n\
+@item @qcode{'TF_NewStatus'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to new Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_DeleteStatus'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SetStatus'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in3} : scalar @code{uint32} Code to Status. \n\
+@item @var{in4} : vector @code{char} message to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SetPayload'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in3} : vector @code{char} 'key' as payload to Status. \n\
+@item @var{in4} : vector @code{char} 'value' as payload to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SetStatus'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
+@item @var{in3} : scalar @code{int32} I/O error code. \n\
+@item @var{in4} : vector @code{char} message for I/O error code. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_GetCode'} \n\
 @itemize \n\
 @item @var{out} : scalar @code{uint32} Code from Status. \n\
 @end itemize \n\
@@ -1005,14 +1942,64 @@ which is 0 if the index is out of bounds. \n\
 @end itemize \n\
 @itemize \n\
 @item @var{in2} : any non-empty value of supported DataType. \n\
+@item @var{in3} : (optional) layout, either @qcode{'rowmajor'} (default), \n\
+which repositions the elements so that the Tensor has the shape of @var{in2}, \n\
+or @qcode{'native'}, which gives the Tensor the dimensions of @var{in2} in \n\
+reverse order and copies the data as it is. \n\
+@item @var{in4} : (optional) scalar @code{uint32} TF_DataType of the \n\
+Tensor.  A @code{double} array is converted to @qcode{TF_FLOAT} and a \n\
+@code{single} one to @qcode{TF_DOUBLE}, and either to @qcode{TF_HALF} or \n\
+@qcode{TF_BFLOAT16}, rounding to nearest even, in the same pass that \n\
+repositions the elements, using the AVX, F16C or AVX-512 instructions when \n\
+the processor has them.  An @code{int8}, @code{uint8}, \n\
+@code{int16}, @code{uint16} or @code{int32} array is loaded as it is into \n\
+the quantized type of the same width, @qcode{TF_QINT8}, @qcode{TF_QUINT8}, \n\
+@qcode{TF_QINT16}, @qcode{TF_QUINT16} or @qcode{TF_QINT32}.  A \n\
+@code{single} or @code{double} array is converted to @qcode{TF_FLOAT8_E5M2} \n\
+or @qcode{TF_FLOAT8_E4M3FN}, rounding to nearest even, values beyond the \n\
+range becoming infinity or NaN respectively, and an @code{int8} or \n\
+@code{uint8} array to @qcode{TF_INT4} or @qcode{TF_UINT4}, saturating to \n\
+the range of 4 bits, each value held in a byte of its own.  Any other \n\
+array must already be of the requested type.  Defaults to the type of \n\
+@var{in2}. \n\
 @end itemize \n\
 \n\
 @item @qcode{'TF_SaveTensor'} \n\
 @itemize \n\
-@item @var{out} : any value of supported DataType. \n\
+@item @var{out} : any value of supported DataType.  A Tensor of \n\
+@qcode{TF_HALF}, @qcode{TF_BFLOAT16}, @qcode{TF_FLOAT8_E5M2} or \n\
+@qcode{TF_FLOAT8_E4M3FN} is returned as a @code{single} array, one of \n\
+@qcode{TF_INT4} or @qcode{TF_UINT4} as an @code{int8} or @code{uint8} \n\
+array, and a quantized Tensor as an array of the integer type of the same \n\
+width, unless @var{in5} is given. \n\
 @end itemize \n\
 @itemize \n\
 @item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@item @var{in3} : (optional) layout, either @qcode{'rowmajor'} (default) or \n\
+@qcode{'native'}, which returns an array of the dimensions of the Tensor in \n\
+reverse order with the data copied as it is. \n\
+@item @var{in4} : (optional) logical scalar, @code{true} to hand the Tensor \n\
+over, which must then not be used or deleted any more.  When no \n\
+repositioning is needed the returned array is then built over the buffer of \n\
+the Tensor, which is released along with the array.  Defaults to \n\
+@code{false}. \n\
+@item @var{in5} : (optional) two element vector of the scale and the zero \n\
+point of a quantized Tensor, which is then returned as a @code{single} \n\
+array of @code{(q - zero_point) * scale}, computed in the same pass that \n\
+repositions the elements. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SetConversionThreads'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{int32} number of threads used so far. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : non-negative integer scalar, number of threads the \n\
+conversion between column major and row major storage is split across in \n\
+@qcode{'TF_LoadTensor'} and @qcode{'TF_SaveTensor'}, or 0 for one thread per \n\
+processor.  Arrays under 2 MiB are always converted on a single thread.  The \n\
+initial value is taken from the @env{OCT_TF_CONVERSION_THREADS} environment \n\
+variable, or is 1 when it is not set. \n\
 @end itemize \n\
 \n\
 @item @qcode{'TF_NewTensor'} \n\
@@ -1056,665 +2043,115 @@ which is 0 if the index is out of bounds. \n\
 @item @var{out} : scalar @code{uint32} DataType code of Tensor. \n\
 @end itemize \n\
 @itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_SetShape'} \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@item @var{in3} : scalar @code{int64} size of dimensions for new Tensor. \n\
-@item @var{in4} : scalar @code{int32} number of dimensions for new Tensor. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_NumDims'} \n\
-@itemize \n\
-@item @var{out} : scalar @code{int32} number of dimensions of Tensor. \n\
-@end itemize \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_Dim'} \n\
-@itemize \n\
-@item @var{out} : vector @code{int64} size of indexed dimension of Tensor. \n\
-@end itemize \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@item @var{in3} : scalar @code{int32} dimension index. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_TensorByteSize'} \n\
-@itemize \n\
-@item @var{out} : vector @code{uint64} bytesize of Tensor. \n\
-@end itemize \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_TensorData'} \n\
-@itemize \n\
-@item @var{out} : scalar @code{uint64} pointer to data from Tensor. \n\
-@end itemize \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_TensorFromProto'} \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Buffer. \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_TensorElementCount'} \n\
-@itemize \n\
-@item @var{out} : scalar @code{int64} number of elements in Tensor. \n\
-@end itemize \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_TensorBitcastFrom'} \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to source Tensor. \n\
-@item @var{in3} : scalar @code{uint32} DataType code for target Tensor. \n\
-@item @var{in4} : scalar @code{uint64} pointer to target Tensor. \n\
-@item @var{in5} : scalar @code{int64} size of dimensions for new Tensor. \n\
-@item @var{in6} : scalar @code{int32} number of dimensions for new Tensor. \n\
-@item @var{in7} : scalar @code{uint64} pointer to Status. \n\
-@end itemize \n\
-\n\
-@item @qcode{'TF_TensorIsAligned'} \n\
-@itemize \n\
-@item @var{out} : scalar @code{bool} value for Tensor alignment. \n\
-@end itemize \n\
-@itemize \n\
-@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
-@end itemize \n\
-@end itemize \n\
-\n\
-@end deftypefn")
-{
-  int nlhs = nargout;
-	int nrhs = args.length();
-	octave_value plhs;
-  if (nrhs == 0)
-  {
-    printf ("tensorflow: This is a TensorFlow binding for GNU Octave.\n");
-    return plhs;
-  }
-  if (! args(0).is_string())
-  {
-    error ("tensorflow: first argument must be a character "
-           "vector referencing a C API function.");
-  }
-  string c_api = args(0).string_value();
-
-  // Select C_API handler
-  // ---------------------------------------------------------------------------
-  if (c_api == "TF_Version")
-  {
-    const char* out = TF_Version ();
-    plhs = out;
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Buffer classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewBuffer")
-  {
-    plhs = OCT_TF_NewBuffer (nrhs, args);
-  }
-  else if (c_api == "TF_DeleteBuffer")
-  {
-    OCT_TF_DeleteBuffer (nrhs, args);
-  }
-  else if (c_api == "TF_NewBufferFromString")
-  {
-    plhs = OCT_TF_NewBufferFromString (nrhs, args);
-  }
-  else if (c_api == "TF_GetBuffer")
-  {
-    plhs = OCT_TF_GetBuffer (nrhs, args);
-  }
-  else if (c_api == "TF_GetBufferToString")        // OCTAVE specific
-  {
-    plhs = OCT_TF_GetBufferToString (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_DataType classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_DataTypeName")             // OCTAVE specific
-  {
-    plhs = OCT_TF_DataTypeName (nrhs, args);
-  }
-  else if (c_api == "TF_DataTypeSize")
-  {
-    plhs = OCT_TF_DataTypeSize (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_DeviceList classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_DeleteDeviceList")
-  {
-    OCT_TF_DeleteDeviceList (nrhs, args);
-  }
-  else if (c_api == "TF_DeviceListCount")
-  {
-    plhs = OCT_TF_DeviceListCount (nrhs, args);
-  }
-  else if (c_api == "TF_DeviceListName")
-  {
-    plhs = OCT_TF_DeviceListName (nrhs, args);
-  }
-  else if (c_api == "TF_DeviceListType")
-  {
-    plhs = OCT_TF_DeviceListType (nrhs, args);
-  }
-  else if (c_api == "TF_DeviceListMemoryBytes")
-  {
-    plhs = OCT_TF_DeviceListMemoryBytes (nrhs, args);
-  }
-  else if (c_api == "TF_DeviceListIncarnation")
-  {
-    plhs = OCT_TF_DeviceListIncarnation (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Graph classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewGraph")
-  {
-    plhs = OCT_TF_NewGraph ();
-  }
-  else if (c_api == "TF_DeleteGraph")
-  {
-    OCT_TF_DeleteGraph (nrhs, args);
-  }
-  else if (c_api == "TF_GraphSetTensorShape")
-  {
-    OCT_TF_GraphSetTensorShape (nrhs, args);
-  }
-  else if (c_api == "TF_GraphGetTensorNumDims")
-  {
-    plhs = OCT_TF_GraphGetTensorNumDims (nrhs, args);
-  }
-  else if (c_api == "TF_GraphGetTensorShape")
-  {
-    plhs = OCT_TF_GraphGetTensorShape (nrhs, args);
-  }
-  else if (c_api == "TF_NewOperationLocked")
-  {
-    plhs = OCT_TF_NewOperationLocked (nrhs, args);
-  }
-  else if (c_api == "TF_NewOperation")
-  {
-    plhs = OCT_TF_NewOperation (nrhs, args);
-  }
-  else if (c_api == "TF_GraphOperationByName")
-  {
-    plhs = OCT_TF_GraphOperationByName (nrhs, args);
-  }
-  else if (c_api == "TF_GraphNextOperation")
-  {
-    plhs = OCT_TF_GraphNextOperation (nrhs, args);
-  }
-  else if (c_api == "TF_GraphOperations")          // OCTAVE specific
-  {
-    plhs = OCT_TF_GraphOperations (nrhs, args);
-  }
-  else if (c_api == "TF_GraphToGraphDef")
-  {
-    OCT_TF_GraphToGraphDef (nrhs, args);
-  }
-  else if (c_api == "TF_GraphGetOpDef")
-  {
-    OCT_TF_GraphGetOpDef (nrhs, args);
-  }
-  else if (c_api == "TF_GraphVersions")
-  {
-    OCT_TF_GraphVersions (nrhs, args);
-  }
-  else if (c_api == "TF_GraphImportGraphDefWithResults")
-  {
-    plhs = OCT_TF_GraphImportGraphDefWithResults (nrhs, args);
-  }
-  else if (c_api == "TF_GraphImportGraphDefWithReturnOutputs")
-  {
-    OCT_TF_GraphImportGraphDefWithReturnOutputs (nrhs, args);
-  }
-  else if (c_api == "TF_GraphImportGraphDef")
-  {
-    OCT_TF_GraphImportGraphDef (nrhs, args);
-  }
-  else if (c_api == "TF_GraphCopyFunction")
-  {
-    OCT_TF_GraphCopyFunction (nrhs, args);
-  }
-  else if (c_api == "TF_GraphNumFunctions")
-  {
-    plhs = OCT_TF_GraphNumFunctions (nrhs, args);
-  }
-  else if (c_api == "TF_GraphGetFunctions")
-  {
-    plhs = OCT_TF_GraphGetFunctions (nrhs, args);
-  }
-  else if (c_api == "TF_NewWhile")
-  {
-    plhs = OCT_TF_NewWhile (nrhs, args);
-  }
-  else if (c_api == "TF_AddGradients")
-  {
-    OCT_TF_AddGradients (nrhs, args);
-  }
-  else if (c_api == "TF_AddGradientsWithPrefix")
-  {
-    OCT_TF_AddGradientsWithPrefix (nrhs, args);
-  }
-  else if (c_api == "TF_GraphToFunction")
-  {
-    plhs = OCT_TF_GraphToFunction (nrhs, args);
-  }
-  else if (c_api == "TF_GraphToFunctionWithControlOutputs")
-  {
-    plhs = OCT_TF_GraphToFunctionWithControlOutputs (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Input classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewInput")                 // OCTAVE specific
-  {
-    plhs = OCT_TF_NewInput (nrhs, args);
-  }
-  else if (c_api == "TF_DeleteInput")              // OCTAVE specific
-  {
-    OCT_TF_DeleteInput (nrhs, args);
-  }
-  else if (c_api == "TF_OperationInputType")
-  {
-    plhs = OCT_TF_OperationInputType (nrhs, args);
-  }
-  else if (c_api == "TF_OperationInput")
-  {
-    plhs = OCT_TF_OperationInput (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Operation classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_OperationName")
-  {
-    plhs = OCT_TF_OperationName (nrhs, args);
-  }
-  else if (c_api == "TF_OperationOpType")
-  {
-    plhs = OCT_TF_OperationOpType (nrhs, args);
-  }
-  else if (c_api == "TF_OperationDevice")
-  {
-    plhs = OCT_TF_OperationDevice (nrhs, args);
-  }
-  else if (c_api == "TF_OperationNumOutputs")
-  {
-    plhs = OCT_TF_OperationNumOutputs (nrhs, args);
-  }
-  else if (c_api == "TF_OperationOutputListLength")
-  {
-    plhs = OCT_TF_OperationOutputListLength (nrhs, args);
-  }
-  else if (c_api == "TF_OperationNumInputs")
-  {
-    plhs = OCT_TF_OperationNumInputs (nrhs, args);
-  }
-  else if (c_api == "TF_OperationInputListLength")
-  {
-    plhs = OCT_TF_OperationInputListLength (nrhs, args);
-  }
-  else if (c_api == "TF_OperationAllInputs")
-  {
-    plhs = OCT_TF_OperationAllInputs (nrhs, args);
-  }
-  else if (c_api == "TF_OperationNumControlInputs")
-  {
-    plhs = OCT_TF_OperationNumControlInputs (nrhs, args);
-  }
-  else if (c_api == "TF_OperationGetControlInputs")
-  {
-    plhs = OCT_TF_OperationGetControlInputs (nrhs, args);
-  }
-  else if (c_api == "TF_OperationNumControlOutputs")
-  {
-    plhs = OCT_TF_OperationNumControlOutputs (nrhs, args);
-  }
-  else if (c_api == "TF_OperationGetControlOutputs")
-  {
-    plhs = OCT_TF_OperationGetControlOutputs (nrhs, args);
-  }
-
-
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_OperationDescription classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_SetDevice")
-  {
-    OCT_TF_SetDevice (nrhs, args);
-  }
-  else if (c_api == "TF_AddInput")
-  {
-    OCT_TF_AddInput (nrhs, args);
-  }
-  else if (c_api == "TF_AddInputList")
-  {
-    OCT_TF_AddInputList (nrhs, args);
-  }
-  else if (c_api == "TF_AddControlInput")
-  {
-    OCT_TF_AddControlInput (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrString")
-  {
-    OCT_TF_SetAttrString (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrStringList")
-  {
-    OCT_TF_SetAttrStringList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrInt")
-  {
-    OCT_TF_SetAttrInt (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrIntList")
-  {
-    OCT_TF_SetAttrIntList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrFloat")
-  {
-    OCT_TF_SetAttrFloat (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrFloatList")
-  {
-    OCT_TF_SetAttrFloatList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrBool")
-  {
-    OCT_TF_SetAttrBool (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrBoolList")
-  {
-    OCT_TF_SetAttrBoolList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrType")
-  {
-    OCT_TF_SetAttrType (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrTypeList")
-  {
-    OCT_TF_SetAttrTypeList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrPlaceholder")
-  {
-    OCT_TF_SetAttrPlaceholder (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrFuncName")
-  {
-    OCT_TF_SetAttrFuncName (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrShape")
-  {
-    OCT_TF_SetAttrShape (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrShapeList")
-  {
-    OCT_TF_SetAttrShapeList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrTensorShapeProto")
-  {
-    OCT_TF_SetAttrTensorShapeProto (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrTensorShapeProtoList")
-  {
-    OCT_TF_SetAttrTensorShapeProtoList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrTensor")
-  {
-    OCT_TF_SetAttrTensor (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrTensorList")
-  {
-    OCT_TF_SetAttrTensorList (nrhs, args);
-  }
-  else if (c_api == "TF_SetAttrValueProto")
-  {
-    OCT_TF_SetAttrValueProto (nrhs, args);
-  }
-  else if (c_api == "TF_FinishOperationLocked")
-  {
-    plhs = OCT_TF_FinishOperationLocked (nrhs, args);
-  }
-  else if (c_api == "TF_FinishOperation")
-  {
-    plhs = OCT_TF_FinishOperation (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Output classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewOutput")                // OCTAVE specific
-  {
-    plhs = OCT_TF_NewOutput (nrhs, args);
-  }
-  else if (c_api == "TF_DeleteOutput")             // OCTAVE specific
-  {
-    OCT_TF_DeleteOutput (nrhs, args);
-  }
-  else if (c_api == "TF_OperationOutputType")
-  {
-    plhs = OCT_TF_OperationOutputType (nrhs, args);
-  }
-  else if (c_api == "TF_OperationOutputNumConsumers")
-  {
-    plhs = OCT_TF_OperationOutputNumConsumers (nrhs, args);
-  }
-  else if (c_api == "TF_OperationOutputConsumers")
-  {
-    plhs = OCT_TF_OperationOutputConsumers (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Session classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewSession")
-  {
-    plhs = OCT_TF_NewSession (nrhs, args);
-  }
-  else if (c_api == "TF_LoadSessionFromSavedModel")
-  {
-    plhs = OCT_TF_LoadSessionFromSavedModel (nrhs, args);
-  }
-  else if (c_api == "TF_CloseSession")
-  {
-    OCT_TF_CloseSession (nrhs, args);
-  }
-  else if (c_api == "TF_DeleteSession")
-  {
-    OCT_TF_DeleteSession (nrhs, args);
-  }
-  else if (c_api == "TF_SessionRun")
-  {
-    plhs = OCT_TF_SessionRun (nrhs, args);
-  }
-  else if (c_api == "TF_SessionListDevices")
-  {
-    plhs = OCT_TF_SessionListDevices (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_SessionOptions classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewSessionOptions")
-  {
-    plhs = OCT_TF_NewSessionOptions ();
-  }
-  else if (c_api == "TF_SetTarget")
-  {
-    OCT_TF_SetTarget (nrhs, args);
-  }
-  else if (c_api == "TF_SetConfig")
-  {
-    OCT_TF_SetConfig (nrhs, args);
-  }
-  else if (c_api == "TF_DeleteSessionOptions")
-  {
-    OCT_TF_DeleteSessionOptions (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Status classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewStatus")
-  {
-    plhs = OCT_TF_NewStatus ();
-  }
-  else if (c_api == "TF_DeleteStatus")
-  {
-    OCT_TF_DeleteStatus (nrhs, args);
-  }
-  else if (c_api == "TF_SetStatus")
-  {
-    OCT_TF_SetStatus (nrhs, args);
-  }
-  else if (c_api == "TF_SetPayload")
-  {
-    OCT_TF_SetPayload (nrhs, args);
-  }
-  else if (c_api == "TF_ForEachPayload")
-  {
-    OCT_TF_ForEachPayload (nrhs, args);
-  }
-  else if (c_api == "TF_SetStatusFromIOError")
-  {
-    OCT_TF_SetStatusFromIOError (nrhs, args);
-  }
-  else if (c_api == "TF_GetCode")
-  {
-    plhs = OCT_TF_GetCode (nrhs, args);
-  }
-  else if (c_api == "TF_Message")
-  {
-    plhs = OCT_TF_Message (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_String classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_NewTString")               // OCTAVE specific
-  {
-    plhs = OCT_TF_NewTString ();
-  }
-  else if (c_api == "TF_LoadTString")              // OCTAVE specific
-  {
-    plhs = OCT_TF_LoadTString (nrhs, args);
-  }
-  else if (c_api == "TF_SaveTString")              // OCTAVE specific
-  {
-    plhs = OCT_TF_SaveTString (nrhs, args);
-  }
-  else if (c_api == "TF_StringInit")
-  {
-    OCT_TF_StringInit (nrhs, args);
-  }
-  else if (c_api == "TF_StringCopy")
-  {
-    OCT_TF_StringCopy (nrhs, args);
-  }
-  else if (c_api == "TF_StringAssignView")
-  {
-    OCT_TF_StringAssignView (nrhs, args);
-  }
-  else if (c_api == "TF_StringGetDataPointer")
-  {
-    plhs = OCT_TF_StringGetDataPointer (nrhs, args);
-  }
-  else if (c_api == "TF_StringGetType")
-  {
-    plhs = OCT_TF_StringGetType (nrhs, args);
-  }
-  else if (c_api == "TF_StringGetSize")
-  {
-    plhs = OCT_TF_StringGetSize (nrhs, args);
-  }
-  else if (c_api == "TF_StringGetCapacity")
-  {
-    plhs = OCT_TF_StringGetCapacity (nrhs, args);
-  }
-  else if (c_api == "TF_StringDealloc")
-  {
-    OCT_TF_StringDealloc (nrhs, args);
-  }
-  // ---------------------------------------------------------------------------
-  // C API functions referenced by the TF_Tensor classdef
-  // ---------------------------------------------------------------------------
-  else if (c_api == "TF_LoadTensor")               // OCTAVE specific
-  {
-    plhs = OCT_TF_LoadTensor (nrhs, args);
-  }
-  else if (c_api == "TF_SaveTensor")               // OCTAVE specific
-  {
-    plhs = OCT_TF_SaveTensor (nrhs, args);
-  }
-  else if (c_api == "TF_NewTensor")
-  {
-    plhs = OCT_TF_NewTensor (nrhs, args);
-  }
-  else if (c_api == "TF_AllocateTensor")
-  {
-    plhs = OCT_TF_AllocateTensor (nrhs, args);
-  }
-  else if (c_api == "TF_TensorMaybeMove")
-  {
-    plhs = OCT_TF_TensorMaybeMove (nrhs, args);
-  }
-  else if (c_api == "TF_DeleteTensor")
-  {
-    OCT_TF_DeleteTensor (nrhs, args);
-  }
-  else if (c_api == "TF_TensorType")
-  {
-    plhs = OCT_TF_TensorType (nrhs, args);
-  }
-  else if (c_api == "TF_SetShape")
-  {
-    OCT_TF_SetShape (nrhs, args);
-  }
-  else if (c_api == "TF_NumDims")
-  {
-    plhs = OCT_TF_NumDims (nrhs, args);
-  }
-  else if (c_api == "TF_Dim")
-  {
-    plhs = OCT_TF_Dim (nrhs, args);
-  }
-  else if (c_api == "TF_TensorByteSize")
-  {
-    plhs = OCT_TF_TensorByteSize (nrhs, args);
-  }
-  else if (c_api == "TF_TensorData")
-  {
-    plhs = OCT_TF_TensorData (nrhs, args);
-  }
-  else if (c_api == "TF_TensorFromProto")
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_SetShape'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@item @var{in3} : scalar @code{int64} size of dimensions for new Tensor. \n\
+@item @var{in4} : scalar @code{int32} number of dimensions for new Tensor. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_NumDims'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{int32} number of dimensions of Tensor. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_Dim'} \n\
+@itemize \n\
+@item @var{out} : vector @code{int64} size of indexed dimension of Tensor. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@item @var{in3} : scalar @code{int32} dimension index. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_TensorByteSize'} \n\
+@itemize \n\
+@item @var{out} : vector @code{uint64} bytesize of Tensor. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_TensorData'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{uint64} pointer to data from Tensor. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_TensorFromProto'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Buffer. \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@item @var{in2} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_TensorElementCount'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{int64} number of elements in Tensor. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_TensorBitcastFrom'} \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to source Tensor. \n\
+@item @var{in3} : scalar @code{uint32} DataType code for target Tensor. \n\
+@item @var{in4} : scalar @code{uint64} pointer to target Tensor. \n\
+@item @var{in5} : scalar @code{int64} size of dimensions for new Tensor. \n\
+@item @var{in6} : scalar @code{int32} number of dimensions for new Tensor. \n\
+@item @var{in7} : scalar @code{uint64} pointer to Status. \n\
+@end itemize \n\
+\n\
+@item @qcode{'TF_TensorIsAligned'} \n\
+@itemize \n\
+@item @var{out} : scalar @code{bool} value for Tensor alignment. \n\
+@end itemize \n\
+@itemize \n\
+@item @var{in2} : scalar @code{uint64} pointer to Tensor. \n\
+@end itemize \n\
+@end itemize \n\
+\n\
+@end deftypefn")
+{
+  int nlhs = nargout;
+	int nrhs = args.length();
+	octave_value plhs;
+  if (nrhs == 0)
   {
-    OCT_TF_TensorFromProto (nrhs, args);
+    printf ("tensorflow: This is a TensorFlow binding for GNU Octave.\n");
+    return plhs;
   }
-  else if (c_api == "TF_TensorElementCount")
+  // Resolve the function from its name, or from its opcode
+  int opcode = -1;
+  if (args(0).is_string ())
   {
-    plhs = OCT_TF_TensorElementCount (nrhs, args);
+    opcode = oct_opcode (args(0).string_value ());
   }
-  else if (c_api == "TF_TensorBitcastFrom")
+  else if (args(0).is_int32_type () && args(0).is_scalar_type ())
   {
-    OCT_TF_TensorBitcastFrom (nrhs, args);
+    opcode = args(0).int32_scalar_value ().value ();
   }
-  else if (c_api == "TF_TensorIsAligned")
+  else
   {
-    plhs = OCT_TF_TensorIsAligned (nrhs, args);
+    error ("tensorflow: first argument must be a character vector "
+           "referencing a C API function, or an int32 opcode returned by "
+           "'TF_Opcode'.");
   }
-  // ---------------------------------------------------------------------------
-  else
+  if (opcode < 0 || opcode >= oct_num_handlers)
   {
     error ("tensorflow: unrecognized reference to C API function.");
   }
+  trace_scope scope (oct_handlers[opcode].name, "dispatch");
+  plhs = oct_handlers[opcode].fcn (nrhs, args);
   return plhs;
 }
 
@@ -1722,10 +2159,83 @@ which is 0 if the index is out of bounds. \n\
 %!error <tensorflow: first argument must be a character vector referencing a C API function.> ...
 %! tensorflow (5);
 %!error <tensorflow: unrecognized reference to C API function.> tensorflow ('');
+%!error <tensorflow: first argument must be a character vector referencing a C API function, or an int32 opcode returned by 'TF_Opcode'.> ...
+%! tensorflow (int32 ([1, 2]));
+%!error <tensorflow: unrecognized reference to C API function.> tensorflow (int32 (-1));
+%!error <tensorflow: unrecognized reference to C API function.> tensorflow (intmax ("int32"));
+%!error <tensorflow: one extra argument is required for the 'TF_Opcode' OCTAVE function.> ...
+%! tensorflow ('TF_Opcode');
+%!error <tensorflow: 2nd argument must be a character vector or a cellstr array of function names parsed to the 'TF_Opcode' OCTAVE function.> ...
+%! tensorflow ('TF_Opcode', 1);
+%!error <tensorflow: unrecognized reference to C API function 'TF_Nope' parsed to the 'TF_Opcode' OCTAVE function.> ...
+%! tensorflow ('TF_Opcode', {'TF_NewStatus', 'TF_Nope'});
+
+## An opcode reaches the same function as its name, including those that take
+## no arguments and those that return nothing.
+%!test
+%! op = tensorflow ('TF_Opcode', {'TF_Version', 'TF_NewStatus', 'TF_GetCode'; ...
+%!                                'TF_DeleteStatus', 'TF_Opcode', 'TF_Version'});
+%! assert_equal (class (op), "int32");
+%! assert_equal (size (op), [2, 3]);
+%! assert_equal (op(1, 1), op(2, 3));
+%! assert_equal (tensorflow (op(1)), tensorflow ('TF_Version'));
+%! status = tensorflow (op(1, 2));
+%! assert_equal (tensorflow (op(1, 3), status), uint32 (0));
+%! tensorflow (op(2, 1), status);
+%! assert_equal (tensorflow (op(2, 2), 'TF_Opcode'), op(2, 2));
+%! assert_equal (tensorflow ('TF_Opcode', 'TF_GetCode'), op(1, 3));
 %!test
 %! v = tensorflow ('TF_Version');
 %! assert_equal (class (v), "char");
 %! assert (! isempty (regexp (v, '^\d+\.\d+\.\d+', 'once')));
+%!error <tensorflow: one extra argument is required for the 'TF_TraceStop' OCTAVE function.> ...
+%! tensorflow ('TF_TraceStop');
+%!error <tensorflow: 2nd argument must be a character vector defining the file name parsed to the 'TF_TraceStop' OCTAVE function.> ...
+%! tensorflow ('TF_TraceStop', 1);
+
+## A trace holds a span for each call made while recording and none for those
+## made after it stopped, and is valid JSON.
+%!test
+%! file = [tempname(), ".json"];
+%! unwind_protect
+%!   tensorflow ('TF_TraceStart');
+%!   tensor = tensorflow ('TF_LoadTensor', single (magic (4)));
+%!   x = tensorflow ('TF_SaveTensor', tensor);
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%!   n = tensorflow ('TF_TraceStop', file);
+%!   tensorflow ('TF_Version');
+%!   assert (n >= 3);
+%!   trace = jsondecode (fileread (file));
+%!   ev = trace.traceEvents;
+%!   if (isstruct (ev))
+%!     ev = num2cell (ev);
+%!   endif
+%!   names = cellfun (@(e) e.name, ev, "UniformOutput", false);
+%!   assert (any (strcmp (names, 'TF_LoadTensor')));
+%!   assert (any (strcmp (names, 'TF_SaveTensor')));
+%!   assert (! any (strcmp (names, 'TF_Version')));
+%!   assert (! any (strcmp (names, 'TF_TraceStop')));
+%! unwind_protect_cleanup
+%!   unlink (file);
+%! end_unwind_protect
+
+## The kernels executed by a Session run are traced along with the package,
+## on a timeline of their own.
+%!test
+%! file = [tempname(), ".json"];
+%! s = TF_Session.fromSavedModel (__tf_test_model__ ());
+%! unwind_protect
+%!   tensorflow ('TF_TraceStart');
+%!   s.run ("serving_default_x", single ([1, 2, 3]), "StatefulPartitionedCall");
+%!   tensorflow ('TF_TraceStop', file);
+%!   text = fileread (file);
+%!   assert (! isempty (strfind (text, '"cat":"kernel"')));
+%!   assert (! isempty (strfind (text, '"name":"TF_SessionRunValues"')));
+%!   assert (! isempty (strfind (text, '"name":"TF_SessionRun"')));
+%!   assert (! isempty (strfind (text, '"name":"StatefulPartitionedCall"')));
+%! unwind_protect_cleanup
+%!   unlink (file);
+%! end_unwind_protect
   ## ---------------------------------------------------------------------------
   ## C API functions referenced by the TF_Buffer classdef
   ## ---------------------------------------------------------------------------
@@ -2968,53 +3478,170 @@ which is 0 if the index is out of bounds. \n\
 %! fail ("tensorflow ('TF_LoadTensor', s)", "tensorflow: 'struct' type cannot be loaded into Tensor.");
 %!error <tensorflow: 'function handle' type cannot be loaded into Tensor.> ...
 %! tensorflow ('TF_LoadTensor', @(x) sum (x));
+%!error <tensorflow: 3rd argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_LoadTensor' OCTAVE function.> ...
+%! tensorflow ('TF_LoadTensor', 1, 'Native');
+%!error <tensorflow: 3rd argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_LoadTensor' OCTAVE function.> ...
+%! tensorflow ('TF_LoadTensor', 1, 2);
+%!error <tensorflow: 4th argument must be an uint32 scalar indexing the TF_DataType of the Tensor parsed to the 'TF_LoadTensor' OCTAVE function.> ...
+%! tensorflow ('TF_LoadTensor', 1, 'rowmajor', 19);
+%!test
+%! fail ("tensorflow ('TF_LoadTensor', int8 (1), 'rowmajor', uint32 (19))", ...
+%!       "tensorflow: 'int8 scalar' type cannot be loaded into a Tensor of 'TF_HALF' data type.");
 
-%!error <tensorflow: one extra argument is required for the 'TF_SaveTensor' OCTAVE function.> ...
-%! tensorflow ('TF_SaveTensor');
-%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Tensor parsed to the 'TF_SaveTensor' OCTAVE function.> ...
-%! tensorflow ('TF_SaveTensor', 1);
+## Values half precision and bfloat16 hold exactly come back unchanged, as
+## single, in either layout, others are rounded to nearest even, and values
+## beyond the range of half precision overflow to infinity.
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (11), int64 ([2, 2]), int32 (2), uint64 (4)); # TF_QINT8
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_QINT8' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! TF_BFLOAT16 = uint32 (14);
+%! TF_HALF = uint32 (19);
+%! x = single ([1, -2.5, 65504; 2^-24, 0.5, 1024]);
+%! for layout = {'rowmajor', 'native'}
+%!   for dtype = [TF_HALF, TF_BFLOAT16]
+%!     tensor = tensorflow ('TF_LoadTensor', x, layout{1}, dtype);
+%!     assert_equal (tensorflow ('TF_TensorType', tensor), dtype);
+%!     assert_equal (tensorflow ('TF_TensorByteSize', tensor), uint64 (12));
+%!     if (dtype == TF_HALF)
+%!       y = x;
+%!     else
+%!       y = single ([1, -2.5, 65536; 2^-24, 0.5, 1024]);
+%!     endif
+%!     assert_equal (tensorflow ('TF_SaveTensor', tensor, layout{1}, true), y);
+%!   endfor
+%! endfor
+%! tensor = tensorflow ('TF_LoadTensor', [1 + 2^-11, 65520, 1e-8, NaN], ...
+%!                      'rowmajor', TF_HALF);
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true), ...
+%!               single ([1, Inf, 0, NaN]));
+%! tensor = tensorflow ('TF_LoadTensor', single ([1/3, 1 + 2^-8, -Inf]), ...
+%!                      'rowmajor', TF_BFLOAT16);
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true), ...
+%!               single ([0.333984375, 1, -Inf]));
+
+## Double arrays are narrowed to TF_FLOAT and single ones widened to
+## TF_DOUBLE in the pass that repositions them.
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (12), int64 ([2, 2]), int32 (2), uint64 (4)); # TF_QUINT8
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_QUINT8' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! x = rand (17, 9, 33);
+%! tensor = tensorflow ('TF_LoadTensor', x, 'rowmajor', uint32 (1));
+%! assert_equal (tensorflow ('TF_TensorType', tensor), uint32 (1));
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true), ...
+%!               single (x));
+%! tensor = tensorflow ('TF_LoadTensor', single (x), 'native', uint32 (2));
+%! assert_equal (tensorflow ('TF_TensorType', tensor), uint32 (2));
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'native', true), ...
+%!               double (single (x)));
+
+## Arrays of several dimensions are converted in the same pass that
+## repositions them, on the F16C or AVX-512 path when the processor has one.
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (13), int64 ([2, 2]), int32 (2), uint64 (16)); # TF_QINT32
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_QINT32' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! x = rand (17, 9, 33);
+%! for dtype = uint32 ([19, 14])
+%!   tensor = tensorflow ('TF_LoadTensor', x, 'rowmajor', dtype);
+%!   assert_equal (tensorflow ('TF_Dim', tensor, int32 (1)), uint64 (17));
+%!   y = tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true);
+%!   assert_equal (class (y), 'single');
+%!   assert (y, single (x), -2^-8);
+%! endfor
+
+## Quantized Tensors are loaded from and saved to the integers of the same
+## width, unchanged, or dequantized to single in the same pass.
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (14), int64 ([2, 2]), int32 (2), uint64 (8)); # TF_BFLOAT16
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_BFLOAT16' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! types = uint32 ([11, 12, 15, 16, 13]);
+%! cls = {'int8', 'uint8', 'int16', 'uint16', 'int32'};
+%! for k = 1:numel (types)
+%!   x = cast (magic (4), cls{k});
+%!   tensor = tensorflow ('TF_LoadTensor', x, 'rowmajor', types(k));
+%!   assert_equal (tensorflow ('TF_TensorType', tensor), types(k));
+%!   assert_equal (tensorflow ('TF_SaveTensor', tensor), x);
+%!   y = tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true, [0.5, 3]);
+%!   assert_equal (y, (single (magic (4)) - 3) * 0.5);
+%! endfor
+
+## 8 bit floating point values are rounded to nearest even and overflow to
+## infinity in E5M2 and to NaN in E4M3FN, and 4 bit integers saturate, held
+## one value per byte.
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (15), int64 ([2, 2]), int32 (2), uint64 (8)); # TF_QINT16
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_QINT16' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! TF_FLOAT8_E5M2 = uint32 (24);
+%! TF_FLOAT8_E4M3FN = uint32 (25);
+%! x = single ([1, -1.5, 0.3; 448, 2^-10, -Inf]);
+%! for layout = {'rowmajor', 'native'}
+%!   tensor = tensorflow ('TF_LoadTensor', x, layout{1}, TF_FLOAT8_E5M2);
+%!   assert_equal (tensorflow ('TF_TensorType', tensor), TF_FLOAT8_E5M2);
+%!   assert_equal (tensorflow ('TF_TensorByteSize', tensor), uint64 (6));
+%!   assert_equal (tensorflow ('TF_SaveTensor', tensor, layout{1}, true), ...
+%!                 single ([1, -1.5, 0.3125; 448, 2^-10, -Inf]));
+%!   tensor = tensorflow ('TF_LoadTensor', x, layout{1}, TF_FLOAT8_E4M3FN);
+%!   assert_equal (tensorflow ('TF_TensorType', tensor), TF_FLOAT8_E4M3FN);
+%!   assert_equal (tensorflow ('TF_SaveTensor', tensor, layout{1}, true), ...
+%!                 single ([1, -1.5, 0.3125; 448, 0, NaN]));
+%! endfor
+%! tensor = tensorflow ('TF_LoadTensor', [57344, 61440, 464, 1e-8], ...
+%!                      'rowmajor', TF_FLOAT8_E5M2);
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true), ...
+%!               single ([57344, Inf, 448, 0]));
+%! tensor = tensorflow ('TF_LoadTensor', [464, 465, NaN], ...
+%!                      'rowmajor', TF_FLOAT8_E4M3FN);
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true), ...
+%!               single ([448, NaN, NaN]));
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (16), int64 ([2, 2]), int32 (2), uint64 (8)); # TF_QUINT16
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_QUINT16' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! x = int8 ([-100, -8, -1; 0, 7, 100]);
+%! tensor = tensorflow ('TF_LoadTensor', x, 'rowmajor', uint32 (29));
+%! assert_equal (tensorflow ('TF_TensorType', tensor), uint32 (29));
+%! assert_equal (tensorflow ('TF_TensorByteSize', tensor), uint64 (6));
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor', true), ...
+%!               int8 ([-8, -8, -1; 0, 7, 7]));
+%! x = uint8 ([0, 15; 16, 255]);
+%! tensor = tensorflow ('TF_LoadTensor', x, 'native', uint32 (30));
+%! assert_equal (tensorflow ('TF_TensorType', tensor), uint32 (30));
+%! assert_equal (tensorflow ('TF_SaveTensor', tensor, 'native', true), ...
+%!               uint8 ([0, 15; 15, 15]));
 %!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (19), int64 ([2, 2]), int32 (2), uint64 (8)); # TF_HALF
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_HALF' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
+%! fail ("tensorflow ('TF_LoadTensor', uint8 (1), 'rowmajor', uint32 (29))", ...
+%!       "tensorflow: 'uint8 scalar' type cannot be loaded into a Tensor of 'TF_INT4' data type.");
+%!test
+%! fail ("tensorflow ('TF_LoadTensor', uint8 (1), 'rowmajor', uint32 (11))", ...
+%!       "tensorflow: 'uint8 scalar' type cannot be loaded into a Tensor of 'TF_QINT8' data type.");
+%!test
+%! tensor = tensorflow ('TF_LoadTensor', int8 ([1, 2]));
+%! unwind_protect
+%!   fail ("tensorflow ('TF_SaveTensor', tensor, 'rowmajor', false, [1, 0])", ...
+%!         "tensorflow: only a quantized Tensor can be dequantized, not one of 'TF_INT8' data type.");
+%! unwind_protect_cleanup
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%! end_unwind_protect
+
+%!error <tensorflow: one extra argument is required for the 'TF_SaveTensor' OCTAVE function.> ...
+%! tensorflow ('TF_SaveTensor');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Tensor parsed to the 'TF_SaveTensor' OCTAVE function.> ...
+%! tensorflow ('TF_SaveTensor', 1);
+%!error <tensorflow: 3rd argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_SaveTensor' OCTAVE function.> ...
+%! tensor = tensorflow ('TF_LoadTensor', 1);
+%! unwind_protect
+%!   tensorflow ('TF_SaveTensor', tensor, 'columnmajor');
+%! unwind_protect_cleanup
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%! end_unwind_protect
+%!error <tensorflow: 4th argument must be a logical scalar defining whether the Tensor is released, parsed to the 'TF_SaveTensor' OCTAVE function.> ...
+%! tensor = tensorflow ('TF_LoadTensor', 1);
+%! unwind_protect
+%!   tensorflow ('TF_SaveTensor', tensor, 'rowmajor', 1);
+%! unwind_protect_cleanup
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%! end_unwind_protect
+%!error <tensorflow: 5th argument must be a two element vector of the scale and the zero point dequantizing the Tensor parsed to the 'TF_SaveTensor' OCTAVE function.> ...
+%! tensor = tensorflow ('TF_LoadTensor', 1);
+%! unwind_protect
+%!   tensorflow ('TF_SaveTensor', tensor, 'rowmajor', false, 1);
+%! unwind_protect_cleanup
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%! end_unwind_protect
+%!error <tensorflow: one extra argument is required for the 'TF_SetConversionThreads' OCTAVE function.> ...
+%! tensorflow ('TF_SetConversionThreads');
+%!error <tensorflow: 2nd argument must be a non-negative integer scalar defining the number of threads parsed to the 'TF_SetConversionThreads' OCTAVE function.> ...
+%! tensorflow ('TF_SetConversionThreads', -1);
+%!error <tensorflow: 2nd argument must be a non-negative integer scalar defining the number of threads parsed to the 'TF_SetConversionThreads' OCTAVE function.> ...
+%! tensorflow ('TF_SetConversionThreads', 1.5);
+%!error <tensorflow: 2nd argument must be a non-negative integer scalar defining the number of threads parsed to the 'TF_SetConversionThreads' OCTAVE function.> ...
+%! tensorflow ('TF_SetConversionThreads', [2, 3]);
 %!test
 %! tensor = tensorflow ('TF_AllocateTensor', uint32 (20), int64 ([2, 2]), int32 (2), uint64 (0)); # TF_RESOURCE
 %! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
@@ -3027,31 +3654,6 @@ which is 0 if the index is out of bounds. \n\
 %! "tensorflow: 'TF_VARIANT' data type in Tensor is not supported by Octave.");
 %! tensorflow ('TF_DeleteTensor', tensor);
 %! clear tensor
-%!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (24), int64 ([2, 2]), int32 (2), uint64 (4)); # TF_FLOAT8_E5M2
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_FLOAT8_E5M2' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
-%!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (25), int64 ([2, 2]), int32 (2), uint64 (4)); # TF_FLOAT8_E4M3FN
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_FLOAT8_E4M3FN' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
-%!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (29), int64 ([2, 2]), int32 (2), uint64 (4)); # TF_INT4
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_INT4' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
-%!test
-%! tensor = tensorflow ('TF_AllocateTensor', uint32 (30), int64 ([2, 2]), int32 (2), uint64 (4)); # TF_UINT4
-%! fail ("tensorflow ('TF_SaveTensor', tensor)", ...
-%! "tensorflow: 'TF_UINT4' data type in Tensor is not supported by Octave.");
-%! tensorflow ('TF_DeleteTensor', tensor);
-%! clear tensor
-
 %!error <tensorflow: five extra arguments are required for the 'TF_NewTensor' C API function.> ...
 %! tensorflow ('TF_NewTensor');
 %!error <tensorflow: five extra arguments are required for the 'TF_NewTensor' C API function.> ...
@@ -3224,6 +3826,56 @@ which is 0 if the index is out of bounds. \n\
 %! assert_equal (class (opts), "uint64");
 %! assert (opts != 0);
 %! tensorflow ('TF_SetTarget', opts, 'local');
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+
+%!error <tensorflow: one extra argument is required for the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig');
+%!error <tensorflow: 2nd argument must be a scalar struct defining the fields of the ConfigProto parsed to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', uint8 (1));
+%!error <tensorflow: 'intra_op_threads' is not a field of the ConfigProto known to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', struct ('intra_op_threads', 1));
+%!error <tensorflow: field 'inter_op_parallelism_threads' of the ConfigProto must be an integer between 0 and 2147483647 parsed to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', struct ('inter_op_parallelism_threads', -1));
+%!error <tensorflow: field 'use_per_session_threads' of the ConfigProto must be a logical scalar parsed to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', struct ('use_per_session_threads', 2));
+%!error <tensorflow: field 'global_jit_level' of the ConfigProto must be 'DEFAULT', 'OFF', 'ON_1' or 'ON_2' parsed to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', struct ('global_jit_level', 'ON_3'));
+%!error <tensorflow: field 'opt_level' of the ConfigProto must be 'L1' or 'L0' parsed to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', struct ('opt_level', 2));
+%!error <tensorflow: 'size' is not a field of the session_inter_op_thread_pool of the ConfigProto known to the 'TF_EncodeConfig' OCTAVE function.> ...
+%! tensorflow ('TF_EncodeConfig', struct ('session_inter_op_thread_pool', ...
+%!                                        struct ('size', 1)));
+
+## The ConfigProto is encoded field by field in the order of their numbers,
+## the optimizer options nested two messages deep and negative enum values
+## sign extended to ten bytes, as protobuf does.  TensorFlow accepts it.
+%!test
+%! enc = @(varargin) tensorflow ('TF_EncodeConfig', struct (varargin{:}));
+%! assert_equal (enc (), zeros (1, 0, 'uint8'));
+%! assert_equal (enc ('inter_op_parallelism_threads', 2, ...
+%!                    'intra_op_parallelism_threads', 300), ...
+%!               uint8 ([16, 172, 2, 40, 2]));
+%! assert_equal (enc ('use_per_session_threads', true, ...
+%!                    'allow_soft_placement', 1), uint8 ([56, 1, 72, 1]));
+%! assert_equal (enc ('global_jit_level', 'on_2'), ...
+%!               uint8 ([82, 4, 26, 2, 40, 2]));
+%! assert_equal (enc ('opt_level', 'L0'), ...
+%!               uint8 ([82, 13, 26, 11, 24, 255 * ones(1, 9), 1]));
+%! assert_equal (enc ('session_inter_op_thread_pool', ...
+%!                    struct ('num_threads', 3, 'global_name', 'a')), ...
+%!               uint8 ([98, 5, 8, 3, 18, 1, 97]));
+%! assert_equal (enc ('session_inter_op_thread_pool', [2, 4]), ...
+%!               uint8 ([98, 2, 8, 2, 98, 2, 8, 4]));
+%! config = enc ('intra_op_parallelism_threads', 1, ...
+%!               'inter_op_parallelism_threads', 1, ...
+%!               'use_per_session_threads', true, ...
+%!               'allow_soft_placement', true, 'opt_level', 'L1', ...
+%!               'global_jit_level', 'OFF');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! status = tensorflow ('TF_NewStatus');
+%! tensorflow ('TF_SetConfig', opts, config, status);
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
+%! tensorflow ('TF_DeleteStatus', status);
 %! tensorflow ('TF_DeleteSessionOptions', opts);
 
   ## ---------------------------------------------------------------------------
@@ -3247,6 +3899,44 @@ which is 0 if the index is out of bounds. \n\
 %! tensorflow ('TF_LoadSessionFromSavedModel', uint64 (1), uint64 (0), '/tmp', ...
 %!             1, uint64 (1), uint64 (0), uint64 (1));
 
+%!error <tensorflow: one extra argument is required for the 'TF_SignatureDefs' OCTAVE function.> ...
+%! tensorflow ('TF_SignatureDefs');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the MetaGraphDef Buffer, or a uint8 vector holding a serialized MetaGraphDef, parsed to the 'TF_SignatureDefs' OCTAVE function.> ...
+%! tensorflow ('TF_SignatureDefs', 'abc');
+%!error <tensorflow: the MetaGraphDef Buffer parsed to the 'TF_SignatureDefs' OCTAVE function is a null pointer.> ...
+%! tensorflow ('TF_SignatureDefs', uint64 (0));
+%!error <tensorflow: the MetaGraphDef parsed to the 'TF_SignatureDefs' OCTAVE function could not be decoded.> ...
+%! tensorflow ('TF_SignatureDefs', uint8 ([42, 5, 1]));
+
+## A MetaGraphDef with two signatures, one of them empty, and a field that is
+## not a signature, built field by field.  The 'serving_default' signature
+## takes an input 'x' of shape [-1, 3] and returns an output of unknown rank.
+%!test
+%! ld = @(f, b) [uint8(f * 8 + 2), uint8(numel (b)), uint8(b)];
+%! dims = [ld(2, [8, repmat(255, 1, 9), 1]), ld(2, [8, 3])];
+%! info_x = [ld(1, "x:0"), 16, 1, ld(3, dims)];
+%! info_y = [ld(1, "y:1"), 16, 3, ld(3, [24, 1])];
+%! sig = [ld(1, [ld(1, "x"), ld(2, info_x)]), ...
+%!        ld(2, [ld(1, "out"), ld(2, info_y)]), ld(3, "m")];
+%! meta = [ld(5, [ld(1, "serving_default"), ld(2, sig)]), ...
+%!         ld(1, [ld(1, "v")]), ld(5, [ld(1, "a"), ld(2, [])])];
+%! s = tensorflow ('TF_SignatureDefs', meta);
+%! assert_equal (size (s), [2, 1]);
+%! assert_equal ({s.Name}, {"a", "serving_default"});
+%! assert_equal (size (s(1).Inputs), [0, 1]);
+%! assert_equal (s(2).MethodName, "m");
+%! assert_equal (s(2).Inputs.Key, "x");
+%! assert_equal (s(2).Inputs.Name, "x:0");
+%! assert_equal (s(2).Inputs.DataType, uint32 (1));
+%! assert_equal (s(2).Inputs.Shape, int64 ([-1, 3]));
+%! assert_equal (s(2).Outputs.Key, "out");
+%! assert_equal (s(2).Outputs.Name, "y:1");
+%! assert_equal (s(2).Outputs.DataType, uint32 (3));
+%! assert_equal (s(2).Outputs.Shape, zeros (0, 0, "int64"));
+%! buf = tensorflow ('TF_NewBufferFromString', meta);
+%! assert_equal (tensorflow ('TF_SignatureDefs', buf), s);
+%! tensorflow ('TF_DeleteBuffer', buf);
+
 %!error <tensorflow: two extra arguments are required for the 'TF_CloseSession' C API function.> ...
 %! tensorflow ('TF_CloseSession');
 %!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_CloseSession' C API function.> ...
@@ -3279,6 +3969,45 @@ which is 0 if the index is out of bounds. \n\
 %! tensorflow ('TF_SessionListDevices', 1, uint64 (1));
 %!error <tensorflow: 3rd argument must be an uint64 scalar pointer to the Status parsed to the 'TF_SessionListDevices' C API function.> ...
 %! tensorflow ('TF_SessionListDevices', uint64 (1), 1);
+%!error <tensorflow: one extra argument is required for the 'TF_SessionPoolStats' OCTAVE function.> ...
+%! tensorflow ('TF_SessionPoolStats');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_SessionPoolStats' OCTAVE function.> ...
+%! tensorflow ('TF_SessionPoolStats', 1);
+
+## Values copied into a Tensor take their buffer from the pool of the Session
+## from the second run on, while borrowed ones take nothing from it.
+%!test
+%! model = __tf_test_model__ ();
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! graph = tensorflow ('TF_NewGraph');
+%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
+%!                       model, {'serve'}, graph, uint64 (0), status);
+%! op_in = tensorflow ('TF_GraphOperationByName', graph, 'serving_default_x');
+%! op_out = tensorflow ('TF_GraphOperationByName', graph, 'StatefulPartitionedCall');
+%! in = tensorflow ('TF_NewOutput', op_in, int32 (0));
+%! out = tensorflow ('TF_NewOutput', op_out, int32 (0));
+%! stats = tensorflow ('TF_SessionPoolStats', session);
+%! assert_equal ([stats.hits, stats.misses, stats.held], [0, 0, 0]);
+%! x = [1, 2, 3; 4, 5, 6];
+%! for i = 1:3
+%!   y = tensorflow ('TF_SessionRunValues', session, in, {x}, out);
+%!   assert_equal (y, {single(x) .* single([2, 3, 4]) + single(1)});
+%! endfor
+%! tensorflow ('TF_SessionRunValues', session, in, {single([1, 2, 3])}, out);
+%! stats = tensorflow ('TF_SessionPoolStats', session);
+%! assert_equal ([stats.hits, stats.misses], [2, 1]);
+%! assert_equal (stats.rate, 2 / 3);
+%! assert_equal ([stats.held, stats.idle], [64, 64]);
+%! tensorflow ('TF_DeleteOutput', in);
+%! tensorflow ('TF_DeleteOutput', out);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! stats = tensorflow ('TF_SessionPoolStats', session);
+%! assert_equal ([stats.hits, stats.misses, stats.held], [0, 0, 0]);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
 
 ## A Session over an empty Graph, listing the devices it can execute on.
 %!test
@@ -3287,34 +4016,230 @@ which is 0 if the index is out of bounds. \n\
 %! graph = tensorflow ('TF_NewGraph');
 %! session = tensorflow ('TF_NewSession', graph, opts, status);
 %! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
-%! assert (session != 0);
-%! devices = tensorflow ('TF_SessionListDevices', session, status);
+%! assert (session != 0);
+%! devices = tensorflow ('TF_SessionListDevices', session, status);
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
+%! num = tensorflow ('TF_DeviceListCount', devices);
+%! assert (num >= 1);
+%! assert_equal (tensorflow ('TF_DeviceListType', devices, int32 (0), status), "CPU");
+%! tensorflow ('TF_DeleteDeviceList', devices);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+
+## Loading a SavedModel that is not there reports NOT_FOUND, naming the path.
+%!test
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! graph = tensorflow ('TF_NewGraph');
+%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
+%!                       '/no/such/model', {'serve'}, graph, uint64 (0), status);
+%! assert_equal (session, uint64 (0));
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (5));
+%! assert (! isempty (strfind (tensorflow ('TF_Message', status), '/no/such/model')));
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+
+## Build z = x + y in a Graph, then execute it through a Session.
+%!test
+%! TF_FLOAT = uint32 (1);
+%! status = tensorflow ('TF_NewStatus');
+%! graph = tensorflow ('TF_NewGraph');
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'y');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_y = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! out_y = tensorflow ('TF_NewOutput', op_y, int32 (0));
+%! desc = tensorflow ('TF_NewOperation', graph, 'AddV2', 'z');
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! tensorflow ('TF_AddInput', desc, out_y);
+%! op_z = tensorflow ('TF_FinishOperation', desc, status);
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
+%! out_z = tensorflow ('TF_NewOutput', op_z, int32 (0));
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! session = tensorflow ('TF_NewSession', graph, opts, status);
+%! tx = tensorflow ('TF_LoadTensor', single ([1, 2, 3; 4, 5, 6]));
+%! ty = tensorflow ('TF_LoadTensor', single ([10, 20, 30; 40, 50, 60]));
+%! out = tensorflow ('TF_SessionRun', session, uint64 (0), [out_x, out_y], ...
+%!                   [tx, ty], out_z, uint64 ([]), uint64 (0), status);
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
+%! assert_equal (numel (out), 1);
+%! assert_equal (tensorflow ('TF_SaveTensor', out(1)), single ([11, 22, 33; 44, 55, 66]));
+%! tensorflow ('TF_DeleteTensor', out(1));
+%! tensorflow ('TF_DeleteTensor', tx);
+%! tensorflow ('TF_DeleteTensor', ty);
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteOutput', out_y);
+%! tensorflow ('TF_DeleteOutput', out_z);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+
+%!error <tensorflow: five extra arguments are required for the 'TF_SessionPRunSetup' C API function.> ...
+%! tensorflow ('TF_SessionPRunSetup', uint64 (1));
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_SessionPRunSetup' C API function.> ...
+%! tensorflow ('TF_SessionPRunSetup', 1, uint64 (1), uint64 (1), uint64 ([]), uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 vector of pointers to the input Outputs parsed to the 'TF_SessionPRunSetup' C API function.> ...
+%! tensorflow ('TF_SessionPRunSetup', uint64 (1), 1, uint64 (1), uint64 ([]), uint64 (1));
+%!error <tensorflow: 4th argument must be an uint64 vector of pointers to the output Outputs parsed to the 'TF_SessionPRunSetup' C API function.> ...
+%! tensorflow ('TF_SessionPRunSetup', uint64 (1), uint64 (1), 1, uint64 ([]), uint64 (1));
+%!error <tensorflow: 5th argument must be an uint64 vector of pointers to the target Operations parsed to the 'TF_SessionPRunSetup' C API function.> ...
+%! tensorflow ('TF_SessionPRunSetup', uint64 (1), uint64 (1), uint64 (1), 1, uint64 (1));
+%!error <tensorflow: 6th argument must be an uint64 scalar pointer to the Status parsed to the 'TF_SessionPRunSetup' C API function.> ...
+%! tensorflow ('TF_SessionPRunSetup', uint64 (1), uint64 (1), uint64 (1), uint64 ([]), 1);
+%!error <tensorflow: seven extra arguments are required for the 'TF_SessionPRun' C API function.> ...
+%! tensorflow ('TF_SessionPRun', uint64 (1));
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_SessionPRun' C API function.> ...
+%! tensorflow ('TF_SessionPRun', 1, uint64 (1), uint64 (1), uint64 (1), uint64 (1), uint64 ([]), uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 scalar pointer to the partial run handle parsed to the 'TF_SessionPRun' C API function.> ...
+%! tensorflow ('TF_SessionPRun', uint64 (1), 1, uint64 (1), uint64 (1), uint64 (1), uint64 ([]), uint64 (1));
+%!error <tensorflow: 5th argument must be an uint64 vector of pointers to the input Tensors parsed to the 'TF_SessionPRun' C API function.> ...
+%! tensorflow ('TF_SessionPRun', uint64 (1), uint64 (1), uint64 (1), 1, uint64 (1), uint64 ([]), uint64 (1));
+%!error <tensorflow: 8th argument must be an uint64 scalar pointer to the Status parsed to the 'TF_SessionPRun' C API function.> ...
+%! tensorflow ('TF_SessionPRun', uint64 (1), uint64 (1), uint64 (1), uint64 (1), uint64 (1), uint64 ([]), 1);
+%!error <tensorflow: the 4th and 5th arguments must have the same number of elements parsed to the 'TF_SessionPRun' C API function.> ...
+%! tensorflow ('TF_SessionPRun', uint64 (1), uint64 (1), uint64 ([1, 2]), uint64 (1), uint64 (1), uint64 ([]), uint64 (1));
+%!error <tensorflow: one extra argument is required for the 'TF_DeletePRunHandle' C API function.> ...
+%! tensorflow ('TF_DeletePRunHandle');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the partial run handle parsed to the 'TF_DeletePRunHandle' C API function.> ...
+%! tensorflow ('TF_DeletePRunHandle', 1);
+
+## The same z = x + y as a partial run: x is fed on its own first, and y is
+## fed along with the fetch of z, the Session holding x in between.
+%!test
+%! TF_FLOAT = uint32 (1);
+%! status = tensorflow ('TF_NewStatus');
+%! graph = tensorflow ('TF_NewGraph');
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'y');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_y = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! out_y = tensorflow ('TF_NewOutput', op_y, int32 (0));
+%! desc = tensorflow ('TF_NewOperation', graph, 'AddV2', 'z');
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! tensorflow ('TF_AddInput', desc, out_y);
+%! op_z = tensorflow ('TF_FinishOperation', desc, status);
+%! out_z = tensorflow ('TF_NewOutput', op_z, int32 (0));
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! session = tensorflow ('TF_NewSession', graph, opts, status);
+%! handle = tensorflow ('TF_SessionPRunSetup', session, [out_x, out_y], ...
+%!                      out_z, uint64 ([]), status);
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
+%! assert (handle != 0);
+%! tx = tensorflow ('TF_LoadTensor', single ([1, 2, 3]));
+%! ty = tensorflow ('TF_LoadTensor', single ([10, 20, 30]));
+%! out = tensorflow ('TF_SessionPRun', session, handle, out_x, tx, ...
+%!                   uint64 ([]), uint64 ([]), status);
 %! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
-%! num = tensorflow ('TF_DeviceListCount', devices);
-%! assert (num >= 1);
-%! assert_equal (tensorflow ('TF_DeviceListType', devices, int32 (0), status), "CPU");
-%! tensorflow ('TF_DeleteDeviceList', devices);
+%! assert (isempty (out));
+%! out = tensorflow ('TF_SessionPRun', session, handle, out_y, ty, ...
+%!                   out_z, uint64 ([]), status);
+%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
+%! assert_equal (tensorflow ('TF_SaveTensor', out(1), 'rowmajor', true), ...
+%!               single ([11, 22, 33]));
+%! tensorflow ('TF_DeletePRunHandle', handle);
+%! tensorflow ('TF_DeleteTensor', tx);
+%! tensorflow ('TF_DeleteTensor', ty);
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteOutput', out_y);
+%! tensorflow ('TF_DeleteOutput', out_z);
 %! tensorflow ('TF_CloseSession', session, status);
 %! tensorflow ('TF_DeleteSession', session, status);
 %! tensorflow ('TF_DeleteSessionOptions', opts);
 %! tensorflow ('TF_DeleteGraph', graph);
 %! tensorflow ('TF_DeleteStatus', status);
 
-## Loading a SavedModel that is not there reports NOT_FOUND, naming the path.
+%!error <tensorflow: four extra arguments are required for the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', uint64 (1), uint64 (1), {1});
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', 1, uint64 (1), {1}, uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 vector of pointers to the input Outputs parsed to the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', uint64 (1), 1, {1}, uint64 (1));
+%!error <tensorflow: 4th argument must be a cell array with one value per input Output parsed to the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', uint64 (1), uint64 (1), 1, uint64 (1));
+%!error <tensorflow: 4th argument must be a cell array with one value per input Output parsed to the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', uint64 (1), uint64 (1), {1, 2}, uint64 (1));
+%!error <tensorflow: 5th argument must be an uint64 vector of pointers to the output Outputs parsed to the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', uint64 (1), uint64 (1), {1}, 1);
+%!error <tensorflow: 6th argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_SessionRunValues' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunValues', uint64 (1), uint64 (1), {1}, uint64 (1), 1);
+
+## The same z = x + y, with the values given and returned as Octave arrays in
+## a single call.  A run that fails raises the message of its Status, and the
+## Tensors built for it are released all the same.
 %!test
+%! TF_FLOAT = uint32 (1);
 %! status = tensorflow ('TF_NewStatus');
-%! opts = tensorflow ('TF_NewSessionOptions');
 %! graph = tensorflow ('TF_NewGraph');
-%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
-%!                       '/no/such/model', {'serve'}, graph, uint64 (0), status);
-%! assert_equal (session, uint64 (0));
-%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (5));
-%! assert (! isempty (strfind (tensorflow ('TF_Message', status), '/no/such/model')));
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'y');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_y = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! out_y = tensorflow ('TF_NewOutput', op_y, int32 (0));
+%! desc = tensorflow ('TF_NewOperation', graph, 'AddV2', 'z');
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! tensorflow ('TF_AddInput', desc, out_y);
+%! op_z = tensorflow ('TF_FinishOperation', desc, status);
+%! out_z = tensorflow ('TF_NewOutput', op_z, int32 (0));
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! session = tensorflow ('TF_NewSession', graph, opts, status);
+%! x = single ([1, 2, 3; 4, 5, 6]);
+%! y = single ([10, 20, 30; 40, 50, 60]);
+%! out = tensorflow ('TF_SessionRunValues', session, [out_x, out_y], ...
+%!                   {x, y}, [out_z, out_x]);
+%! assert_equal (out, {x + y, x});
+%! out = tensorflow ('TF_SessionRunValues', session, [out_x, out_y], ...
+%!                   {x.', y.'}, out_z, 'native');
+%! assert_equal (out, {x.' + y.'});
+%! ty = tensorflow ('TF_LoadTensor', y);
+%! out = tensorflow ('TF_SessionRunValues', session, [out_x, out_y], ...
+%!                   {x, ty}, out_z, 'rowmajor', [false, true]);
+%! assert_equal (out, {x + y});
+%! assert_equal (tensorflow ('TF_SaveTensor', ty), y);
+%! tensorflow ('TF_DeleteTensor', ty);
+%! fail ("tensorflow ('TF_SessionRunValues', session, [out_x, out_y], {x, int32 (1)}, out_z)", ...
+%!       "tensorflow: ");
+%! fail ("tensorflow ('TF_SessionRunValues', session, [out_x, out_y], {x, y}, out_z, 'rowmajor', [true, false])", ...
+%!       "value 1 is flagged as a Tensor");
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteOutput', out_y);
+%! tensorflow ('TF_DeleteOutput', out_z);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
 %! tensorflow ('TF_DeleteSessionOptions', opts);
 %! tensorflow ('TF_DeleteGraph', graph);
 %! tensorflow ('TF_DeleteStatus', status);
 
-## Build z = x + y in a Graph, then execute it through a Session.
+%!error <tensorflow: four extra arguments are required for the 'TF_SessionProfile' OCTAVE function.> ...
+%! tensorflow ('TF_SessionProfile', uint64 (1), uint64 (1), {1});
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_SessionProfile' OCTAVE function.> ...
+%! tensorflow ('TF_SessionProfile', 1, uint64 (1), {1}, uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 vector of pointers to the input Outputs parsed to the 'TF_SessionProfile' OCTAVE function.> ...
+%! tensorflow ('TF_SessionProfile', uint64 (1), 1, {1}, uint64 (1));
+%!error <tensorflow: 4th argument must be a cell array with one value per input Output parsed to the 'TF_SessionProfile' OCTAVE function.> ...
+%! tensorflow ('TF_SessionProfile', uint64 (1), uint64 (1), {1, 2}, uint64 (1));
+%!error <tensorflow: 5th argument must be an uint64 vector of pointers to the output Outputs parsed to the 'TF_SessionProfile' OCTAVE function.> ...
+%! tensorflow ('TF_SessionProfile', uint64 (1), uint64 (1), {1}, 1);
+%!error <tensorflow: 6th argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_SessionProfile' OCTAVE function.> ...
+%! tensorflow ('TF_SessionProfile', uint64 (1), uint64 (1), {1}, uint64 (1), 1);
+
+## Profiling z = x + y returns the same outputs as TF_SessionRunValues, along
+## with one element for each node executed, the AddV2 among them, timed from
+## the first node to start.
 %!test
 %! TF_FLOAT = uint32 (1);
 %! status = tensorflow ('TF_NewStatus');
@@ -3331,20 +4256,23 @@ which is 0 if the index is out of bounds. \n\
 %! tensorflow ('TF_AddInput', desc, out_x);
 %! tensorflow ('TF_AddInput', desc, out_y);
 %! op_z = tensorflow ('TF_FinishOperation', desc, status);
-%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
 %! out_z = tensorflow ('TF_NewOutput', op_z, int32 (0));
 %! opts = tensorflow ('TF_NewSessionOptions');
 %! session = tensorflow ('TF_NewSession', graph, opts, status);
-%! tx = tensorflow ('TF_LoadTensor', single ([1, 2, 3; 4, 5, 6]));
-%! ty = tensorflow ('TF_LoadTensor', single ([10, 20, 30; 40, 50, 60]));
-%! out = tensorflow ('TF_SessionRun', session, uint64 (0), [out_x, out_y], ...
-%!                   [tx, ty], out_z, uint64 ([]), uint64 (0), status);
-%! assert_equal (tensorflow ('TF_GetCode', status), uint32 (0));
-%! assert_equal (numel (out), 1);
-%! assert_equal (tensorflow ('TF_SaveTensor', out(1)), single ([11, 22, 33; 44, 55, 66]));
-%! tensorflow ('TF_DeleteTensor', out(1));
-%! tensorflow ('TF_DeleteTensor', tx);
-%! tensorflow ('TF_DeleteTensor', ty);
+%! x = single ([1, 2, 3; 4, 5, 6]);
+%! y = single ([10, 20, 30; 40, 50, 60]);
+%! prof = tensorflow ('TF_SessionProfile', session, [out_x, out_y], ...
+%!                    {x, y}, out_z);
+%! assert_equal (prof.outputs, {x + y});
+%! assert_equal (fieldnames (prof.nodes), {"Name"; "Op"; "Device"; ...
+%!               "StartMicros"; "WallMicros"; "OutputBytes"});
+%! k = find (strcmp ({prof.nodes.Name}, 'z'));
+%! assert_equal (numel (k), 1);
+%! assert_equal (prof.nodes(k).Op, 'AddV2');
+%! assert (prof.nodes(k).OutputBytes >= 24);
+%! assert (prof.nodes(1).StartMicros, 0);
+%! assert (all (diff ([prof.nodes.StartMicros]) >= 0));
+%! assert (all ([prof.nodes.WallMicros] >= 0));
 %! tensorflow ('TF_DeleteOutput', out_x);
 %! tensorflow ('TF_DeleteOutput', out_y);
 %! tensorflow ('TF_DeleteOutput', out_z);
@@ -3483,6 +4411,291 @@ which is 0 if the index is out of bounds. \n\
 %! tensorflow ('TF_DeleteSession', session, status);
 %! tensorflow ('TF_DeleteSessionOptions', opts);
 %! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+
+  ## ---------------------------------------------------------------------------
+  ## OCTAVE specific functions referenced by the TF_Runner classdef
+  ## ---------------------------------------------------------------------------
+%!error <tensorflow: three extra arguments are required for the 'TF_NewRunner' OCTAVE function.> ...
+%! tensorflow ('TF_NewRunner', uint64 (1), uint64 (1));
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_NewRunner' OCTAVE function.> ...
+%! tensorflow ('TF_NewRunner', 1, uint64 (1), uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 vector of pointers to the input Outputs parsed to the 'TF_NewRunner' OCTAVE function.> ...
+%! tensorflow ('TF_NewRunner', uint64 (1), 1, uint64 (1));
+%!error <tensorflow: 4th argument must be an uint64 vector of pointers to the output Outputs parsed to the 'TF_NewRunner' OCTAVE function.> ...
+%! tensorflow ('TF_NewRunner', uint64 (1), uint64 (1), 1);
+%!error <tensorflow: 5th argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_NewRunner' OCTAVE function.> ...
+%! tensorflow ('TF_NewRunner', uint64 (1), uint64 (1), uint64 (1), 'colmajor');
+%!error <tensorflow: one extra argument is required for the 'TF_DeleteRunner' OCTAVE function.> ...
+%! tensorflow ('TF_DeleteRunner');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Runner parsed to the 'TF_DeleteRunner' OCTAVE function.> ...
+%! tensorflow ('TF_DeleteRunner', 1);
+%!error <tensorflow: two extra arguments are required for the 'TF_RunnerRun' OCTAVE function.> ...
+%! tensorflow ('TF_RunnerRun', uint64 (1));
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Runner parsed to the 'TF_RunnerRun' OCTAVE function.> ...
+%! tensorflow ('TF_RunnerRun', 1, {});
+
+## A Runner resolves its inputs and outputs once and is run repeatedly, each
+## run converting the values, executing the Graph and converting the outputs
+## back in a single call.  A value may also be a Tensor owned by the caller,
+## which the run leaves alone.
+%!test
+%! model = __tf_test_model__ ();
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! graph = tensorflow ('TF_NewGraph');
+%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
+%!                       model, {'serve'}, graph, uint64 (0), status);
+%! op_in = tensorflow ('TF_GraphOperationByName', graph, 'serving_default_x');
+%! op_out = tensorflow ('TF_GraphOperationByName', graph, 'StatefulPartitionedCall');
+%! in = tensorflow ('TF_NewOutput', op_in, int32 (0));
+%! out = tensorflow ('TF_NewOutput', op_out, int32 (0));
+%! runner = tensorflow ('TF_NewRunner', session, in, [out, out]);
+%! tensorflow ('TF_DeleteOutput', in);
+%! tensorflow ('TF_DeleteOutput', out);
+%! for i = 1:2
+%!   y = tensorflow ('TF_RunnerRun', runner, {single([1, 1, 1; 2, 2, 2])});
+%!   assert_equal (y, {single([3, 4, 5; 5, 7, 9]), single([3, 4, 5; 5, 7, 9])});
+%! endfor
+%! tx = tensorflow ('TF_LoadTensor', single ([1, 2, 3]));
+%! y = tensorflow ('TF_RunnerRun', runner, {tx}, true);
+%! assert_equal (y{1}, single ([3, 7, 13]));
+%! assert_equal (tensorflow ('TF_SaveTensor', tx), single ([1, 2, 3]));
+%! tensorflow ('TF_DeleteTensor', tx);
+%! tensorflow ('TF_DeleteRunner', runner);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+
+## A Runner in native layout reverses the dimensions of inputs and outputs.
+## A run that fails reports the Status message and leaves the Runner usable.
+%!test
+%! model = __tf_test_model__ ();
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! graph = tensorflow ('TF_NewGraph');
+%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
+%!                       model, {'serve'}, graph, uint64 (0), status);
+%! op_in = tensorflow ('TF_GraphOperationByName', graph, 'serving_default_x');
+%! op_out = tensorflow ('TF_GraphOperationByName', graph, 'StatefulPartitionedCall');
+%! in = tensorflow ('TF_NewOutput', op_in, int32 (0));
+%! out = tensorflow ('TF_NewOutput', op_out, int32 (0));
+%! runner = tensorflow ('TF_NewRunner', session, in, out, 'native');
+%! tensorflow ('TF_DeleteOutput', in);
+%! tensorflow ('TF_DeleteOutput', out);
+%! x = single ([1, 4; 2, 5; 3, 6]);
+%! y = tensorflow ('TF_RunnerRun', runner, {x});
+%! assert_equal (y{1}, x .* single ([2; 3; 4]) + single (1));
+%! fail ("tensorflow ('TF_RunnerRun', runner, {int32 (1)})", "tensorflow: ");
+%! fail ("tensorflow ('TF_RunnerRun', runner, {x, x})", ...
+%!       "one value per input of the Runner");
+%! fail ("tensorflow ('TF_RunnerRun', runner, {x}, 1)", ...
+%!       "logical vector flagging");
+%! y = tensorflow ('TF_RunnerRun', runner, {x});
+%! assert_equal (y{1}, x .* single ([2; 3; 4]) + single (1));
+%! tensorflow ('TF_DeleteRunner', runner);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+  ## ---------------------------------------------------------------------------
+  ## OCTAVE specific functions referenced by the TF_AsyncRun classdef
+  ## ---------------------------------------------------------------------------
+%!error <tensorflow: four extra arguments are required for the 'TF_SessionRunAsync' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunAsync', uint64 (1), uint64 (1), {1});
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_SessionRunAsync' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunAsync', 1, uint64 (1), {1}, uint64 (1));
+%!error <tensorflow: 4th argument must be a cell array with one value per input Output parsed to the 'TF_SessionRunAsync' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunAsync', uint64 (1), uint64 (1), {}, uint64 (1));
+%!error <tensorflow: 7th argument must be a logical vector flagging the values given as Tensors parsed to the 'TF_SessionRunAsync' OCTAVE function.> ...
+%! tensorflow ('TF_SessionRunAsync', uint64 (1), uint64 (1), {1}, uint64 (1), 'rowmajor', 1);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the AsyncRun parsed to the 'TF_AsyncRunIsDone' OCTAVE function.> ...
+%! tensorflow ('TF_AsyncRunIsDone', 1);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the AsyncRun parsed to the 'TF_AsyncRunWait' OCTAVE function.> ...
+%! tensorflow ('TF_AsyncRunWait', 1);
+%!error <tensorflow: 3rd argument must be a non-negative real scalar defining the timeout in seconds parsed to the 'TF_AsyncRunWait' OCTAVE function.> ...
+%! tensorflow ('TF_AsyncRunWait', uint64 (1), -1);
+%!error <tensorflow: one extra argument is required for the 'TF_AsyncRunFetch' OCTAVE function.> ...
+%! tensorflow ('TF_AsyncRunFetch');
+%!error <tensorflow: one extra argument is required for the 'TF_DeleteAsyncRun' OCTAVE function.> ...
+%! tensorflow ('TF_DeleteAsyncRun');
+
+## A run started on a worker thread completes while Octave carries on, and its
+## outputs are fetched once.  A failed run raises its message when fetched,
+## and a run deleted without being fetched releases its outputs.
+%!test
+%! model = __tf_test_model__ ();
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! graph = tensorflow ('TF_NewGraph');
+%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
+%!                       model, {'serve'}, graph, uint64 (0), status);
+%! op_in = tensorflow ('TF_GraphOperationByName', graph, 'serving_default_x');
+%! op_out = tensorflow ('TF_GraphOperationByName', graph, 'StatefulPartitionedCall');
+%! in = tensorflow ('TF_NewOutput', op_in, int32 (0));
+%! out = tensorflow ('TF_NewOutput', op_out, int32 (0));
+%! run = tensorflow ('TF_SessionRunAsync', session, in, ...
+%!                   {single([1, 2, 3])}, out);
+%! assert (tensorflow ('TF_AsyncRunWait', run, 60));
+%! assert (tensorflow ('TF_AsyncRunIsDone', run));
+%! assert_equal (tensorflow ('TF_AsyncRunFetch', run), {single([3, 7, 13])});
+%! fail ("tensorflow ('TF_AsyncRunFetch', run)", "already been fetched");
+%! tensorflow ('TF_DeleteAsyncRun', run);
+%! run = tensorflow ('TF_SessionRunAsync', session, in, {int32 (1)}, out);
+%! fail ("tensorflow ('TF_AsyncRunFetch', run)", "tensorflow: ");
+%! tensorflow ('TF_DeleteAsyncRun', run);
+%! run = tensorflow ('TF_SessionRunAsync', session, in, ...
+%!                   {single([1, 2, 3])}, out);
+%! tensorflow ('TF_DeleteAsyncRun', run);
+%! tensorflow ('TF_DeleteOutput', in);
+%! tensorflow ('TF_DeleteOutput', out);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+  ## ---------------------------------------------------------------------------
+  ## OCTAVE specific functions referenced by the TFModel classdef
+  ## ---------------------------------------------------------------------------
+%!error <tensorflow: five extra arguments are required for the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', uint64 (1), uint64 (1), uint64 (1), 8);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Session parsed to the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', 1, uint64 (1), uint64 (1), 8, 0.01);
+%!error <tensorflow: 3rd argument must be an uint64 vector of pointers to the input Outputs parsed to the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', uint64 (1), [], uint64 (1), 8, 0.01);
+%!error <tensorflow: 4th argument must be an uint64 vector of pointers to the output Outputs parsed to the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', uint64 (1), uint64 (1), 1, 8, 0.01);
+%!error <tensorflow: 5th argument must be a positive integer defining the largest batch in rows parsed to the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', uint64 (1), uint64 (1), uint64 (1), 0.5, 0.01);
+%!error <tensorflow: 6th argument must be a non-negative real scalar defining the longest wait in seconds parsed to the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', uint64 (1), uint64 (1), uint64 (1), 8, Inf);
+%!error <tensorflow: 7th argument must be either 'rowmajor' or 'native' defining the layout of the Tensor parsed to the 'TF_NewBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_NewBatcher', uint64 (1), uint64 (1), uint64 (1), 8, 0, 'x');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Batcher parsed to the 'TF_BatcherSubmit' OCTAVE function.> ...
+%! tensorflow ('TF_BatcherSubmit', 1, {1});
+%!error <tensorflow: two extra arguments are required for the 'TF_BatcherCollect' OCTAVE function.> ...
+%! tensorflow ('TF_BatcherCollect', uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 scalar ticket of a request parsed to the 'TF_BatcherCollect' OCTAVE function.> ...
+%! tensorflow ('TF_BatcherCollect', uint64 (1), 1);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Batcher parsed to the 'TF_BatcherStats' OCTAVE function.> ...
+%! tensorflow ('TF_BatcherStats', 1);
+%!error <tensorflow: one extra argument is required for the 'TF_DeleteBatcher' OCTAVE function.> ...
+%! tensorflow ('TF_DeleteBatcher');
+
+## Requests submitted to a Batcher are run together, concatenated along the
+## first dimension, and each is collected with its own rows of the output.
+## A request of a different shape starts a batch of its own, a batch that
+## fails raises its message for each of its requests, and collecting a
+## request runs what is queued without waiting for the batch to fill up.
+%!test
+%! model = __tf_test_model__ ();
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! graph = tensorflow ('TF_NewGraph');
+%! session = tensorflow ('TF_LoadSessionFromSavedModel', opts, uint64 (0), ...
+%!                       model, {'serve'}, graph, uint64 (0), status);
+%! op_in = tensorflow ('TF_GraphOperationByName', graph, 'serving_default_x');
+%! op_out = tensorflow ('TF_GraphOperationByName', graph, 'StatefulPartitionedCall');
+%! in = tensorflow ('TF_NewOutput', op_in, int32 (0));
+%! out = tensorflow ('TF_NewOutput', op_out, int32 (0));
+%! b = tensorflow ('TF_NewBatcher', session, in, out, 8, 60);
+%! t1 = tensorflow ('TF_BatcherSubmit', b, {single([1, 1, 1])});
+%! t2 = tensorflow ('TF_BatcherSubmit', b, {single([1, 2, 3; 4, 5, 6])});
+%! t3 = tensorflow ('TF_BatcherSubmit', b, {single([0, 0, 0])});
+%! assert_equal (tensorflow ('TF_BatcherCollect', b, t2), ...
+%!               {single([3, 7, 13; 9, 16, 25])});
+%! assert_equal (tensorflow ('TF_BatcherCollect', b, t3), {single([1, 1, 1])});
+%! assert_equal (tensorflow ('TF_BatcherCollect', b, t1), {single([3, 4, 5])});
+%! stats = tensorflow ('TF_BatcherStats', b);
+%! assert_equal ([stats.requests, stats.batches, stats.largest], [3, 1, 4]);
+%! fail ("tensorflow ('TF_BatcherCollect', b, t1)", "not a request waiting");
+%! t1 = tensorflow ('TF_BatcherSubmit', b, {single([1, 1, 1])});
+%! t2 = tensorflow ('TF_BatcherSubmit', b, {single([1, 1])});
+%! t3 = tensorflow ('TF_BatcherSubmit', b, {int32 (1)});
+%! assert_equal (tensorflow ('TF_BatcherCollect', b, t1), {single([3, 4, 5])});
+%! fail ("tensorflow ('TF_BatcherCollect', b, t2)", "tensorflow: ");
+%! fail ("tensorflow ('TF_BatcherCollect', b, t3)", "tensorflow: ");
+%! stats = tensorflow ('TF_BatcherStats', b);
+%! assert_equal ([stats.batches, stats.pending], [4, 0]);
+%! tensorflow ('TF_BatcherSubmit', b, {single([1, 1, 1])});
+%! tensorflow ('TF_DeleteBatcher', b);
+%! b = tensorflow ('TF_NewBatcher', session, in, out, 2, 0, 'native');
+%! tensorflow ('TF_DeleteOutput', in);
+%! tensorflow ('TF_DeleteOutput', out);
+%! x = single ([1, 4; 2, 5; 3, 6]);
+%! t = tensorflow ('TF_BatcherSubmit', b, {x});
+%! assert_equal (tensorflow ('TF_BatcherCollect', b, t), ...
+%!               {x .* single([2; 3; 4]) + single(1)});
+%! tensorflow ('TF_DeleteBatcher', b);
+%! tensorflow ('TF_CloseSession', session, status);
+%! tensorflow ('TF_DeleteSession', session, status);
+%! tensorflow ('TF_DeleteSessionOptions', opts);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+  ## ---------------------------------------------------------------------------
+  ## OCTAVE specific functions referenced by the TFModelPool classdef
+  ## ---------------------------------------------------------------------------
+%!error <tensorflow: one extra argument is required for the 'TF_NewModelPool' OCTAVE function.> ...
+%! tensorflow ('TF_NewModelPool');
+%!error <tensorflow: 2nd argument must be an uint64 vector of pointers to the Runners parsed to the 'TF_NewModelPool' OCTAVE function.> ...
+%! tensorflow ('TF_NewModelPool', zeros (1, 0, 'uint64'));
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the ModelPool parsed to the 'TF_ModelPoolSubmit' OCTAVE function.> ...
+%! tensorflow ('TF_ModelPoolSubmit', 1, {1});
+%!error <tensorflow: two extra arguments are required for the 'TF_ModelPoolCollect' OCTAVE function.> ...
+%! tensorflow ('TF_ModelPoolCollect', uint64 (1));
+%!error <tensorflow: 3rd argument must be an uint64 scalar ticket of a request parsed to the 'TF_ModelPoolCollect' OCTAVE function.> ...
+%! tensorflow ('TF_ModelPoolCollect', uint64 (1), 1);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the ModelPool parsed to the 'TF_ModelPoolStats' OCTAVE function.> ...
+%! tensorflow ('TF_ModelPoolStats', 1);
+%!error <tensorflow: one extra argument is required for the 'TF_DeleteModelPool' OCTAVE function.> ...
+%! tensorflow ('TF_DeleteModelPool');
+
+## A ModelPool runs the requests submitted to it on whichever of its Sessions
+## is idle, each over a Graph of its own, and returns the outputs of each
+## request when collected.  A failed run raises its message when collected.
+%!test
+%! model = __tf_test_model__ ();
+%! status = tensorflow ('TF_NewStatus');
+%! opts = tensorflow ('TF_NewSessionOptions');
+%! for k = 1:2
+%!   graph(k) = tensorflow ('TF_NewGraph');
+%!   session(k) = tensorflow ('TF_LoadSessionFromSavedModel', opts, ...
+%!                            uint64 (0), model, {'serve'}, graph(k), ...
+%!                            uint64 (0), status);
+%!   op_in = tensorflow ('TF_GraphOperationByName', graph(k), 'serving_default_x');
+%!   op_out = tensorflow ('TF_GraphOperationByName', graph(k), 'StatefulPartitionedCall');
+%!   in = tensorflow ('TF_NewOutput', op_in, int32 (0));
+%!   out = tensorflow ('TF_NewOutput', op_out, int32 (0));
+%!   runner(k) = tensorflow ('TF_NewRunner', session(k), in, out);
+%!   tensorflow ('TF_DeleteOutput', in);
+%!   tensorflow ('TF_DeleteOutput', out);
+%! endfor
+%! pool = tensorflow ('TF_NewModelPool', runner);
+%! for i = 1:8
+%!   t(i) = tensorflow ('TF_ModelPoolSubmit', pool, {single([i, i, i])});
+%! endfor
+%! for i = 8:-1:1
+%!   assert_equal (tensorflow ('TF_ModelPoolCollect', pool, t(i)), ...
+%!                 {single([2, 3, 4] * i + 1)});
+%! endfor
+%! stats = tensorflow ('TF_ModelPoolStats', pool);
+%! assert_equal ([stats.sessions, stats.requests, stats.pending], [2, 8, 0]);
+%! assert_equal (sum (stats.runs), 8);
+%! t = tensorflow ('TF_ModelPoolSubmit', pool, {int32 (1)});
+%! fail ("tensorflow ('TF_ModelPoolCollect', pool, t)", "tensorflow: ");
+%! fail ("tensorflow ('TF_ModelPoolCollect', pool, t)", "not a request waiting");
+%! tensorflow ('TF_ModelPoolSubmit', pool, {single([1, 1, 1])});
+%! tensorflow ('TF_DeleteModelPool', pool);
+%! for k = 1:2
+%!   tensorflow ('TF_DeleteRunner', runner(k));
+%!   tensorflow ('TF_CloseSession', session(k), status);
+%!   tensorflow ('TF_DeleteSession', session(k), status);
+%!   tensorflow ('TF_DeleteGraph', graph(k));
+%! endfor
+%! tensorflow ('TF_DeleteSessionOptions', opts);
 %! tensorflow ('TF_DeleteStatus', status);
 ## Octave stores arrays column major and TensorFlow stores them row major, so
 ## the elements are repositioned in both directions while the shape is kept.
@@ -3507,6 +4720,159 @@ which is 0 if the index is out of bounds. \n\
 %! assert_equal (tensorflow ('TF_Dim', tensor, int32 (2)), uint64 (3));
 %! tensorflow ('TF_DeleteTensor', tensor);
 
+## The row major bytes of a Tensor are those of the array with its dimensions
+## reversed.  The transpose is specialized on the element size, so every type
+## is checked, on shapes that span several cache tiles, have partial tiles at
+## their edges and include dimensions of length one.
+%!test
+%! shapes = {[5, 7], [70, 33], [3, 4, 5], [1, 6, 1, 4], [2, 35, 3, 40]};
+%! types = {"double", "single", "int8", "uint8", "int16", "uint16", ...
+%!          "int32", "uint32", "int64", "uint64", "logical", "complex", ...
+%!          "single complex"};
+%! for s = 1:numel (shapes)
+%!   for t = 1:numel (types)
+%!     x = mod (reshape (1:prod (shapes{s}), shapes{s}), 127);
+%!     switch (types{t})
+%!       case "logical"
+%!         x = logical (mod (x, 3));
+%!       case "complex"
+%!         x = complex (x, -x);
+%!       case "single complex"
+%!         x = single (complex (x, -x));
+%!       otherwise
+%!         x = cast (x, types{t});
+%!     endswitch
+%!     tensor = tensorflow ('TF_LoadTensor', x);
+%!     buffer = tensorflow ('TF_TensorData', tensor);
+%!     raw = tensorflow ('TF_GetBuffer', buffer);
+%!     tensorflow ('TF_DeleteBuffer', buffer);
+%!     y = permute (x, ndims (x):-1:1)(:).';
+%!     if (islogical (y))
+%!       y = uint8 (y);
+%!     elseif (iscomplex (y))
+%!       y = [real(y); imag(y)];
+%!     endif
+%!     assert_equal (raw(:), typecast (y(:), "uint8"));
+%!     assert_equal (tensorflow ('TF_SaveTensor', tensor), x);
+%!     tensorflow ('TF_DeleteTensor', tensor);
+%!   endfor
+%! endfor
+
+## Split across threads, each one writes its own slab of the destination, so
+## the bytes must match those converted on a single thread, including when the
+## outermost dimension does not divide evenly or is shorter than the number of
+## threads.
+%!test
+%! vals = {rand(1000, 999), single(rand(7, 300, 500)), rand(3, 200, 10, 300), ...
+%!         int8(randi([-100, 100], 2000, 1501)), complex(rand(5, 40000), 1)};
+%! unwind_protect
+%!   prev = tensorflow ('TF_SetConversionThreads', 1);
+%!   assert (isa (prev, "int32"));
+%!   for i = 1:numel (vals)
+%!     tensorflow ('TF_SetConversionThreads', 1);
+%!     t1 = tensorflow ('TF_LoadTensor', vals{i});
+%!     tensorflow ('TF_SetConversionThreads', 4);
+%!     t4 = tensorflow ('TF_LoadTensor', vals{i});
+%!     b1 = tensorflow ('TF_TensorData', t1);
+%!     b4 = tensorflow ('TF_TensorData', t4);
+%!     assert_equal (tensorflow ('TF_GetBuffer', b4), tensorflow ('TF_GetBuffer', b1));
+%!     tensorflow ('TF_DeleteBuffer', b1);
+%!     tensorflow ('TF_DeleteBuffer', b4);
+%!     assert_equal (tensorflow ('TF_SaveTensor', t4), vals{i});
+%!     tensorflow ('TF_DeleteTensor', t1);
+%!     tensorflow ('TF_DeleteTensor', t4);
+%!   endfor
+%!   assert_equal (tensorflow ('TF_SetConversionThreads', 0), int32 (4));
+%! unwind_protect_cleanup
+%!   tensorflow ('TF_SetConversionThreads', prev);
+%! end_unwind_protect
+
+## In native layout the Tensor takes the dimensions in reverse order and the
+## buffer unchanged, so it holds the transpose of what the default layout
+## gives, and reading it back natively restores the array.  Scalars and row
+## vectors are the same in both layouts.
+%!test
+%! vals = {rand(3, 5), single(rand(2, 3, 4)), int8(magic (4)), rand(2, 3, 4, 5), ...
+%!         rand(4, 1), rand(1, 7), 42, true(3, 2)};
+%! for i = 1:numel (vals)
+%!   x = vals{i};
+%!   tensor = tensorflow ('TF_LoadTensor', x, 'native');
+%!   nd = tensorflow ('TF_NumDims', tensor);
+%!   sz = zeros (1, nd);
+%!   for k = 1:nd
+%!     sz(k) = double (tensorflow ('TF_Dim', tensor, int32 (k)));
+%!   endfor
+%!   if (isscalar (x))
+%!     assert_equal (sz, zeros (1, 0));
+%!   elseif (isrow (x))
+%!     assert_equal (sz, numel (x));
+%!   else
+%!     assert_equal (sz, fliplr (size (x)));
+%!   endif
+%!   assert_equal (tensorflow ('TF_SaveTensor', tensor, 'native'), x);
+%!   if (nd > 1)
+%!     assert_equal (tensorflow ('TF_SaveTensor', tensor), ...
+%!                   permute (x, ndims (x):-1:1));
+%!   else
+%!     assert_equal (tensorflow ('TF_SaveTensor', tensor), x);
+%!   endif
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%!   tensor = tensorflow ('TF_LoadTensor', x, 'rowmajor');
+%!   assert_equal (tensorflow ('TF_SaveTensor', tensor, 'rowmajor'), x);
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%! endfor
+
+## Vectors, scalars and arrays in native layout are not copied: the Tensor
+## borrows the buffer of the array.  Changing or clearing the array afterwards
+## must leave the Tensor as it was loaded.
+%!test
+%! vals = {rand(1, 1000), rand(1000, 1), 7, int16(1:5), rand(4, 5, 6), ...
+%!         single(rand(1, 1, 300)), true(1, 9)};
+%! layouts = {'rowmajor', 'rowmajor', 'rowmajor', 'rowmajor', 'native', ...
+%!            'rowmajor', 'native'};
+%! for i = 1:numel (vals)
+%!   x = vals{i};
+%!   tensor = tensorflow ('TF_LoadTensor', x, layouts{i});
+%!   x(:) = 0;
+%!   vals{i}(1) = vals{i}(1);
+%!   clear x
+%!   assert_equal (tensorflow ('TF_SaveTensor', tensor, layouts{i}), vals{i});
+%!   tensorflow ('TF_DeleteTensor', tensor);
+%! endfor
+
+## A Tensor handed over to TF_SaveTensor is released by it, either at once or,
+## when the array is built over its buffer, once no value refers to the array.
+## Writing to such an array, or to a copy of it, must affect neither the other
+## nor an Octave array whose buffer the Tensor borrowed.
+%!test
+%! vals = {rand(1, 1000), rand(1000, 1), single(7), int16(1:5), rand(4, 5, 6), ...
+%!         true(1, 9), complex(rand(2, 3, 4), 1)};
+%! for i = 1:numel (vals)
+%!   for layout = {'rowmajor', 'native'}
+%!     x = vals{i};
+%!     ## Borrowing the buffer of x, and allocated by TensorFlow in row major
+%!     ## layout and read back natively, where the buffer belongs to the Tensor
+%!     for load = {layout{1}, 'rowmajor'}
+%!       tensor = tensorflow ('TF_LoadTensor', x, load{1});
+%!       y = tensorflow ('TF_SaveTensor', tensor, layout{1}, true);
+%!       if (strcmp (load{1}, layout{1}) || isrow (x))
+%!         expected = x;
+%!       else
+%!         expected = permute (x, ndims (x):-1:1);
+%!       endif
+%!       assert_equal (y, expected);
+%!       z = y;
+%!       y(1) = 0;
+%!       assert_equal (z, expected);
+%!       clear z
+%!       y(end) = 1;
+%!       assert_equal (y(2:end-1), expected(2:end-1));
+%!       clear y
+%!       assert_equal (x, vals{i});
+%!     endfor
+%!   endfor
+%! endfor
+
 ## Inference on a matrix whose rows differ.  The model broadcasts its
 ## coefficients along the last axis, so unlike an element-wise operation it is
 ## not invariant under transposition, and it fails if the storage order of the
@@ -3578,6 +4944,163 @@ which is 0 if the index is out of bounds. \n\
 %! tensorflow ('TF_DeleteSessionOptions', opts);
 %! tensorflow ('TF_DeleteGraph', graph);
 %! tensorflow ('TF_DeleteStatus', status);
+%!error <tensorflow: one extra argument is required for the 'TF_GraphOperationTable' OCTAVE function.> ...
+%! tensorflow ('TF_GraphOperationTable');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Graph parsed to the 'TF_GraphOperationTable' OCTAVE function.> ...
+%! tensorflow ('TF_GraphOperationTable', 1);
+
+## The table of a Graph holds a row for each operation TF_GraphOperations
+## reports, in the same order, and the same fields their own functions give.
+%!test
+%! TF_FLOAT = uint32 (1);
+%! status = tensorflow ('TF_NewStatus');
+%! graph = tensorflow ('TF_NewGraph');
+%! t = tensorflow ('TF_GraphOperationTable', graph);
+%! assert_equal (size (t.Name), [0, 1]);
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! desc = tensorflow ('TF_NewOperation', graph, 'AddV2', 'z');
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! op_z = tensorflow ('TF_FinishOperation', desc, status);
+%! t = tensorflow ('TF_GraphOperationTable', graph);
+%! assert_equal (fieldnames (t), {"Pointer"; "Name"; "OpType"; "Device"; ...
+%!               "NumInputs"; "NumOutputs"; "OutputTypes"});
+%! assert_equal (t.Pointer, tensorflow ('TF_GraphOperations', graph).');
+%! assert_equal (t.Name, {'x'; 'z'});
+%! assert_equal (t.OpType, {'Placeholder'; 'AddV2'});
+%! assert_equal (t.Device, {''; ''});
+%! assert_equal (t.NumInputs, int32 ([0; 2]));
+%! assert_equal (t.NumOutputs, int32 ([1; 1]));
+%! assert_equal (t.OutputTypes, {TF_FLOAT; TF_FLOAT});
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+%!error <tensorflow: one extra argument is required for the 'TF_GraphAdjacency' OCTAVE function.> ...
+%! tensorflow ('TF_GraphAdjacency');
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Graph parsed to the 'TF_GraphAdjacency' OCTAVE function.> ...
+%! tensorflow ('TF_GraphAdjacency', 1);
+%!error <tensorflow: 3rd argument must be a logical scalar requesting the sparse matrix parsed to the 'TF_GraphAdjacency' OCTAVE function.> ...
+%! tensorflow ('TF_GraphAdjacency', uint64 (1), 1);
+
+## Both inputs of z = x + x are data edges from the single output of x, the
+## control input of w is a control edge, and the sparse matrix counts both.
+%!test
+%! TF_FLOAT = uint32 (1);
+%! status = tensorflow ('TF_NewStatus');
+%! graph = tensorflow ('TF_NewGraph');
+%! a = tensorflow ('TF_GraphAdjacency', graph, true);
+%! assert_equal (size (a.Data), [0, 4]);
+%! assert_equal (size (a.Control), [0, 2]);
+%! assert_equal (size (a.Adjacency), [0, 0]);
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! desc = tensorflow ('TF_NewOperation', graph, 'AddV2', 'z');
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! op_z = tensorflow ('TF_FinishOperation', desc, status);
+%! desc = tensorflow ('TF_NewOperation', graph, 'NoOp', 'w');
+%! tensorflow ('TF_AddControlInput', desc, op_z);
+%! op_w = tensorflow ('TF_FinishOperation', desc, status);
+%! a = tensorflow ('TF_GraphAdjacency', graph);
+%! assert_equal (fieldnames (a), {"Pointer"; "Data"; "Control"});
+%! assert_equal (a.Pointer, [op_x; op_z; op_w]);
+%! assert_equal (a.Data, [1, 0, 2, 0; 1, 0, 2, 1]);
+%! assert_equal (a.Control, [2, 3]);
+%! a = tensorflow ('TF_GraphAdjacency', graph, true);
+%! assert (issparse (a.Adjacency));
+%! assert_equal (full (a.Adjacency), [0, 2, 0; 0, 0, 1; 0, 0, 0]);
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+%!error <tensorflow: two extra arguments are required for the 'TF_GraphPrune' OCTAVE function.> ...
+%! tensorflow ('TF_GraphPrune');
+%!error <tensorflow: two extra arguments are required for the 'TF_GraphPrune' OCTAVE function.> ...
+%! tensorflow ('TF_GraphPrune', 1);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Graph parsed to the 'TF_GraphPrune' OCTAVE function.> ...
+%! tensorflow ('TF_GraphPrune', 1, 'x');
+%!error <tensorflow: 3rd argument must be a character vector or a cellstr array of fetched operation names parsed to the 'TF_GraphPrune' OCTAVE function.> ...
+%! tensorflow ('TF_GraphPrune', uint64 (1), 2);
+%!error <tensorflow: 4th argument must be a cellstr array of fed operation names parsed to the 'TF_GraphPrune' OCTAVE function.> ...
+%! tensorflow ('TF_GraphPrune', uint64 (1), 'x', 'y');
+
+## Of x, y = x + x, an unused u = x + x and w, a NoOp after y, fetching y
+## keeps x and y alone, and fetching w with y fed replaces y with a
+## Placeholder of the type of its output, dropping x.
+%!test
+%! TF_FLOAT = uint32 (1);
+%! status = tensorflow ('TF_NewStatus');
+%! graph = tensorflow ('TF_NewGraph');
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! for name = {'y', 'u'}
+%!   desc = tensorflow ('TF_NewOperation', graph, 'AddV2', name{1});
+%!   tensorflow ('TF_AddInput', desc, out_x);
+%!   tensorflow ('TF_AddInput', desc, out_x);
+%!   op = tensorflow ('TF_FinishOperation', desc, status);
+%! endfor
+%! desc = tensorflow ('TF_NewOperation', graph, 'NoOp', 'w');
+%! tensorflow ('TF_AddControlInput', desc, ...
+%!             tensorflow ('TF_GraphOperationByName', graph, 'y'));
+%! tensorflow ('TF_FinishOperation', desc, status);
+%! pruned = tensorflow ('TF_GraphPrune', graph, 'y:0');
+%! t = tensorflow ('TF_GraphOperationTable', pruned);
+%! assert_equal (sort (t.Name), {'x'; 'y'});
+%! tensorflow ('TF_DeleteGraph', pruned);
+%! pruned = tensorflow ('TF_GraphPrune', graph, {'w'}, {'y'});
+%! t = tensorflow ('TF_GraphOperationTable', pruned);
+%! assert_equal (sort (t.Name), {'w'; 'y'});
+%! assert_equal (t.OpType(strcmp (t.Name, 'y')), {'Placeholder'});
+%! assert_equal (t.OutputTypes(strcmp (t.Name, 'y')), {TF_FLOAT});
+%! tensorflow ('TF_DeleteGraph', pruned);
+%! fail ("tensorflow ('TF_GraphPrune', graph, 'nope')", ...
+%!       "the Graph holds no operation named 'nope'");
+%! fail ("tensorflow ('TF_GraphPrune', graph, 'y', {'nope:0'})", ...
+%!       "the Graph holds no operation named 'nope'");
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
+%!error <tensorflow: two extra arguments are required for the 'TF_GraphOperationsByName' OCTAVE function.> ...
+%! tensorflow ('TF_GraphOperationsByName');
+%!error <tensorflow: two extra arguments are required for the 'TF_GraphOperationsByName' OCTAVE function.> ...
+%! tensorflow ('TF_GraphOperationsByName', 1);
+%!error <tensorflow: 2nd argument must be an uint64 scalar pointer to the Graph parsed to the 'TF_GraphOperationsByName' OCTAVE function.> ...
+%! tensorflow ('TF_GraphOperationsByName', 1, 'x');
+%!error <tensorflow: 3rd argument must be a character vector or a cellstr array of operation names parsed to the 'TF_GraphOperationsByName' OCTAVE function.> ...
+%! tensorflow ('TF_GraphOperationsByName', uint64 (1), 2);
+
+## Names are resolved to the same pointers TF_GraphOperationByName returns,
+## in an array shaped as the names, and an operation added after a lookup is
+## found by the next one.
+%!test
+%! TF_FLOAT = uint32 (1);
+%! status = tensorflow ('TF_NewStatus');
+%! graph = tensorflow ('TF_NewGraph');
+%! desc = tensorflow ('TF_NewOperation', graph, 'Placeholder', 'x');
+%! tensorflow ('TF_SetAttrType', desc, 'dtype', TF_FLOAT);
+%! op_x = tensorflow ('TF_FinishOperation', desc, status);
+%! out_x = tensorflow ('TF_NewOutput', op_x, int32 (0));
+%! assert_equal (tensorflow ('TF_GraphOperationsByName', graph, 'x'), op_x);
+%! ops = tensorflow ('TF_GraphOperationsByName', graph, {'x', 'z'; 'z', 'x'});
+%! assert_equal (ops, [op_x, uint64(0); uint64(0), op_x]);
+%! desc = tensorflow ('TF_NewOperation', graph, 'AddV2', 'z');
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! tensorflow ('TF_AddInput', desc, out_x);
+%! op_z = tensorflow ('TF_FinishOperation', desc, status);
+%! ops = tensorflow ('TF_GraphOperationsByName', graph, {'x', 'z'; 'z', 'x'});
+%! assert_equal (ops, [op_x, op_z; op_z, op_x]);
+%! assert_equal (ops(1,2), tensorflow ('TF_GraphOperationByName', graph, 'z'));
+%! assert_equal (tensorflow ('TF_GraphOperationsByName', graph, {}), ...
+%!               zeros (0, 0, 'uint64'));
+%! tensorflow ('TF_DeleteOutput', out_x);
+%! tensorflow ('TF_DeleteGraph', graph);
+%! tensorflow ('TF_DeleteStatus', status);
 %!demo
 %! ## The `tensorflow` function is the intermediate `OCT` interface, which
 %! ## passes calls to TensorFlow's C API.  Everything it hands back that is not
@@ -3596,4 +5119,45 @@ which is 0 if the index is out of bounds. \n\
 %! tensorflow ('TF_NumDims', t)
 %! tensorflow ('TF_SaveTensor', t)
 %! tensorflow ('TF_DeleteTensor', t);
+
+%!demo
+%! ## Functions are looked up by name in a hash table, or directly by the
+%! ## opcode `TF_Opcode` returns for the name.  Time the whole call through
+%! ## either, on a function that does next to nothing.
+%!
+%! n = 1e5;
+%! status = tensorflow ('TF_NewStatus');
+%! op = tensorflow ('TF_Opcode', 'TF_GetCode');
+%! tic;
+%! for i = 1:n
+%!   tensorflow ('TF_GetCode', status);
+%! endfor
+%! tname = toc;
+%! tic;
+%! for i = 1:n
+%!   tensorflow (op, status);
+%! endfor
+%! tcode = toc;
+%! tensorflow ('TF_DeleteStatus', status);
+%! printf ("by name   %5.2f us per call\nby opcode %5.2f us per call\n", ...
+%!         1e6 * tname / n, 1e6 * tcode / n);
+
+%!demo
+%! ## Repositioning the elements between the two storage orders is the main
+%! ## cost of loading and saving a Tensor.  Time it for arrays of 2, 3 and 4
+%! ## dimensions, the last one shaped like a batch of images.
+%!
+%! shapes = {[4096, 4096], [256, 256, 256], [32, 224, 224, 3]};
+%! for i = 1:numel (shapes)
+%!   x = rand (shapes{i}, "single");
+%!   tic;
+%!   t = tensorflow ('TF_LoadTensor', x);
+%!   tload = toc;
+%!   tic;
+%!   y = tensorflow ('TF_SaveTensor', t);
+%!   tsave = toc;
+%!   tensorflow ('TF_DeleteTensor', t);
+%!   printf ("%-16s load %7.1f ms  save %7.1f ms\n", ...
+%!           mat2str (shapes{i}), 1e3 * tload, 1e3 * tsave);
+%! endfor
 */
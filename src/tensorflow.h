@@ -20,6 +20,7 @@ this program; if not, see <http://www.gnu.org/licenses/>.
 #ifndef TENSORFLOW_H
 #define TENSORFLOW_H
 
+#include <atomic>
 #include <stdio.h>
 #include <stdlib.h>
 #include <cstring>
@@ -68,8 +69,12 @@ octave_value OCT_TF_GraphGetTensorShape (OCT_ARGS);
 octave_value OCT_TF_NewOperationLocked (OCT_ARGS);
 octave_value OCT_TF_NewOperation (OCT_ARGS);
 octave_value OCT_TF_GraphOperationByName (OCT_ARGS);
+octave_value OCT_TF_GraphOperationsByName (OCT_ARGS); // OCTAVE specific
 octave_value OCT_TF_GraphNextOperation (OCT_ARGS);
 octave_value OCT_TF_GraphOperations (OCT_ARGS);   // OCTAVE specific
+octave_value OCT_TF_GraphOperationTable (OCT_ARGS); // OCTAVE specific
+octave_value OCT_TF_GraphAdjacency (OCT_ARGS);      // OCTAVE specific
+octave_value OCT_TF_GraphPrune (OCT_ARGS);          // OCTAVE specific
 void OCT_TF_GraphToGraphDef (OCT_ARGS);
 void OCT_TF_GraphGetOpDef (OCT_ARGS);
 void OCT_TF_GraphVersions (OCT_ARGS);
@@ -148,10 +153,47 @@ octave_value OCT_TF_OperationOutputConsumers (OCT_ARGS);
 // -----------------------------------------------------------------------------
 octave_value OCT_TF_NewSession (OCT_ARGS);
 octave_value OCT_TF_LoadSessionFromSavedModel (OCT_ARGS);
+octave_value OCT_TF_SignatureDefs (OCT_ARGS);      // OCTAVE specific
 void OCT_TF_CloseSession (OCT_ARGS);
 void OCT_TF_DeleteSession (OCT_ARGS);
 octave_value OCT_TF_SessionRun (OCT_ARGS);
+octave_value OCT_TF_SessionPRunSetup (OCT_ARGS);
+octave_value OCT_TF_SessionPRun (OCT_ARGS);
+void OCT_TF_DeletePRunHandle (OCT_ARGS);
+octave_value OCT_TF_SessionRunValues (OCT_ARGS);   // OCTAVE specific
+octave_value OCT_TF_SessionProfile (OCT_ARGS);     // OCTAVE specific
 octave_value OCT_TF_SessionListDevices (OCT_ARGS);
+octave_value OCT_TF_SessionPoolStats (OCT_ARGS);   // OCTAVE specific
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TF_Runner classdef
+// -----------------------------------------------------------------------------
+octave_value OCT_TF_NewRunner (OCT_ARGS);          // OCTAVE specific
+void OCT_TF_DeleteRunner (OCT_ARGS);               // OCTAVE specific
+octave_value OCT_TF_RunnerRun (OCT_ARGS);          // OCTAVE specific
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TF_AsyncRun classdef
+// -----------------------------------------------------------------------------
+octave_value OCT_TF_SessionRunAsync (OCT_ARGS);    // OCTAVE specific
+octave_value OCT_TF_AsyncRunIsDone (OCT_ARGS);     // OCTAVE specific
+octave_value OCT_TF_AsyncRunWait (OCT_ARGS);       // OCTAVE specific
+octave_value OCT_TF_AsyncRunFetch (OCT_ARGS);      // OCTAVE specific
+void OCT_TF_DeleteAsyncRun (OCT_ARGS);             // OCTAVE specific
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TFModel classdef
+// -----------------------------------------------------------------------------
+octave_value OCT_TF_NewBatcher (OCT_ARGS);         // OCTAVE specific
+octave_value OCT_TF_BatcherSubmit (OCT_ARGS);      // OCTAVE specific
+octave_value OCT_TF_BatcherCollect (OCT_ARGS);     // OCTAVE specific
+octave_value OCT_TF_BatcherStats (OCT_ARGS);       // OCTAVE specific
+void OCT_TF_DeleteBatcher (OCT_ARGS);              // OCTAVE specific
+// -----------------------------------------------------------------------------
+// OCTAVE specific functions referenced by the TFModelPool classdef
+// -----------------------------------------------------------------------------
+octave_value OCT_TF_NewModelPool (OCT_ARGS);       // OCTAVE specific
+octave_value OCT_TF_ModelPoolSubmit (OCT_ARGS);    // OCTAVE specific
+octave_value OCT_TF_ModelPoolCollect (OCT_ARGS);   // OCTAVE specific
+octave_value OCT_TF_ModelPoolStats (OCT_ARGS);     // OCTAVE specific
+void OCT_TF_DeleteModelPool (OCT_ARGS);            // OCTAVE specific
 // -----------------------------------------------------------------------------
 // C API functions referenced by the TF_SessionOptions classdef
 // -----------------------------------------------------------------------------
@@ -159,6 +201,7 @@ octave_value OCT_TF_NewSessionOptions (void);
 void OCT_TF_SetTarget (OCT_ARGS);
 void OCT_TF_SetConfig (OCT_ARGS);
 void OCT_TF_DeleteSessionOptions (OCT_ARGS);
+octave_value OCT_TF_EncodeConfig (OCT_ARGS);       // OCTAVE specific
 // ---------------------------------------------------------------------------
 // C API functions referenced by the TF_Status classdef
 // ---------------------------------------------------------------------------
@@ -189,6 +232,7 @@ void OCT_TF_StringDealloc (OCT_ARGS);
 // ---------------------------------------------------------------------------
 octave_value OCT_TF_LoadTensor (OCT_ARGS);         // OCTAVE specific
 octave_value OCT_TF_SaveTensor (OCT_ARGS);         // OCTAVE specific
+octave_value OCT_TF_SetConversionThreads (OCT_ARGS); // OCTAVE specific
 octave_value OCT_TF_NewTensor (OCT_ARGS);
 octave_value OCT_TF_AllocateTensor (OCT_ARGS);
 octave_value OCT_TF_TensorMaybeMove (OCT_ARGS);
@@ -203,4 +247,171 @@ void OCT_TF_TensorFromProto (OCT_ARGS);
 octave_value OCT_TF_TensorElementCount (OCT_ARGS);
 void OCT_TF_TensorBitcastFrom (OCT_ARGS);
 octave_value OCT_TF_TensorIsAligned (OCT_ARGS);
+// ---------------------------------------------------------------------------
+// Conversion between Octave arrays and Tensors, shared by the functions above
+// ---------------------------------------------------------------------------
+TF_Tensor* load_tensor (const octave_value& data, bool native,
+                        TF_DataType dtype = (TF_DataType) 0);
+TF_Tensor* load_input (const octave_value& data, bool native,
+                       TF_DataType dtype);
+octave_value save_tensor (TF_Tensor* tensor, bool native, bool release,
+                          const double* dequant = nullptr);
+bool native_layout (const octave_value_list& args, int nrhs, int pos,
+                    const char* ordinal, const char* fname);
+string data_type_name (TF_DataType dtype);
+// ---------------------------------------------------------------------------
+// Pooling the buffers of the Tensors fed to a Session, shared by the functions
+// above
+// ---------------------------------------------------------------------------
+struct tensor_pool;
+// The pool of a Session, created on first use
+tensor_pool* session_pool (TF_Session* session);
+// Called before a Session is deleted, releasing its pool
+void delete_session_pool (TF_Session* session);
+// The hits and misses of the pool of a Session and the bytes it holds
+octave_scalar_map session_pool_stats (TF_Session* session);
+// While it lives, the Tensors load_tensor copies an array into on the calling
+// thread take their buffer from 'pool'
+struct pool_scope
+{
+  tensor_pool* prev;
+  pool_scope (tensor_pool* pool);
+  ~pool_scope ();
+};
+// ---------------------------------------------------------------------------
+// Indexing the operations of a Graph, shared by the functions above
+// ---------------------------------------------------------------------------
+// Called by every function adding operations to a Graph, which invalidates
+// the name index of every Graph
+void graph_changed (void);
+// ---------------------------------------------------------------------------
+// Tracing the package, shared by the functions above
+// ---------------------------------------------------------------------------
+// True between TF_TraceStart and TF_TraceStop.  Nothing is recorded, and the
+// clock is not read, while it is false.
+extern atomic<bool> trace_on;
+// Microseconds since the epoch, the clock TensorFlow times its StepStats with
+double trace_clock (void);
+// Record a span of the package on the calling thread, which may be any
+void trace_host (const char* name, const char* cat, double start, double end);
+// Record the execution of a node of a Graph, as decoded from StepStats
+void trace_kernel (const string& name, const string& op, const string& device,
+                   double start, double wall);
+// Record the span of the enclosing scope under 'name', which must be a string
+// literal or otherwise outlive the trace
+struct trace_scope
+{
+  const char* name;
+  const char* cat;
+  double start;
+  trace_scope (const char* n, const char* c)
+    : name (n), cat (c),
+      start (trace_on.load (memory_order_relaxed) ? trace_clock () : -1) {}
+  ~trace_scope ()
+  {
+    if (start >= 0) {trace_host (name, cat, start, trace_clock ());}
+  }
+};
+// ---------------------------------------------------------------------------
+// Reading and writing serialized protocol buffers, shared by the functions
+// above
+// ---------------------------------------------------------------------------
+// Walk the fields of a serialized message in the order they are stored.  Each
+// call to next () reads one field, setting its number and wire type, and
+// either its value, for a varint or a fixed width field, or the bytes it
+// holds, for a length delimited one, which may be read as a string or as a
+// nested message.  It returns false at the end of the message, or on a
+// malformed one, which sets 'malformed'.  The buffer must outlive the reader.
+struct pb_reader
+{
+  const uint8_t* pos;
+  const uint8_t* end;
+  int field = 0;
+  int wire = 0;
+  uint64_t value = 0;
+  const uint8_t* data = nullptr;
+  size_t len = 0;
+  bool malformed = false;
+  pb_reader (const void* buf, size_t n)
+    : pos ((const uint8_t*) buf), end ((const uint8_t*) buf + n) {}
+  bool varint (uint64_t& v)
+  {
+    v = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7)
+    {
+      uint8_t b = *pos++;
+      v |= (uint64_t) (b & 0x7f) << shift;
+      if (! (b & 0x80)) {return true;}
+    }
+    return false;
+  }
+  bool next ()
+  {
+    if (pos >= end) {return false;}
+    uint64_t tag;
+    if (! varint (tag)) {return fail ();}
+    field = (int) (tag >> 3);
+    wire = (int) (tag & 7);
+    data = nullptr;
+    len = 0;
+    switch (wire)
+    {
+      case 0:
+        return varint (value) || fail ();
+      case 1:
+      case 5:
+        len = wire == 1 ? 8 : 4;
+        if ((size_t) (end - pos) < len) {return fail ();}
+        value = 0;
+        memcpy (&value, pos, len);
+        pos += len;
+        return true;
+      case 2:
+        if (! varint (value) || value > (uint64_t) (end - pos))
+        {
+          return fail ();
+        }
+        data = pos;
+        len = (size_t) value;
+        pos += len;
+        return true;
+      default:
+        return fail ();
+    }
+  }
+  bool fail ()
+  {
+    malformed = true;
+    pos = end;
+    return false;
+  }
+  string str () const {return string ((const char*) data, len);}
+  pb_reader message () const {return pb_reader (data, len);}
+};
+
+// Append 'value' to 'buf' as a protobuf varint.  A negative value of an int32
+// or enum field is sign extended to ten bytes, as protobuf encodes it.
+inline void put_varint (string& buf, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    buf += (char) ((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  buf += (char) value;
+}
+
+// Append field 'field' of 'value' to 'buf', as a varint or as a length
+// delimited string of bytes
+inline void put_field (string& buf, int field, int64_t value)
+{
+  put_varint (buf, (uint64_t) (field << 3));
+  put_varint (buf, (uint64_t) value);
+}
+inline void put_field (string& buf, int field, const string& value)
+{
+  put_varint (buf, (uint64_t) ((field << 3) | 2));
+  put_varint (buf, value.size ());
+  buf += value;
+}
 #endif // TENSORFLOW_H